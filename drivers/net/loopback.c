@@ -85,6 +85,78 @@ int loopback_get_num_dropped_packets(void)
 
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DELAY
+struct loopback_delayed_pkt {
+	void *fifo_reserved;
+	struct net_pkt *pkt;
+	int64_t due;
+};
+
+static void loopback_delay_handler(struct k_work *work);
+
+K_MEM_SLAB_DEFINE_STATIC(loopback_delay_slab, sizeof(struct loopback_delayed_pkt),
+			 CONFIG_NET_PKT_RX_COUNT, sizeof(void *));
+static K_FIFO_DEFINE(loopback_delay_fifo);
+static K_WORK_DELAYABLE_DEFINE(loopback_delay_work, loopback_delay_handler);
+static uint32_t loopback_packet_delay_ms;
+
+int loopback_set_packet_delay(uint32_t delay_ms)
+{
+	loopback_packet_delay_ms = delay_ms;
+	return 0;
+}
+
+static void loopback_delay_handler(struct k_work *work)
+{
+	struct loopback_delayed_pkt *entry;
+	int64_t now = k_uptime_get();
+
+	ARG_UNUSED(work);
+
+	/* All packets are delayed by the same amount, so the fifo is sorted
+	 * by the time the packets are due.
+	 */
+	while ((entry = k_fifo_peek_head(&loopback_delay_fifo)) != NULL) {
+		if (entry->due > now) {
+			k_work_reschedule(&loopback_delay_work,
+					  K_MSEC(entry->due - now));
+			return;
+		}
+
+		(void)k_fifo_get(&loopback_delay_fifo, K_NO_WAIT);
+
+		if (net_recv_data(net_pkt_iface(entry->pkt), entry->pkt) < 0) {
+			LOG_ERR("Data receive failed.");
+			net_pkt_unref(entry->pkt);
+		}
+
+		k_mem_slab_free(&loopback_delay_slab, (void *)entry);
+	}
+}
+
+static int loopback_delay(struct net_pkt *pkt)
+{
+	struct loopback_delayed_pkt *entry;
+
+	if (k_mem_slab_alloc(&loopback_delay_slab, (void **)&entry,
+			     K_NO_WAIT) < 0) {
+		/* Like a link with a full queue, lose the packet */
+		net_pkt_unref(pkt);
+		return 0;
+	}
+
+	entry->pkt = pkt;
+	entry->due = k_uptime_get() + loopback_packet_delay_ms;
+
+	k_fifo_put(&loopback_delay_fifo, entry);
+
+	/* Does nothing if an earlier packet is already scheduled */
+	k_work_schedule(&loopback_delay_work, K_MSEC(loopback_packet_delay_ms));
+
+	return 0;
+}
+#endif
+
 static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct net_pkt *cloned;
@@ -141,6 +213,13 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 		goto out;
 	}
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DELAY
+	if (loopback_packet_delay_ms > 0) {
+		res = loopback_delay(cloned);
+		goto out;
+	}
+#endif
+
 	res = net_recv_data(net_pkt_iface(cloned), cloned);
 	if (res < 0) {
 		LOG_ERR("Data receive failed.");
@@ -879,6 +879,45 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
  *
  */
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/**
+ * @brief Reserve a budget of execution time per period for a thread
+ *
+ * This turns a thread into a constant bandwidth server: the scheduler
+ * manages its deadline, which is at most @p period_us ahead, and charges
+ * the time it runs against a budget of @p runtime_us per period.  When
+ * the budget is used up the thread is throttled, i.e. not scheduled until
+ * its deadline, where the budget is replenished and the deadline moves a
+ * period ahead.  A thread waking up after having blocked for a while
+ * starts a new period.  The deadline only orders threads of the same
+ * static priority, as with k_thread_deadline_set().
+ *
+ * A reservation is only made if the sum of runtime/period over all
+ * threads stays within @kconfig{CONFIG_SCHED_DEADLINE_CBS_UTILIZATION}
+ * percent of the CPUs.  Passing 0 for both values drops the reservation.
+ * The reservation of an aborted thread is dropped automatically.
+ *
+ * Budgets are enforced with the resolution of the system tick and a
+ * thread running with interrupts locked can overrun its budget, in which
+ * case the overrun is taken from its next period.  The budget of a
+ * thread running on another CPU is only enforced from the next time that
+ * thread is switched in.
+ *
+ * @note You should enable @kconfig{CONFIG_SCHED_DEADLINE_CBS} in your
+ * project configuration.
+ *
+ * @param thread Thread to set the reservation of
+ * @param runtime_us Budget per period, in microseconds
+ * @param period_us Period, in microseconds
+ *
+ * @retval 0 Reservation set
+ * @retval -EINVAL Invalid budget or period, or the idle thread
+ * @retval -EBUSY Admission test failed, not enough bandwidth left
+ */
+__syscall int k_thread_cbs_set(k_tid_t thread, uint32_t runtime_us,
+			       uint32_t period_us);
+#endif
 #endif
 
 #ifdef CONFIG_SCHED_CPU_MASK
@@ -1711,6 +1750,36 @@ static inline void *z_impl_k_timer_user_data_get(const struct k_timer *timer)
 	return timer->user_data;
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Set the expiry slack of a timer.
+ *
+ * This routine allows the kernel to expire @a timer up to @a slack later
+ * than requested, so that its expiry can be coalesced with the expiry of
+ * other timeouts and fewer timer interrupts are taken.  The expiry is
+ * deferred to a tick aligned on a power of two fitting in the slack, so
+ * timers with similar slack started around the same time expire together.
+ *
+ * The slack applies from the next time the timer is started.  The period
+ * of a periodic timer is kept from its requested expiries, so the slack
+ * does not accumulate.
+ *
+ * @note You should enable @kconfig{CONFIG_TIMEOUT_SLACK} in your project
+ * configuration.
+ *
+ * @param timer     Address of timer.
+ * @param slack     Maximum deferral of the expiry, K_NO_WAIT for none.
+ */
+__syscall void k_timer_slack_set(struct k_timer *timer, k_timeout_t slack);
+
+static inline void z_impl_k_timer_slack_set(struct k_timer *timer,
+					    k_timeout_t slack)
+{
+	__ASSERT(slack.ticks >= 0, "invalid slack");
+	timer->timeout.slack = (uint32_t)slack.ticks;
+}
+#endif
+
 /** @} */
 
 /**
@@ -2880,6 +2949,7 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 
 struct k_work;
 struct k_work_q;
+struct k_work_q_worker;
 struct k_work_queue_config;
 extern struct k_work_q k_sys_work_q;
 
@@ -2897,6 +2967,26 @@ extern struct k_work_q k_sys_work_q;
  * Mutex Structure
  * @ingroup mutex_apis
  */
+/** Mutex contention statistics, times are in k_cycle_get_32() units */
+struct k_mutex_stats {
+	/** Number of times the mutex was taken, not counting nested locks */
+	uint32_t locks;
+	/** Number of locks that had to wait for the owner */
+	uint32_t contended;
+	/** Number of waits that timed out */
+	uint32_t timeouts;
+	/** Longest wait */
+	uint32_t wait_max;
+	/** Total time spent waiting */
+	uint64_t wait_total;
+	/** Longest time the mutex was held */
+	uint32_t hold_max;
+	/** Total time the mutex was held */
+	uint64_t hold_total;
+	/** Owner found by the last contended lock */
+	struct k_thread *contended_owner;
+};
+
 struct k_mutex {
 	/** Mutex wait queue */
 	_wait_q_t wait_q;
@@ -2906,11 +2996,23 @@ struct k_mutex {
 	/** Current lock count */
 	uint32_t lock_count;
 
+#ifdef CONFIG_SYNC_FAST_PATH
+	/** Original thread priority, Z_MUTEX_ORIG_PRIO_UNSET while unowned */
+	atomic_t owner_orig_prio;
+#else
 	/** Original thread priority */
 	int owner_orig_prio;
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mutex)
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	/** Contention statistics */
+	struct k_mutex_stats stats;
+	/** Time the current owner took the mutex */
+	uint32_t hold_start;
+#endif
+
 #ifdef CONFIG_OBJ_CORE_MUTEX
 	struct k_obj_core obj_core;
 #endif
@@ -2919,12 +3021,19 @@ struct k_mutex {
 /**
  * @cond INTERNAL_HIDDEN
  */
+#ifdef CONFIG_SYNC_FAST_PATH
+#define Z_MUTEX_ORIG_PRIO_UNSET INT_MIN
+#define Z_MUTEX_ORIG_PRIO_INIT Z_MUTEX_ORIG_PRIO_UNSET
+#else
+#define Z_MUTEX_ORIG_PRIO_INIT K_LOWEST_APPLICATION_THREAD_PRIO
+#endif
+
 #define Z_MUTEX_INITIALIZER(obj) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
 	.owner = NULL, \
 	.lock_count = 0, \
-	.owner_orig_prio = K_LOWEST_APPLICATION_THREAD_PRIO, \
+	.owner_orig_prio = Z_MUTEX_ORIG_PRIO_INIT, \
 	}
 
 /**
@@ -3096,7 +3205,11 @@ __syscall int k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
 
 struct k_sem {
 	_wait_q_t wait_q;
+#ifdef CONFIG_SYNC_FAST_PATH
+	atomic_t count;
+#else
 	unsigned int count;
+#endif
 	unsigned int limit;
 
 	Z_DECL_POLL_EVENT
@@ -3213,7 +3326,11 @@ __syscall unsigned int k_sem_count_get(struct k_sem *sem);
  */
 static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 {
+#ifdef CONFIG_SYNC_FAST_PATH
+	return (unsigned int)atomic_get(&sem->count);
+#else
 	return sem->count;
+#endif
 }
 
 /**
@@ -3236,6 +3353,142 @@ static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 
 /** @} */
 
+#ifdef CONFIG_THREAD_POOL
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+/* A thread of a thread pool and the entry point it runs next */
+struct z_thread_pool_slot {
+	struct k_thread thread;
+	/* Given to an idle thread to run the next entry point */
+	struct k_sem start;
+	k_thread_entry_t entry;
+	void *p1;
+	void *p2;
+	void *p3;
+	/* Handed out, its thread is running an entry point */
+	bool busy;
+	/* The thread is waiting for the next entry point */
+	bool created;
+	/* A thread was created, it has to be joined before the next one */
+	bool started;
+};
+
+struct k_thread_pool {
+	struct k_spinlock lock;
+	/* Counts the slots that are not busy */
+	struct k_sem free;
+	struct z_thread_pool_slot *slots;
+	k_thread_stack_t *stacks;
+	size_t stack_size;
+	size_t stack_len;
+	uint32_t options;
+	uint16_t count;
+};
+
+#define Z_THREAD_POOL_INITIALIZER(obj, pool_slots, pool_stacks,      \
+				  pool_size, pool_stack_size,        \
+				  pool_options)                      \
+	{                                                            \
+	.free = Z_SEM_INITIALIZER(obj.free, pool_size, pool_size),   \
+	.slots = pool_slots,                                         \
+	.stacks = (k_thread_stack_t *)pool_stacks,                   \
+	.stack_size = pool_stack_size,                               \
+	.stack_len = K_THREAD_STACK_LEN(pool_stack_size),            \
+	.options = pool_options,                                     \
+	.count = pool_size,                                          \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup thread_pool_apis Thread Pool APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a thread pool.
+ *
+ * The pool holds @a pool_size threads, each with a stack of
+ * @a pool_stack_size bytes, which run the entry points passed to
+ * k_thread_pool_spawn().
+ *
+ * The thread pool can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct k_thread_pool <name>; @endcode
+ *
+ * @param name Name of the thread pool.
+ * @param pool_size Maximum number of entry points running at the same time.
+ * @param pool_stack_size Stack size of each thread, in bytes.
+ * @param pool_options Thread options of the threads, K_USER excepted.
+ */
+#define K_THREAD_POOL_DEFINE(name, pool_size, pool_stack_size,          \
+			     pool_options)                               \
+	BUILD_ASSERT(((pool_size) > 0) && ((pool_size) <= UINT16_MAX));  \
+	BUILD_ASSERT(((pool_options) & K_USER) == 0);                    \
+	static K_THREAD_STACK_ARRAY_DEFINE(_k_thread_pool_stacks_##name, \
+					   pool_size, pool_stack_size);  \
+	static struct z_thread_pool_slot                                 \
+		_k_thread_pool_slots_##name[pool_size];                  \
+	struct k_thread_pool name =                                      \
+		Z_THREAD_POOL_INITIALIZER(name,                          \
+					  _k_thread_pool_slots_##name,   \
+					  _k_thread_pool_stacks_##name,  \
+					  pool_size, pool_stack_size,    \
+					  pool_options)
+
+/**
+ * @brief Run an entry point on a thread of a thread pool.
+ *
+ * This routine hands @a entry to an idle thread of @a pool, which runs it
+ * at priority @a prio and then goes back to waiting for the next entry
+ * point.  Threads are only created the first time they are needed, so
+ * this costs about as much as waking up a thread instead of creating and
+ * tearing one down.
+ *
+ * If @kconfig{CONFIG_INIT_STACKS} is enabled, the thread exits after
+ * running @a entry instead, and is created again by the next spawn on its
+ * slot, so that its stack is painted again and stack usage is reported
+ * per entry point.
+ *
+ * If all threads of the pool are busy, the routine waits for one to
+ * finish for up to @a timeout.
+ *
+ * Without @kconfig{CONFIG_INIT_STACKS} the threads of a pool do not exit
+ * between entry points, so they can not be joined with k_thread_join();
+ * @a entry has to signal its completion itself where needed.  Changes
+ * that @a entry makes to its own thread, such as its name or CPU mask,
+ * carry over to later entry points.  A pool thread that is aborted
+ * releases its slot, and the next spawn on the slot creates it again.
+ *
+ * @note This routine must not be called from an ISR.
+ *
+ * @param pool Address of the thread pool.
+ * @param entry Thread entry function.
+ * @param p1 1st entry point parameter.
+ * @param p2 2nd entry point parameter.
+ * @param p3 3rd entry point parameter.
+ * @param prio Thread priority.
+ * @param timeout Waiting period for a thread of the pool to become
+ *                available, or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return ID of the thread running @a entry, or NULL if no thread of the
+ *         pool became available in time.
+ */
+k_tid_t k_thread_pool_spawn(struct k_thread_pool *pool,
+			    k_thread_entry_t entry,
+			    void *p1, void *p2, void *p3,
+			    int prio, k_timeout_t timeout);
+
+/** @} */
+#endif /* CONFIG_THREAD_POOL */
+
 /**
  * @cond INTERNAL_HIDDEN
  */
@@ -3341,6 +3594,38 @@ int k_work_submit_to_queue(struct k_work_q *queue,
  */
 int k_work_submit(struct k_work *work);
 
+/** @brief Submit a set of work items to a queue.
+ *
+ * Equivalent to calling k_work_submit_to_queue() on each item in turn,
+ * except that the work lock is only taken once and the queue is only
+ * woken once, after all items have been queued.  This is cheaper when
+ * an interrupt or thread produces bursts of work.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue pointer to the work queue on which the items should run.  If
+ * NULL each item goes to the queue from its most recent submission.
+ * @param work array of pointers to the work items.
+ * @param count number of work items in @p work.
+ *
+ * @return the number of items that this call queued, i.e. for which
+ * k_work_submit_to_queue() would have returned a positive value.  Items that
+ * were already queued or that were rejected are not counted.
+ */
+int k_work_submit_batch_to_queue(struct k_work_q *queue,
+				 struct k_work *const *work, size_t count);
+
+/** @brief Submit a set of work items to the system queue.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param work array of pointers to the work items.
+ * @param count number of work items in @p work.
+ *
+ * @return as with k_work_submit_batch_to_queue().
+ */
+int k_work_submit_batch(struct k_work *const *work, size_t count);
+
 /** @brief Wait for last-submitted instance to complete.
  *
  * Resubmissions may occur while waiting, including chained submissions (from
@@ -3455,6 +3740,37 @@ void k_work_queue_start(struct k_work_q *queue,
 			k_thread_stack_t *stack, size_t stack_size,
 			int prio, const struct k_work_queue_config *cfg);
 
+#if defined(CONFIG_WORKQUEUE_WORKERS) || defined(__DOXYGEN__)
+/** @brief Add a worker thread to a work queue.
+ *
+ * The new thread serves the queue alongside the thread started by
+ * k_work_queue_start(), at the same priority, so that several work items
+ * of the queue can run at the same time on SMP systems.  Each worker
+ * keeps the items submitted from its own handlers on a local list and
+ * runs those first, and idle workers steal items from the other workers'
+ * lists.  A work item still never runs on two workers at once, and flush,
+ * cancel and drain keep their single thread semantics.
+ *
+ * Workers can't be removed again.
+ *
+ * @param queue pointer to a started work queue.
+ * @param worker pointer to the worker structure.
+ * @param stack pointer to the worker thread stack area.
+ * @param stack_size size of the worker thread stack area, in bytes.
+ * @param cpu CPU to pin the worker thread to, or -1 to let it run on any.
+ *
+ * @retval 0 if the worker was added
+ * @retval -ENODEV if @p queue has not been started.
+ * @retval -ENOTSUP if @p cpu is not -1 and CONFIG_SCHED_CPU_MASK is not
+ * enabled.
+ * @retval -EINVAL if @p cpu is not a valid CPU.
+ */
+int k_work_queue_add_worker(struct k_work_q *queue,
+			    struct k_work_q_worker *worker,
+			    k_thread_stack_t *stack, size_t stack_size,
+			    int cpu);
+#endif
+
 /** @brief Access the thread that animates a work queue.
  *
  * This is necessary to grant a work queue thread access to things the work
@@ -3600,6 +3916,26 @@ static inline k_ticks_t k_work_delayable_expires_get(
 static inline k_ticks_t k_work_delayable_remaining_get(
 	const struct k_work_delayable *dwork);
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/** @brief Set the slack of a delayable work item.
+ *
+ * Allows the kernel to submit @p dwork up to @p slack later than its
+ * delay, so that the expiry of its timeout can be coalesced with other
+ * timeouts, see k_timer_slack_set().  The slack applies from the next time
+ * the work item is scheduled.
+ *
+ * @note You should enable @kconfig{CONFIG_TIMEOUT_SLACK} in your project
+ * configuration.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param dwork pointer to the delayable work item.
+ * @param slack maximum deferral of the submission, K_NO_WAIT for none.
+ */
+static inline void k_work_delayable_slack_set(struct k_work_delayable *dwork,
+					      k_timeout_t slack);
+#endif
+
 /** @brief Submit an idle work item to a queue after a delay.
  *
  * Unlike k_work_reschedule_for_queue() this is a no-op if the work item is
@@ -3748,6 +4084,22 @@ bool k_work_flush_delayable(struct k_work_delayable *dwork,
  */
 int k_work_cancel_delayable(struct k_work_delayable *dwork);
 
+/** @brief Cancel a set of delayable work items.
+ *
+ * Equivalent to calling k_work_cancel_delayable() on each item in turn,
+ * except that the work lock is only taken once.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param dwork array of pointers to the delayable work items.
+ * @param count number of work items in @p dwork.
+ *
+ * @return the number of items for which k_work_cancel_delayable() would have
+ * returned a non-zero value, i.e. that are still running or cancelling.
+ */
+int k_work_cancel_delayable_batch(struct k_work_delayable *const *dwork,
+				  size_t count);
+
 /** @brief Cancel delayable work and wait.
  *
  * Like k_work_cancel_delayable() but waits until the work becomes idle.
@@ -3927,6 +4279,13 @@ struct k_work_delayable {
  * processing) the item, and will be processed as soon as the item
  * completes.  When the flusher is processed the semaphore will be
  * signaled, releasing the thread waiting for the flush.
+ *
+ * With CONFIG_WORKQUEUE_WORKERS another worker could run the flusher
+ * while the item is still running, so the flusher is never run.  It
+ * follows a queued item in its pending list until a worker takes the
+ * item, which moves the flusher to its own list of flushes.  A flusher
+ * for a running item goes directly on the list of the worker running
+ * it.  The worker signals the semaphores when the item completes.
  */
 struct z_work_flusher {
 	struct k_work work;
@@ -3997,6 +4356,27 @@ struct k_work_queue_config {
 	bool no_yield;
 };
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+/* Per-thread state of a work queue, accessed only while the work
+ * module spinlock is held.
+ */
+struct z_work_worker {
+	/* Items submitted by this worker's handlers, and items
+	 * resubmitted while this worker runs them.
+	 */
+	sys_slist_t pending;
+
+	/* The item being run, or NULL. */
+	struct k_work *running;
+
+	/* Flushers waiting for the item being run to complete. */
+	sys_slist_t flushes;
+
+	struct k_thread *thread;
+	sys_snode_t node;
+};
+#endif
+
 /** @brief A structure used to hold work until it can be processed. */
 struct k_work_q {
 	/* The thread that animates the work. */
@@ -4017,8 +4397,30 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	/* All threads serving the queue, primary being the one above. */
+	sys_slist_t workers;
+	struct z_work_worker primary;
+
+	/* Number of workers running an item. */
+	uint32_t nbusy;
+#endif
 };
 
+#if defined(CONFIG_WORKQUEUE_WORKERS) || defined(__DOXYGEN__)
+/** @brief An additional thread serving a work queue.
+ *
+ * See k_work_queue_add_worker().
+ */
+struct k_work_q_worker {
+	/* The thread that animates the worker. */
+	struct k_thread thread;
+
+	struct z_work_worker worker;
+};
+#endif
+
 /* Provide the implementation for inline functions declared above */
 
 static inline bool k_work_is_pending(const struct k_work *work)
@@ -4050,6 +4452,15 @@ static inline k_ticks_t k_work_delayable_remaining_get(
 	return z_timeout_remaining(&dwork->timeout);
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+static inline void k_work_delayable_slack_set(struct k_work_delayable *dwork,
+					      k_timeout_t slack)
+{
+	__ASSERT(slack.ticks >= 0, "invalid slack");
+	dwork->timeout.slack = (uint32_t)slack.ticks;
+}
+#endif
+
 static inline k_tid_t k_work_queue_thread_get(struct k_work_q *queue)
 {
 	return &queue->thread;
@@ -4414,6 +4825,15 @@ struct k_msgq {
 
 	Z_DECL_POLL_EVENT
 
+#if defined(CONFIG_MSGQ_ZERO_COPY) || defined(__DOXYGEN__)
+	/** Wait queue of the zero-copy calls, and of k_msgq_put() and
+	 * k_msgq_get() while a slot is reserved or a message claimed
+	 */
+	_wait_q_t zc_wait_q;
+	/** Messages k_msgq_release() drops, if purged while claimed */
+	uint32_t purged_msgs;
+#endif
+
 	/** Message queue */
 	uint8_t flags;
 
@@ -4428,6 +4848,13 @@ struct k_msgq {
  */
 
 
+#ifdef CONFIG_MSGQ_ZERO_COPY
+#define Z_MSGQ_ZC_WAIT_Q_INIT(obj) \
+	.zc_wait_q = Z_WAIT_Q_INIT(&obj.zc_wait_q),
+#else
+#define Z_MSGQ_ZC_WAIT_Q_INIT(obj)
+#endif
+
 #define Z_MSGQ_INITIALIZER(obj, q_buffer, q_msg_size, q_max_msgs) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
@@ -4439,6 +4866,7 @@ struct k_msgq {
 	.write_ptr = q_buffer, \
 	.used_msgs = 0, \
 	Z_POLL_EVENT_OBJ_INIT(obj) \
+	Z_MSGQ_ZC_WAIT_Q_INIT(obj) \
 	}
 
 /**
@@ -4447,6 +4875,8 @@ struct k_msgq {
 
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
+#define K_MSGQ_FLAG_RESERVED	BIT(1)
+#define K_MSGQ_FLAG_CLAIMED	BIT(2)
 
 /**
  * @brief Message Queue Attributes
@@ -4557,6 +4987,8 @@ int k_msgq_cleanup(struct k_msgq *msgq);
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Returned without waiting while a slot is reserved with
+ *                k_msgq_reserve().
  */
 __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 
@@ -4579,6 +5011,8 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  * @retval 0 Message received.
  * @retval -ENOMSG Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Returned without waiting while a message is claimed with
+ *                k_msgq_claim().
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
@@ -4616,6 +5050,94 @@ __syscall int k_msgq_peek(struct k_msgq *msgq, void *data);
  */
 __syscall int k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx);
 
+#if defined(CONFIG_MSGQ_ZERO_COPY) || defined(__DOXYGEN__)
+/**
+ * @brief Reserve a slot of a message queue to write a message in place.
+ *
+ * This routine waits for a free slot in message queue @a msgq, like
+ * k_msgq_put(), and returns its address so the caller can build the next
+ * message directly in the queue's ring buffer. The message becomes
+ * available to readers only once k_msgq_commit() is called. Only one slot
+ * of a queue can be reserved at a time, and k_msgq_put() and other calls to
+ * this routine wait until it is committed.
+ *
+ * @note This routine is not available to user mode threads.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param slot Address of the pointer set to the reserved slot.
+ * @param timeout Waiting period for a free slot,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Slot reserved.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Returned without waiting while a slot is reserved.
+ */
+int k_msgq_reserve(struct k_msgq *msgq, void **slot, k_timeout_t timeout);
+
+/**
+ * @brief Send the message written in a reserved slot.
+ *
+ * This routine queues the message built in the slot returned by
+ * k_msgq_reserve(). If a thread is waiting in k_msgq_get(), the message is
+ * copied to it and the slot is released instead.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @retval 0 Message sent.
+ * @retval -EINVAL No slot is reserved.
+ */
+int k_msgq_commit(struct k_msgq *msgq);
+
+/**
+ * @brief Claim the first message of a message queue to read it in place.
+ *
+ * This routine waits for a message in message queue @a msgq, like
+ * k_msgq_get(), and returns its address in the queue's ring buffer. The
+ * message stays in the queue until k_msgq_release() is called. Only one
+ * message of a queue can be claimed at a time, and k_msgq_get() and other
+ * calls to this routine wait until it is released.
+ *
+ * @note This routine is not available to user mode threads.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param msg Address of the pointer set to the claimed message.
+ * @param timeout Waiting period for a message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Message claimed.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Returned without waiting while a message is claimed.
+ */
+int k_msgq_claim(struct k_msgq *msgq, void **msg, k_timeout_t timeout);
+
+/**
+ * @brief Remove a claimed message from a message queue.
+ *
+ * This routine frees the slot of the message returned by k_msgq_claim().
+ * If the queue was purged while the message was claimed, the messages that
+ * were queued then are discarded now. If a thread is waiting in
+ * k_msgq_put(), its message is added to the queue.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @retval 0 Message removed.
+ * @retval -EINVAL No message is claimed.
+ */
+int k_msgq_release(struct k_msgq *msgq);
+#endif /* CONFIG_MSGQ_ZERO_COPY */
+
 /**
  * @brief Purge a message queue.
  *
@@ -4623,6 +5145,9 @@ __syscall int k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx);
  * buffer. Any threads that are blocked waiting to send a message to the
  * message queue are unblocked and see an -ENOMSG error code.
  *
+ * If a message is claimed with k_msgq_claim(), it stays in place and the
+ * messages are discarded when it is released.
+ *
  * @param msgq Address of the message queue.
  */
 __syscall void k_msgq_purge(struct k_msgq *msgq);
@@ -4653,7 +5178,9 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
-	return msgq->max_msgs - msgq->used_msgs;
+	/* a reserved slot isn't free either */
+	return msgq->max_msgs - msgq->used_msgs -
+	       (((msgq->flags & K_MSGQ_FLAG_RESERVED) != 0U) ? 1U : 0U);
 }
 
 /**
@@ -4838,6 +5365,20 @@ void k_mbox_data_get(struct k_mbox_msg *rx_msg, void *buffer);
  * @{
  */
 
+/** Pipe transfer segment, for k_pipe_putv() and k_pipe_getv() */
+struct k_pipe_iovec {
+	void   *iov_base;	/**< Start of the segment */
+	size_t  iov_len;	/**< Size of the segment (in bytes) */
+};
+
+/** Pipe transfer statistics */
+struct k_pipe_stats {
+	/** Bytes copied straight from a writer to a reader */
+	size_t direct_bytes;
+	/** Bytes copied into the pipe buffer */
+	size_t buffered_bytes;
+};
+
 /** Pipe Structure */
 struct k_pipe {
 	unsigned char *buffer;          /**< Pipe buffer: may be NULL */
@@ -4858,6 +5399,10 @@ struct k_pipe {
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_pipe)
 
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+	struct k_pipe_stats stats;	/**< Transfer statistics */
+#endif
+
 #ifdef CONFIG_OBJ_CORE_PIPE
 	struct k_obj_core  obj_core;
 #endif
@@ -4995,6 +5540,62 @@ __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_read, size_t *bytes_read,
 			 size_t min_xfer, k_timeout_t timeout);
 
+/**
+ * @brief Write data from several segments to a pipe.
+ *
+ * This routine works like k_pipe_put(), writing the segments of @a iov
+ * one after the other as a single stream of data. All segments are
+ * written in one go, copying each segment directly to waiting readers
+ * or into the pipe buffer, instead of one call per segment.
+ *
+ * The segment array must stay valid until the call returns. This routine
+ * is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of segments to write.
+ * @param iovcnt Number of segments.
+ * @param bytes_written Address of area to hold the number of bytes written.
+ * @param min_xfer Minimum number of bytes to write.
+ * @param timeout Waiting period to wait for the data to be written,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were written.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EIO Returned without waiting; zero data bytes were written.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were written.
+ */
+int k_pipe_putv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		size_t iovcnt, size_t *bytes_written, size_t min_xfer,
+		k_timeout_t timeout);
+
+/**
+ * @brief Read data from a pipe into several segments.
+ *
+ * This routine works like k_pipe_get(), filling the segments of @a iov
+ * one after the other from the pipe's stream of data.
+ *
+ * The segment array must stay valid until the call returns. This routine
+ * is not available to user mode threads.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of segments to fill.
+ * @param iovcnt Number of segments.
+ * @param bytes_read Address of area to hold the number of bytes read.
+ * @param min_xfer Minimum number of data bytes to read.
+ * @param timeout Waiting period to wait for the data to be read,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were read.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EIO Returned without waiting; zero data bytes were read.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were read.
+ */
+int k_pipe_getv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		size_t iovcnt, size_t *bytes_read, size_t min_xfer,
+		k_timeout_t timeout);
+
 /**
  * @brief Query the number of bytes that may be read from @a pipe.
  *
@@ -5289,10 +5890,23 @@ int k_mem_slab_runtime_stats_reset_max(struct k_mem_slab *slab);
 
 /* kernel synchronized heap struct */
 
+#ifdef CONFIG_HEAP_CACHE
+/* Per-CPU stacks of free small blocks, linked through their first word */
+struct z_heap_cache {
+	struct k_spinlock lock;
+	void *free[CONFIG_HEAP_CACHE_CLASSES];
+	uint8_t count[CONFIG_HEAP_CACHE_CLASSES];
+};
+#endif
+
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_HEAP_CACHE
+	atomic_t waiters;
+	struct z_heap_cache cache[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 };
 
 /**
@@ -5504,6 +6118,45 @@ void k_free(void *ptr);
  */
 void *k_calloc(size_t nmemb, size_t size);
 
+#if defined(CONFIG_HEAP_MEM_POOL_SLABS) || defined(__DOXYGEN__)
+
+/** @brief Usage statistics of one k_malloc() slab size class */
+struct k_malloc_slab_stats {
+	/** Block size of the class, including the k_free() header */
+	size_t block_size;
+	/** Usage of the memory slab backing the class */
+	struct sys_memory_stats slab;
+	/** Requests for the class served by the heap as it was exhausted */
+	uint32_t fallbacks;
+};
+
+/**
+ * @brief Get the usage statistics of a k_malloc() slab size class
+ *
+ * With CONFIG_HEAP_MEM_POOL_SLABS, small k_malloc() requests are served
+ * from CONFIG_HEAP_MEM_POOL_SLAB_CLASSES memory slabs with power-of-two
+ * block sizes starting at 16 bytes.
+ *
+ * @param cls Size class, 0 being the smallest
+ * @param stats Pointer to struct to copy statistics into
+ *
+ * @retval 0 Success
+ * @retval -EINVAL Invalid size class or NULL @a stats
+ */
+int k_malloc_slab_stats_get(unsigned int cls, struct k_malloc_slab_stats *stats);
+
+/**
+ * @brief Reset the maximum usage and fallback count of a size class
+ *
+ * @param cls Size class, 0 being the smallest
+ *
+ * @retval 0 Success
+ * @retval -EINVAL Invalid size class
+ */
+int k_malloc_slab_stats_reset_max(unsigned int cls);
+
+#endif /* CONFIG_HEAP_MEM_POOL_SLABS */
+
 /** @} */
 
 /* polling API - PRIVATE */
@@ -5819,6 +6472,118 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+/**
+ * @brief Poll Set
+ *
+ * A poll set keeps its events registered with their objects between waits,
+ * and collects the events whose objects signaled in a ready list, so waiting
+ * costs time proportional to the number of ready events rather than to the
+ * size of the set.
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+};
+
+/* z_poller mode of poll sets, one of enum POLL_MODE in kernel/poll.c */
+#define Z_POLL_SET_MODE 3
+
+#define Z_POLL_SET_INITIALIZER(obj) \
+	{ \
+	.ready = SYS_DLIST_STATIC_INIT(&obj.ready), \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.poller = { .is_polling = false, .mode = Z_POLL_SET_MODE }, \
+	}
+
+/**
+ * @brief Statically define and initialize a poll set.
+ *
+ * The poll set can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_poll_set <name>; @endcode
+ *
+ * @param name Name of the poll set.
+ */
+#define K_POLL_SET_DEFINE(name) \
+	struct k_poll_set name = Z_POLL_SET_INITIALIZER(name)
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @param set Address of the poll set.
+ */
+void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event must have been initialized with k_poll_event_init() and must
+ * stay valid, and untouched by the caller except for its state field,
+ * until it is removed from the set. An event can belong to only one set,
+ * and must not be passed to k_poll() while it belongs to a set.
+ *
+ * If the event's object is already available, the event is ready right
+ * away.
+ *
+ * @note This routine is only available to kernel threads.
+ *
+ * @param set Address of the poll set.
+ * @param event Event to add.
+ *
+ * @retval 0 Event added.
+ * @retval -EINVAL Event is of type K_POLL_TYPE_IGNORE.
+ * @retval -EBUSY Event already belongs to a set, or is being polled on.
+ */
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @note This routine is only available to kernel threads.
+ *
+ * @param set Address of the poll set.
+ * @param event Event to remove.
+ *
+ * @retval 0 Event removed.
+ * @retval -EINVAL Event does not belong to @a set.
+ */
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to be ready.
+ *
+ * Returns up to @a max_events ready events of the set, with their state
+ * field set as k_poll() would set it. Like k_poll(), a ready event only
+ * tells that its object was available; the object still has to be taken.
+ *
+ * Events are level-triggered: an event is returned by every wait as long as
+ * its object stays available. When more than @a max_events events are
+ * ready, the ones not returned are returned first by the next wait.
+ *
+ * Several threads can wait on the same set; each ready object then wakes
+ * one of them.
+ *
+ * @note This routine is only available to kernel threads.
+ *
+ * @param set Address of the poll set.
+ * @param ready Array to store the ready events in.
+ * @param max_events Size of the @a ready array.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of ready events stored in @a ready (at least one)
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL @a max_events is not positive.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_events, k_timeout_t timeout);
+
 /** @} */
 
 /**
@@ -49,12 +49,19 @@ struct k_thread *z_priq_rb_best(struct _priq_rb *pq);
  * comparatively high, but performance is very fast.  Won't work with
  * features like deadline scheduling which need large priority spaces
  * to represent their requirements.
+ *
+ * A list is only valid while its bitmask bit is set (it gets
+ * initialized when the bit goes from clear to set), so a zero-filled
+ * struct is an empty queue.
  */
+#define PRIQ_BITMAP_SIZE (CONFIG_NUM_COOP_PRIORITIES + CONFIG_NUM_PREEMPT_PRIORITIES + 1)
+
 struct _priq_mq {
-	sys_dlist_t queues[32];
+	sys_dlist_t queues[PRIQ_BITMAP_SIZE];
 	unsigned int bitmask; /* bit 1<<i set if queues[i] is non-empty */
 };
 
 struct k_thread *z_priq_mq_best(struct _priq_mq *pq);
+struct k_thread *z_priq_mq_next(struct _priq_mq *pq, struct k_thread *thread);
 
 #endif /* ZEPHYR_INCLUDE_SCHED_PRIQ_H_ */
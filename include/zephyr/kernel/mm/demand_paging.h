@@ -56,7 +56,24 @@ struct k_mem_paging_stats_t {
 
 		/** Number of dirty pages selected for eviction */
 		unsigned long			dirty;
+
+		/**
+		 * Number of pages selected for eviction while marked as
+		 * recently accessed
+		 */
+		unsigned long			accessed;
+
+		/**
+		 * Number of page faults on pages evicted within the last
+		 * CONFIG_DEMAND_PAGING_STATS_REFAULT_WINDOW evictions
+		 */
+		unsigned long			refaults;
 	} eviction;
+
+	struct {
+		/** Number of pages paged in by read-ahead */
+		unsigned long			pages;
+	} readahead;
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 };
 
@@ -231,6 +248,19 @@ __syscall void k_mem_paging_histogram_backing_store_page_out_get(
  */
 struct z_page_frame *k_mem_paging_eviction_select(bool *dirty);
 
+/**
+ * Report whether the page selected for eviction was recently accessed
+ *
+ * An eviction algorithm may call this from k_mem_paging_eviction_select()
+ * to report whether the page it selected was marked as recently accessed
+ * when it looked at it, before clearing the accessed bit if it does so.
+ * This is only used for the eviction statistics. If the algorithm does not
+ * call it, the accessed bit of the page is read after the selection.
+ *
+ * @param accessed Whether the page to evict was marked as recently accessed
+ */
+void k_mem_paging_eviction_accessed(bool accessed);
+
 /**
  * Initialization function
  *
@@ -26,6 +26,16 @@ struct k_cycle_stats {
 	uint64_t  longest;      /**< \# of cycles in longest usage window */
 	uint32_t  num_windows;  /**< \# of usage windows */
 	/** @} */
+#endif
+#if defined(CONFIG_SCHED_THREAD_LATENCY) || defined(__DOXYGEN__)
+	/**
+	 * @name Fields available when CONFIG_SCHED_THREAD_LATENCY is selected.
+	 * @{
+	 */
+	/** log2 histogram of ready-to-switch-in latencies, in cycles */
+	uint32_t  latency[CONFIG_SCHED_THREAD_LATENCY_BUCKETS];
+	uint32_t  latency_max;  /**< longest latency, in cycles */
+	/** @} */
 #endif
 	bool      track_usage;  /**< true if gathering usage stats */
 };
@@ -52,8 +52,25 @@ struct _pipe_desc {
 	unsigned char   *buffer;         /* Position in src/dest buffer */
 	size_t           bytes_to_xfer;  /* # bytes left to transfer */
 	struct k_thread *thread;         /* Back pointer to pended thread */
+	size_t           seg_left;       /* # bytes left in this segment */
+	const struct k_pipe_iovec *iov;  /* Following segments, if any */
 };
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/* Constant bandwidth server state of a thread with a budget reservation.
+ * Times are in k_cycle_get_32() units, the absolute deadline of the
+ * current period lives in _thread_base.prio_deadline.
+ */
+struct _thread_cbs {
+	uint32_t runtime;        /* Budget per period, 0 if no reservation */
+	uint32_t period;         /* Replenishment period */
+	int32_t budget;          /* Budget left in the current period */
+	uint32_t start;          /* Cycles when switched in, 0 if not running */
+	bool throttled;          /* Out of budget, waiting for replenishment */
+	struct _timeout replenish;
+};
+#endif
+
 /* can be used for creating 'dummy' threads, e.g. for pending on objects */
 struct _thread_base {
 
@@ -105,6 +122,10 @@ struct _thread_base {
 	int prio_deadline;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	struct _thread_cbs cbs;
+#endif
+
 	uint32_t order_key;
 
 #ifdef CONFIG_SMP
@@ -114,6 +135,11 @@ struct _thread_base {
 	/* CPU index on which thread was last run */
 	uint8_t cpu;
 
+#ifdef CONFIG_SCHED_WORK_STEALING
+	/* CPU index whose ready queue holds this thread */
+	uint8_t runq_cpu;
+#endif
+
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
@@ -145,6 +171,11 @@ struct _thread_base {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif
+
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+	/* Time the thread was made ready, 0 once it has been switched in */
+	uint32_t ready_stamp;
+#endif
 };
 
 typedef struct _thread_base _thread_base_t;
@@ -228,6 +259,18 @@ typedef struct k_thread_runtime_stats {
 	uint64_t idle_cycles;
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+	/*
+	 * Log2 histogram of the latencies, in cycles, from a thread being
+	 * made ready to it being switched in: latency[n] counts latencies
+	 * of 2^n to 2^(n+1) - 1 cycles, the last bucket also counting the
+	 * longer ones. For CPUs, it covers all threads switched in on the
+	 * CPU.
+	 */
+	uint32_t latency[CONFIG_SCHED_THREAD_LATENCY_BUCKETS];
+	uint32_t latency_max;         /* longest latency in cycles */
+#endif
+
 #if defined(__cplusplus) && !defined(CONFIG_SCHED_THREAD_USAGE) &&                                 \
 	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL)
 	/* If none of the above Kconfig values are defined, this struct will have a size 0 in C
@@ -260,6 +303,11 @@ struct k_thread {
 	/** threads waiting in k_thread_join() */
 	_wait_q_t join_queue;
 
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+	/** mutex the thread waits for, to follow priority inheritance chains */
+	struct k_mutex *pended_mutex;
+#endif
+
 #if defined(CONFIG_POLL)
 	struct z_poller poller;
 #endif
@@ -332,6 +380,11 @@ struct k_thread {
 	/** resource pool */
 	struct k_heap *resource_pool;
 
+#ifdef CONFIG_THREAD_POOL
+	/* Thread pool the thread belongs to, if any */
+	struct k_thread_pool *thread_pool;
+#endif
+
 #if defined(CONFIG_THREAD_LOCAL_STORAGE)
 	/* Pointer to arch-specific TLS area */
 	uintptr_t tls;
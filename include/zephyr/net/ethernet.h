@@ -179,6 +179,9 @@ enum ethernet_hw_caps {
 
 	/** TXTIME supported */
 	ETHERNET_TXTIME			= BIT(19),
+
+	/** TCP segmentation offload supported, see net_pkt_gso_size() */
+	ETHERNET_HW_TCP_SEG_OFFLOAD	= BIT(20),
 };
 
 /** @cond INTERNAL_HIDDEN */
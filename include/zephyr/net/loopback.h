@@ -33,6 +33,18 @@ int loopback_set_packet_drop_ratio(float ratio);
 int loopback_get_num_dropped_packets(void);
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_PACKET_DELAY
+/**
+ * @brief Set the packet delay
+ *
+ * @param[in] delay_ms Time in milliseconds before a sent packet is received,
+ *                     0 = packets are received immediately
+ *
+ * @return 0 on success, otherwise a negative integer.
+ */
+int loopback_set_packet_delay(uint32_t delay_ms);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -501,6 +501,50 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_buf;
+
+/**
+ * @brief Receive data without copying it
+ *
+ * @details
+ * Instead of copying the received data into a caller supplied buffer,
+ * the network buffers holding the data of the next received packet are
+ * lent to the caller. The data of a stream socket is returned in the
+ * order it was received, but the amount returned by one call depends on
+ * how the peer segmented it. The buffers must be given back with
+ * @ref zsock_recv_zc_release once the data is consumed, for a stream
+ * socket the receive window is not opened before that.
+ *
+ * Only ZSOCK_MSG_DONTWAIT is supported in @p flags. The function is
+ * available for native sockets, and only to kernel threads as the
+ * buffers are not accessible from user mode.
+ * Available if CONFIG_NET_SOCKETS_ZERO_COPY_RX is enabled.
+ *
+ * @param sock Socket to receive from
+ * @param frags Returns the chain of buffers with the data, NULL if no
+ *              data is returned
+ * @param flags Receive flags
+ *
+ * @return Number of bytes in @p frags, 0 at the end of the stream or
+ *         -1 with errno set on error.
+ */
+ssize_t zsock_recv_zc(int sock, struct net_buf **frags, int flags);
+
+/**
+ * @brief Release buffers returned by @ref zsock_recv_zc
+ *
+ * @details
+ * The chain must be handed back unchanged: its data may be read, but
+ * the buffers must not be pulled, trimmed, unlinked or freed. For a
+ * stream socket the receive window is opened by @p len, the amount of
+ * data that was lent.
+ *
+ * @param sock Socket the data was received from
+ * @param frags Chain of buffers returned by @ref zsock_recv_zc
+ * @param len Number of bytes @ref zsock_recv_zc returned with @p frags
+ */
+void zsock_recv_zc_release(int sock, struct net_buf *frags, size_t len);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -1101,6 +1145,13 @@ struct ifreq {
 #define TCP_KEEPINTVL 3
 /** Number of keepalives before dropping connection */
 #define TCP_KEEPCNT 4
+/** Congestion control algorithm, given by its name (e.g. "reno", "cubic") */
+#define TCP_CONGESTION 5
+
+/** Maximum length of a congestion control algorithm name, including the
+ * terminating NUL character.
+ */
+#define TCP_CA_NAME_MAX 16
 
 /* Socket options for IPPROTO_IP level */
 /** sockopt: Set or receive the Type-Of-Service value for an outgoing packet. */
@@ -486,6 +486,225 @@ int ring_buf_item_put(struct ring_buf *buf, uint16_t type, uint8_t value,
 int ring_buf_item_get(struct ring_buf *buf, uint16_t *type, uint8_t *value,
 		      uint32_t *data, uint8_t *size32);
 
+/**
+ * @brief A slot of a multi-producer multi-consumer ring buffer
+ */
+struct ring_buf_mpmc_slot {
+	/** @cond INTERNAL_HIDDEN */
+	/* Sequence number, less the slot index so that 0 is the initial
+	 * state
+	 */
+	atomic_t seq;
+	uint32_t size;
+	/** @endcond */
+};
+
+/**
+ * @brief A structure to represent a multi-producer multi-consumer ring buffer
+ *
+ * Unlike @ref ring_buf, this ring buffer holds a power of 2 number of
+ * fixed size slots, each holding one item of up to the slot size in bytes.
+ * Any number of threads and ISRs, also on different CPUs, may put and get
+ * items concurrently without a lock.
+ */
+struct ring_buf_mpmc {
+	/** @cond INTERNAL_HIDDEN */
+	uint8_t *buffer;
+	struct ring_buf_mpmc_slot *slots;
+	atomic_t put_pos;
+	atomic_t get_pos;
+	uint32_t item_size;
+	uint32_t mask;
+	/** @endcond */
+};
+
+/**
+ * @brief Define and initialize a multi-producer multi-consumer ring buffer.
+ *
+ * The ring buffer can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct ring_buf_mpmc <name>; @endcode
+ *
+ * @param name Name of the ring buffer.
+ * @param item_size8 Maximum size of an item (in bytes).
+ * @param num_items Number of items the ring buffer holds (power of 2).
+ */
+#define RING_BUF_MPMC_DECLARE(name, item_size8, num_items) \
+	BUILD_ASSERT(IS_POWER_OF_TWO(num_items), \
+		"Number of items must be a power of 2"); \
+	BUILD_ASSERT((uint64_t)(item_size8) * (num_items) < \
+		RING_BUFFER_MAX_SIZE, RING_BUFFER_SIZE_ASSERT_MSG); \
+	static uint8_t __noinit __aligned(sizeof(void *)) \
+		_ring_buffer_data_##name[(item_size8) * (num_items)]; \
+	static struct ring_buf_mpmc_slot _ring_buffer_slots_##name[num_items]; \
+	struct ring_buf_mpmc name = { \
+		.buffer = _ring_buffer_data_##name, \
+		.slots = _ring_buffer_slots_##name, \
+		.item_size = (item_size8), \
+		.mask = (num_items) - 1 \
+	}
+
+/**
+ * @brief Initialize a multi-producer multi-consumer ring buffer.
+ *
+ * This routine initializes a ring buffer, prior to its first use. It is only
+ * used for ring buffers not defined using RING_BUF_MPMC_DECLARE.
+ *
+ * @param buf Address of ring buffer.
+ * @param num_items Number of items the ring buffer holds (power of 2).
+ * @param slots Slot array (struct ring_buf_mpmc_slot slots[num_items]).
+ * @param item_size Maximum size of an item (in bytes).
+ * @param data Ring buffer data area (uint8_t data[item_size * num_items]).
+ */
+static inline void ring_buf_mpmc_init(struct ring_buf_mpmc *buf,
+				      uint32_t num_items,
+				      struct ring_buf_mpmc_slot *slots,
+				      uint32_t item_size,
+				      uint8_t *data)
+{
+	__ASSERT(IS_POWER_OF_TWO(num_items),
+		 "Number of items must be a power of 2");
+	__ASSERT((uint64_t)item_size * num_items < RING_BUFFER_MAX_SIZE,
+		 RING_BUFFER_SIZE_ASSERT_MSG);
+
+	buf->buffer = data;
+	buf->slots = slots;
+	buf->item_size = item_size;
+	buf->mask = num_items - 1;
+	atomic_clear(&buf->put_pos);
+	atomic_clear(&buf->get_pos);
+	for (uint32_t i = 0; i < num_items; i++) {
+		atomic_clear(&slots[i].seq);
+	}
+}
+
+/**
+ * @brief Determine the number of items in a multi-producer multi-consumer
+ * ring buffer.
+ *
+ * The value is only a snapshot, and includes items being written or read.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Number of items.
+ */
+static inline uint32_t ring_buf_mpmc_size_get(struct ring_buf_mpmc *buf)
+{
+	atomic_val_t get_pos = atomic_get(&buf->get_pos);
+
+	return (uint32_t)(atomic_get(&buf->put_pos) - get_pos);
+}
+
+/**
+ * @brief Return the number of items a multi-producer multi-consumer ring
+ * buffer holds.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer capacity (in items).
+ */
+static inline uint32_t ring_buf_mpmc_capacity_get(struct ring_buf_mpmc *buf)
+{
+	return buf->mask + 1;
+}
+
+/**
+ * @brief Allocate a slot for writing an item to a multi-producer
+ * multi-consumer ring buffer.
+ *
+ * On success, @a data points to the slot, of which up to the returned
+ * number of bytes may be written in place. The item becomes visible to
+ * readers once @ref ring_buf_mpmc_put_finish is called for it. Producers
+ * may finish their slots in any order, but items are read in the order
+ * of the claims, so readers find the ring buffer empty at an item that is
+ * claimed but not finished yet.
+ *
+ * This routine does not block and may be called from any context.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to a slot within the
+ *		    ring buffer.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Size of the allocated slot, which is smaller than requested if
+ *	   @a size exceeds the item size, or 0 if the ring buffer is full
+ *	   or @a size is 0.
+ */
+uint32_t ring_buf_mpmc_put_claim(struct ring_buf_mpmc *buf, uint8_t **data,
+				 uint32_t size);
+
+/**
+ * @brief Publish an item written to a claimed slot.
+ *
+ * An item of size 0 is dropped, but its slot must still be finished.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Slot returned by @ref ring_buf_mpmc_put_claim.
+ * @param size Number of valid bytes in the slot.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL @a data is not a slot or @a size exceeds the item size.
+ */
+int ring_buf_mpmc_put_finish(struct ring_buf_mpmc *buf, uint8_t *data,
+			     uint32_t size);
+
+/**
+ * @brief Write (copy) an item to a multi-producer multi-consumer ring buffer.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of item.
+ * @param size Item size (in bytes).
+ *
+ * @return Number of bytes written, which is smaller than @a size if it
+ *	   exceeds the item size, or 0 if the ring buffer is full.
+ */
+uint32_t ring_buf_mpmc_put(struct ring_buf_mpmc *buf, const uint8_t *data,
+			   uint32_t size);
+
+/**
+ * @brief Get the next item of a multi-producer multi-consumer ring buffer
+ * for reading in place.
+ *
+ * The slot is not reused until @ref ring_buf_mpmc_get_finish is called
+ * for it. Consumers may finish their slots in any order.
+ *
+ * This routine does not block and may be called from any context.
+ *
+ * @param[in]  buf  Address of ring buffer.
+ * @param[out] data Pointer to the address. It is set to the item's slot
+ *		    within the ring buffer.
+ *
+ * @return Size of the item (in bytes), or 0 if the ring buffer is empty.
+ */
+uint32_t ring_buf_mpmc_get_claim(struct ring_buf_mpmc *buf, uint8_t **data);
+
+/**
+ * @brief Release the slot of an item read in place.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Slot returned by @ref ring_buf_mpmc_get_claim.
+ *
+ * @retval 0 Successful operation.
+ * @retval -EINVAL @a data is not a slot.
+ */
+int ring_buf_mpmc_get_finish(struct ring_buf_mpmc *buf, uint8_t *data);
+
+/**
+ * @brief Read (copy) an item from a multi-producer multi-consumer ring
+ * buffer.
+ *
+ * An item larger than @a size is truncated.
+ *
+ * @param buf  Address of ring buffer.
+ * @param data Address of the output buffer. Can be NULL to discard the item.
+ * @param size Output buffer size (in bytes).
+ *
+ * @return Number of bytes read, or 0 if the ring buffer is empty.
+ */
+uint32_t ring_buf_mpmc_get(struct ring_buf_mpmc *buf, uint8_t *data,
+			   uint32_t size);
+
 /**
  * @}
  */
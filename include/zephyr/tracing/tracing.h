@@ -346,6 +346,21 @@
  */
 #define sys_port_trace_k_work_submit_exit(work, ret)
 
+/**
+ * @brief Trace submit work batch to queue entry
+ * @param queue Work queue structure
+ * @param count Number of work items
+ */
+#define sys_port_trace_k_work_submit_batch_to_queue_enter(queue, count)
+
+/**
+ * @brief Trace submit work batch to queue exit
+ * @param queue Work queue structure
+ * @param count Number of work items
+ * @param ret Return value
+ */
+#define sys_port_trace_k_work_submit_batch_to_queue_exit(queue, count, ret)
+
 /**
  * @brief Trace flush work call entry
  * @param work Work structure
@@ -559,6 +574,19 @@
  */
 #define sys_port_trace_k_work_cancel_delayable_exit(dwork, ret)
 
+/**
+ * @brief Trace delayable work batch cancel enter
+ * @param count Number of delayable work items
+ */
+#define sys_port_trace_k_work_cancel_delayable_batch_enter(count)
+
+/**
+ * @brief Trace delayable work batch cancel exit
+ * @param count Number of delayable work items
+ * @param ret Return value
+ */
+#define sys_port_trace_k_work_cancel_delayable_batch_exit(count, ret)
+
 /**
  * @brief Trace delayable work cancel sync enter
  * @param dwork Delayable Work structure
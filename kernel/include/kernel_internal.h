@@ -171,6 +171,11 @@ extern uint8_t *z_priv_stack_find(k_thread_stack_t *stack);
 /* Calculate stack usage. */
 int z_stack_space_get(const uint8_t *stack_start, size_t size, size_t *unused_ptr);
 
+#ifdef CONFIG_THREAD_POOL
+/* Thread pool slot release hook, called from z_thread_abort() */
+void z_thread_pool_abort(struct k_thread *thread);
+#endif
+
 #ifdef CONFIG_USERSPACE
 bool z_stack_is_user_capable(k_thread_stack_t *stack);
 
@@ -109,6 +109,12 @@ static inline bool z_is_thread_prevented_from_running(struct k_thread *thread)
 {
 	uint8_t state = thread->base.thread_state;
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	if (thread->base.cbs.throttled) {
+		return true;
+	}
+#endif
+
 	return (state & (_THREAD_PENDING | _THREAD_PRESTART | _THREAD_DEAD |
 			 _THREAD_DUMMY | _THREAD_SUSPENDED)) != 0U;
 
@@ -421,6 +427,37 @@ void z_sched_cpu_usage(uint8_t core_id, struct k_thread_runtime_stats *stats);
 void z_sched_thread_usage(struct k_thread *thread,
 			  struct k_thread_runtime_stats *stats);
 
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+/**
+ * @brief Timestamp a thread made ready, for its scheduling latency
+ */
+void z_sched_latency_ready(struct k_thread *thread);
+#endif
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/**
+ * @brief Charge and arm the budget of a thread being switched in
+ *
+ * Called from z_sched_usage_start(), with the same requirements.
+ */
+void z_sched_cbs_start(struct k_thread *thread);
+
+/**
+ * @brief Charge the budget of the thread being switched out
+ *
+ * Called from z_sched_usage_stop(), with the same requirements.
+ */
+void z_sched_cbs_stop(void);
+#endif
+
+static inline void z_sched_usage_ready(struct k_thread *thread)
+{
+	ARG_UNUSED(thread);
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+	z_sched_latency_ready(thread);
+#endif
+}
+
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
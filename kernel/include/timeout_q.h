@@ -25,6 +25,10 @@ extern "C" {
 static inline void z_init_timeout(struct _timeout *to)
 {
 	sys_dnode_init(&to->node);
+#ifdef CONFIG_TIMEOUT_SLACK
+	to->slack = 0U;
+	to->deferred = 0U;
+#endif
 }
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
@@ -58,6 +62,11 @@ int32_t z_get_next_timeout_expiry(void);
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout);
 
+#if defined(CONFIG_TIMEOUT_QUEUE_PER_CPU) && defined(CONFIG_SCHED_CPU_MASK)
+/* Move a pending timeout to the queue of a CPU in cpu_mask */
+void z_migrate_timeout(struct _timeout *to, uint32_t cpu_mask);
+#endif
+
 #else
 
 /* Stubs when !CONFIG_SYS_CLOCK_EXISTS */
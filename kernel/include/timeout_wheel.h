@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_
+#define ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_
+
+#include <zephyr/kernel_structs.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Hierarchical timing wheel used as the backend of the kernel timeout
+ * queue when CONFIG_TIMEOUT_QUEUE_WHEEL=y.
+ *
+ * Each level has 64 slots; the slot index of a timeout at level L is
+ * bit group L (6 bits each) of its absolute expiry tick.  A timeout
+ * is stored at the highest bit group in which its expiry differs from
+ * the wheel base, so every entry of level L expires before every
+ * entry of level L+1 and the lowest set bit of a level's bitmask is
+ * always its earliest slot.  Timeouts too far in the future for the
+ * wheel live on an unsorted overflow list.
+ *
+ * Inserting and removing are O(1).  Advancing the base re-files the
+ * entries of the single slot being entered (the "cascade"), and
+ * finding the earliest entry scans at most one slot.
+ *
+ * The slot lists are only initialized when their bitmask bit goes
+ * from clear to set, so a zero-filled wheel is a valid empty wheel.
+ * None of these functions are locked; the caller serializes.
+ */
+
+#define Z_TW_SLOT_BITS 6
+#define Z_TW_SLOTS     BIT(Z_TW_SLOT_BITS)
+
+struct z_tw_level {
+	sys_dlist_t slots[Z_TW_SLOTS];
+	uint64_t bitmask; /* bit 1<<i set if slots[i] is non-empty */
+};
+
+struct z_timeout_wheel {
+	/* No entry expires before this tick */
+	uint64_t base;
+	/* Cached earliest entry, NULL when it needs recomputing */
+	struct _timeout *next;
+	struct z_tw_level levels[CONFIG_TIMEOUT_WHEEL_LEVELS];
+	sys_dlist_t overflow;
+	bool overflow_used;
+};
+
+/**
+ * @brief Insert a timeout expiring at an absolute tick
+ *
+ * The absolute expiry is stored in @a to's dticks field.
+ *
+ * @param tw Timing wheel
+ * @param to Unlinked timeout
+ * @param expiry Absolute expiry tick, not earlier than the wheel base
+ */
+void z_tw_insert(struct z_timeout_wheel *tw, struct _timeout *to,
+		 uint64_t expiry);
+
+/**
+ * @brief Remove a timeout previously inserted with z_tw_insert()
+ */
+void z_tw_remove(struct z_timeout_wheel *tw, struct _timeout *to);
+
+/**
+ * @brief Return the earliest expiring timeout, or NULL if empty
+ *
+ * Timeouts with equal expiry are returned in insertion order.
+ */
+struct _timeout *z_tw_first(struct z_timeout_wheel *tw);
+
+/**
+ * @brief Move the wheel base forward
+ *
+ * @param now New base, which must not be after the earliest expiry
+ */
+void z_tw_advance(struct z_timeout_wheel *tw, uint64_t now);
+
+/**
+ * @brief Absolute expiry tick of a timeout stored in the wheel
+ */
+static inline uint64_t z_tw_expiry(const struct z_timeout_wheel *tw,
+				   const struct _timeout *to)
+{
+#ifdef CONFIG_TIMEOUT_64BIT
+	ARG_UNUSED(tw);
+
+	return (uint64_t)to->dticks;
+#else
+	/* Only the low 32 bits are stored, but entries never lie before
+	 * the base nor more than 2^31 ticks after it.
+	 */
+	return tw->base + (uint32_t)((uint32_t)to->dticks - (uint32_t)tw->base);
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_KERNEL_INCLUDE_TIMEOUT_WHEEL_H_ */
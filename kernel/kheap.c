@@ -8,14 +8,189 @@
 #include <zephyr/init.h>
 #include <zephyr/linker/linker-defs.h>
 #include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/math_extras.h>
+#include <string.h>
 /* private kernel APIs */
 #include <ksched.h>
 #include <wait_q.h>
 
+#ifdef CONFIG_HEAP_CACHE
+
+/* Small blocks freed to a k_heap are kept on per-CPU, per size class
+ * free lists (singly linked through the first word of each block) and
+ * handed out again without going through the sys_heap.  Size class i
+ * holds blocks with at least (16 << i) usable bytes.  Each cache has
+ * its own lock, so a thread that migrates between picking a cache and
+ * locking it is merely slower.
+ *
+ * Blocks freed into a cache don't wake threads pended on the heap, so
+ * while any thread is pended (h->waiters != 0) frees bypass the
+ * caches.  A thread about to pend raises h->waiters and then empties
+ * all caches back into the heap with the heap lock held, which catches
+ * any block cached concurrently.  Lock order is heap, then cache.
+ */
+
+#define CACHE_MIN_SHIFT 4
+
+static inline struct z_heap_cache *cache_local(struct k_heap *h)
+{
+#ifdef CONFIG_SMP
+	/* Unlocked, so we may already have moved on: harmless */
+	return &h->cache[arch_curr_cpu()->id];
+#else
+	return &h->cache[0];
+#endif
+}
+
+/* Smallest class with blocks of at least this many bytes, or -1 */
+static inline int cache_class_alloc(size_t bytes)
+{
+	if ((bytes == 0) || (bytes > (BIT(CACHE_MIN_SHIFT) <<
+				      (CONFIG_HEAP_CACHE_CLASSES - 1)))) {
+		return -1;
+	}
+	if (bytes <= BIT(CACHE_MIN_SHIFT)) {
+		return 0;
+	}
+
+	return 32 - u32_count_leading_zeros((uint32_t)bytes - 1U) -
+	       CACHE_MIN_SHIFT;
+}
+
+/* Largest class a block of this usable size satisfies, or -1 */
+static inline int cache_class_free(size_t usable)
+{
+	int cls;
+
+	if (usable < BIT(CACHE_MIN_SHIFT)) {
+		return -1;
+	}
+
+	cls = 31 - u32_count_leading_zeros((uint32_t)MIN(usable, UINT32_MAX)) -
+	      CACHE_MIN_SHIFT;
+
+	return (cls < CONFIG_HEAP_CACHE_CLASSES) ? cls : -1;
+}
+
+static void *cache_get(struct k_heap *h, size_t align, size_t bytes)
+{
+	int cls = cache_class_alloc(bytes);
+	struct z_heap_cache *c;
+	k_spinlock_key_t key;
+	void *mem;
+
+	/* Freed blocks are only guaranteed the default alignment */
+	if ((cls < 0) || (align > sizeof(void *))) {
+		return NULL;
+	}
+
+	c = cache_local(h);
+	key = k_spin_lock(&c->lock);
+	mem = c->free[cls];
+	if (mem != NULL) {
+		c->free[cls] = *(void **)mem;
+		c->count[cls]--;
+	}
+	k_spin_unlock(&c->lock, key);
+
+	return mem;
+}
+
+static bool cache_put(struct k_heap *h, void *mem)
+{
+	struct z_heap_cache *c;
+	k_spinlock_key_t key;
+	bool cached = false;
+	int cls;
+
+	if (mem == NULL) {
+		return false;
+	}
+
+	/* The chunk is ours, so its size can be read without the lock */
+	cls = cache_class_free(sys_heap_usable_size(&h->heap, mem));
+	if (cls < 0) {
+		return false;
+	}
+
+	c = cache_local(h);
+	key = k_spin_lock(&c->lock);
+	if ((atomic_get(&h->waiters) == 0) &&
+	    (c->count[cls] < CONFIG_HEAP_CACHE_DEPTH)) {
+		*(void **)mem = c->free[cls];
+		c->free[cls] = mem;
+		c->count[cls]++;
+		cached = true;
+	}
+	k_spin_unlock(&c->lock, key);
+
+	return cached;
+}
+
+/* Return all cached blocks to the heap, with h->lock held */
+static bool cache_flush(struct k_heap *h)
+{
+	bool flushed = false;
+
+	for (int i = 0; i < ARRAY_SIZE(h->cache); i++) {
+		struct z_heap_cache *c = &h->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+		for (int cls = 0; cls < CONFIG_HEAP_CACHE_CLASSES; cls++) {
+			void *mem = c->free[cls];
+
+			while (mem != NULL) {
+				void *next = *(void **)mem;
+
+				sys_heap_free(&h->heap, mem);
+				mem = next;
+				flushed = true;
+			}
+			c->free[cls] = NULL;
+			c->count[cls] = 0U;
+		}
+		k_spin_unlock(&c->lock, key);
+	}
+
+	return flushed;
+}
+
+#else
+
+static inline void *cache_get(struct k_heap *h, size_t align, size_t bytes)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(align);
+	ARG_UNUSED(bytes);
+
+	return NULL;
+}
+
+static inline bool cache_put(struct k_heap *h, void *mem)
+{
+	ARG_UNUSED(h);
+	ARG_UNUSED(mem);
+
+	return false;
+}
+
+static inline bool cache_flush(struct k_heap *h)
+{
+	ARG_UNUSED(h);
+
+	return false;
+}
+
+#endif /* CONFIG_HEAP_CACHE */
+
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
+#ifdef CONFIG_HEAP_CACHE
+	atomic_clear(&h->waiters);
+	memset(h->cache, 0, sizeof(h->cache));
+#endif
 
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, h);
 }
@@ -66,7 +241,13 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 			k_timeout_t timeout)
 {
 	k_timepoint_t end = sys_timepoint_calc(timeout);
-	void *ret = NULL;
+	void *ret = cache_get(h, align, bytes);
+
+	if (ret != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
+		return ret;
+	}
 
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
@@ -79,6 +260,10 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 	while (ret == NULL) {
 		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
 
+		if ((ret == NULL) && cache_flush(h)) {
+			ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+		}
+
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 			break;
@@ -88,6 +273,17 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 			blocked_alloc = true;
 
 			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_heap, aligned_alloc, h, timeout);
+
+#ifdef CONFIG_HEAP_CACHE
+			/* Stop frees from caching blocks we won't be
+			 * woken for, then collect the ones cached since
+			 * the flush above.
+			 */
+			atomic_inc(&h->waiters);
+			if (cache_flush(h)) {
+				continue;
+			}
+#endif
 		} else {
 			/**
 			 * @todo	Trace attempt to avoid empty trace segments
@@ -99,6 +295,12 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 		key = k_spin_lock(&h->lock);
 	}
 
+#ifdef CONFIG_HEAP_CACHE
+	if (blocked_alloc) {
+		atomic_dec(&h->waiters);
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
 
 	k_spin_unlock(&h->lock, key);
@@ -118,6 +320,11 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
+	if (cache_put(h, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
+		return;
+	}
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	sys_heap_free(&h->heap, mem);
@@ -40,6 +40,82 @@ static void *z_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t size
 	return mem;
 }
 
+#ifdef CONFIG_HEAP_MEM_POOL_SLABS
+
+/* Small k_malloc() blocks come from one memory slab per power-of-two
+ * size class.  They carry the same one pointer header as heap blocks,
+ * holding the slab address with the low bit set instead of the heap
+ * address, so k_free() can tell the two apart.
+ */
+
+#define SLAB_MIN_SHIFT 4
+#define SLAB_CLASSES   CONFIG_HEAP_MEM_POOL_SLAB_CLASSES
+#define SLAB_REF_TAG   1U
+
+#define MALLOC_SLAB_DEFINE(i, _)					\
+	K_MEM_SLAB_DEFINE_STATIC(malloc_slab_##i,			\
+				 BIT(SLAB_MIN_SHIFT + (i)),		\
+				 CONFIG_HEAP_MEM_POOL_SLAB_BLOCKS,	\
+				 sizeof(void *))
+#define MALLOC_SLAB_REF(i, _) &malloc_slab_##i
+
+LISTIFY(SLAB_CLASSES, MALLOC_SLAB_DEFINE, (;));
+
+static struct k_mem_slab *const malloc_slabs[SLAB_CLASSES] = {
+	LISTIFY(SLAB_CLASSES, MALLOC_SLAB_REF, (,))
+};
+
+static atomic_t malloc_slab_fallbacks[SLAB_CLASSES];
+
+static void *slab_alloc(size_t size)
+{
+	void **slab_ref;
+	int cls;
+
+	if (size_add_overflow(size, sizeof(*slab_ref), &size) ||
+	    (size > BIT(SLAB_MIN_SHIFT + SLAB_CLASSES - 1))) {
+		return NULL;
+	}
+
+	cls = (size <= BIT(SLAB_MIN_SHIFT)) ? 0 :
+	      32 - u32_count_leading_zeros((uint32_t)size - 1U) - SLAB_MIN_SHIFT;
+
+	if (k_mem_slab_alloc(malloc_slabs[cls], (void **)&slab_ref,
+			     K_NO_WAIT) != 0) {
+		atomic_inc(&malloc_slab_fallbacks[cls]);
+		return NULL;
+	}
+
+	*slab_ref = (void *)((uintptr_t)malloc_slabs[cls] | SLAB_REF_TAG);
+
+	return ++slab_ref;
+}
+
+int k_malloc_slab_stats_get(unsigned int cls, struct k_malloc_slab_stats *stats)
+{
+	if ((cls >= SLAB_CLASSES) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	stats->block_size = malloc_slabs[cls]->info.block_size;
+	stats->fallbacks = (uint32_t)atomic_get(&malloc_slab_fallbacks[cls]);
+
+	return k_mem_slab_runtime_stats_get(malloc_slabs[cls], &stats->slab);
+}
+
+int k_malloc_slab_stats_reset_max(unsigned int cls)
+{
+	if (cls >= SLAB_CLASSES) {
+		return -EINVAL;
+	}
+
+	atomic_clear(&malloc_slab_fallbacks[cls]);
+
+	return k_mem_slab_runtime_stats_reset_max(malloc_slabs[cls]);
+}
+
+#endif /* CONFIG_HEAP_MEM_POOL_SLABS */
+
 void k_free(void *ptr)
 {
 	struct k_heap **heap_ref;
@@ -48,6 +124,16 @@ void k_free(void *ptr)
 		heap_ref = ptr;
 		ptr = --heap_ref;
 
+#ifdef CONFIG_HEAP_MEM_POOL_SLABS
+		/* Traced by the k_mem_slab hooks */
+		if (((uintptr_t)*heap_ref & SLAB_REF_TAG) != 0U) {
+			k_mem_slab_free((struct k_mem_slab *)
+					((uintptr_t)*heap_ref & ~SLAB_REF_TAG),
+					ptr);
+			return;
+		}
+#endif
+
 		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_free, *heap_ref, heap_ref);
 
 		k_heap_free(*heap_ref, ptr);
@@ -72,7 +158,17 @@ void *k_aligned_alloc(size_t align, size_t size)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_aligned_alloc, _SYSTEM_HEAP);
 
-	void *ret = z_heap_aligned_alloc(_SYSTEM_HEAP, align, size);
+	void *ret = NULL;
+
+#ifdef CONFIG_HEAP_MEM_POOL_SLABS
+	/* Slab blocks only get pointer alignment past their header */
+	if (align <= sizeof(void *)) {
+		ret = slab_alloc(size);
+	}
+#endif
+	if (ret == NULL) {
+		ret = z_heap_aligned_alloc(_SYSTEM_HEAP, align, size);
+	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap_sys, k_aligned_alloc, _SYSTEM_HEAP, ret);
 
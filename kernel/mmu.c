@@ -1007,8 +1007,30 @@ struct k_mem_paging_stats_t paging_stats;
 extern struct k_mem_paging_histogram_t z_paging_histogram_eviction;
 extern struct k_mem_paging_histogram_t z_paging_histogram_backing_store_page_in;
 extern struct k_mem_paging_histogram_t z_paging_histogram_backing_store_page_out;
+
+#if CONFIG_DEMAND_PAGING_STATS_REFAULT_WINDOW > 0
+/* Data pages of the most recent evictions, to tell refaults apart */
+static void *evicted_pages[CONFIG_DEMAND_PAGING_STATS_REFAULT_WINDOW];
+static unsigned int evicted_pages_next;
 #endif
 
+/* Accessed state of the page being evicted, if the eviction algorithm
+ * reported it
+ */
+static bool eviction_accessed_reported;
+static bool eviction_accessed;
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+
+void k_mem_paging_eviction_accessed(bool accessed)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	eviction_accessed_reported = true;
+	eviction_accessed = accessed;
+#else
+	ARG_UNUSED(accessed);
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+
 static inline void do_backing_store_page_in(uintptr_t location)
 {
 #ifdef CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM
@@ -1325,24 +1347,81 @@ static inline void paging_stats_faults_inc(struct k_thread *faulting_thread,
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
+static inline void paging_stats_refaults_inc(struct k_thread *faulting_thread,
+					     void *addr)
+{
+#if defined(CONFIG_DEMAND_PAGING_STATS) && \
+	(CONFIG_DEMAND_PAGING_STATS_REFAULT_WINDOW > 0)
+	void *page = UINT_TO_POINTER(POINTER_TO_UINT(addr)
+				     & ~(CONFIG_MMU_PAGE_SIZE - 1));
+
+	for (int i = 0; i < ARRAY_SIZE(evicted_pages); i++) {
+		if (evicted_pages[i] == page) {
+			evicted_pages[i] = NULL;
+			paging_stats.eviction.refaults++;
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+			faulting_thread->paging_stats.eviction.refaults++;
+#endif
+			break;
+		}
+	}
+#else
+	ARG_UNUSED(faulting_thread);
+	ARG_UNUSED(addr);
+#endif
+}
+
 static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
+					     struct z_page_frame *pf,
 					     bool dirty)
 {
 #ifdef CONFIG_DEMAND_PAGING_STATS
+	bool accessed = eviction_accessed_reported ? eviction_accessed :
+			(arch_page_info_get(pf->addr, NULL, false) &
+			 ARCH_DATA_PAGE_ACCESSED) != 0UL;
+
 	if (dirty) {
 		paging_stats.eviction.dirty++;
 	} else {
 		paging_stats.eviction.clean++;
 	}
+	if (accessed) {
+		paging_stats.eviction.accessed++;
+	}
+#if CONFIG_DEMAND_PAGING_STATS_REFAULT_WINDOW > 0
+	evicted_pages[evicted_pages_next] = pf->addr;
+	evicted_pages_next = (evicted_pages_next + 1U) %
+			     ARRAY_SIZE(evicted_pages);
+#endif
 #ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
 	if (dirty) {
 		faulting_thread->paging_stats.eviction.dirty++;
 	} else {
 		faulting_thread->paging_stats.eviction.clean++;
 	}
+	if (accessed) {
+		faulting_thread->paging_stats.eviction.accessed++;
+	}
 #else
 	ARG_UNUSED(faulting_thread);
 #endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#else
+	ARG_UNUSED(faulting_thread);
+	ARG_UNUSED(pf);
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+
+static inline void paging_stats_readahead_inc(struct k_thread *faulting_thread)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	paging_stats.readahead.pages++;
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	faulting_thread->paging_stats.readahead.pages++;
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#else
+	ARG_UNUSED(faulting_thread);
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
@@ -1364,6 +1443,10 @@ static inline struct z_page_frame *do_eviction_select(bool *dirty)
 #endif /* CONFIG_DEMAND_PAGING_STATS_USING_TIMING_FUNCTIONS */
 #endif /* CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM */
 
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	eviction_accessed_reported = false;
+#endif
+
 	pf = k_mem_paging_eviction_select(dirty);
 
 #ifdef CONFIG_DEMAND_PAGING_TIMING_HISTOGRAM
@@ -1380,14 +1463,128 @@ static inline struct z_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
+/*
+ * Bring the data page at addr in from page_in_location into pf, which is
+ * either free or was just selected for eviction. Called and returns with
+ * IRQs locked in *key, which may get unlocked in between.
+ */
+static void page_frame_fill_locked(struct z_page_frame *pf, bool dirty,
+				   void *addr, uintptr_t page_in_location,
+				   bool pin, int *key)
+{
+	uintptr_t page_out_location;
+	int ret;
+
+	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
+	__ASSERT(ret == 0, "failed to prepare page frame");
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	irq_unlock(*key);
+	/* Interrupts are now unlocked if they were not locked when we entered
+	 * this function, and we may service ISRs. The scheduler is still
+	 * locked.
+	 */
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	if (dirty) {
+		do_backing_store_page_out(page_out_location);
+	}
+	do_backing_store_page_in(page_in_location);
+
+#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
+	*key = irq_lock();
+	pf->flags &= ~Z_PAGE_FRAME_BUSY;
+#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+	if (pin) {
+		pf->flags |= Z_PAGE_FRAME_PINNED;
+	}
+	pf->flags |= Z_PAGE_FRAME_MAPPED;
+	pf->addr = UINT_TO_POINTER(POINTER_TO_UINT(addr)
+				   & ~(CONFIG_MMU_PAGE_SIZE - 1));
+
+	arch_mem_page_in(addr, z_page_frame_to_phys(pf));
+	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+}
+
+/*
+ * Bring the data page at addr in from page_in_location, evicting a page
+ * frame if there are no free ones. Called and returns with IRQs locked
+ * in *key, which may get unlocked in between.
+ */
+static void page_in_locked(void *addr, uintptr_t page_in_location,
+			   bool pin, struct k_thread *faulting_thread,
+			   int *key)
+{
+	struct z_page_frame *pf;
+	bool dirty = false;
+
+	pf = free_page_frame_list_get();
+	if (pf == NULL) {
+		/* Need to evict a page frame */
+		pf = do_eviction_select(&dirty);
+		__ASSERT(pf != NULL, "failed to get a page frame");
+		LOG_DBG("evicting %p at 0x%lx", pf->addr,
+			z_page_frame_to_phys(pf));
+
+		paging_stats_eviction_inc(faulting_thread, pf, dirty);
+	}
+	page_frame_fill_locked(pf, dirty, addr, page_in_location, pin, key);
+}
+
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+/* Data page of the last page fault, to detect sequential access */
+static uintptr_t last_fault_page;
+
+/*
+ * Page in the data pages following the one at addr, if the page faults
+ * look sequential. Only free page frames are used, so reading ahead
+ * never evicts anything, including the page just brought in. Called and
+ * returns with IRQs locked.
+ */
+static void read_ahead_locked(void *addr, struct k_thread *faulting_thread,
+			      int *key)
+{
+	uintptr_t page = POINTER_TO_UINT(addr) & ~(CONFIG_MMU_PAGE_SIZE - 1);
+	uintptr_t location;
+	bool sequential = (page == last_fault_page + CONFIG_MMU_PAGE_SIZE);
+	int n;
+
+	last_fault_page = page;
+	if (!sequential) {
+		return;
+	}
+
+	for (n = 0; n < CONFIG_DEMAND_PAGING_READ_AHEAD; n++) {
+		uintptr_t next = page + (n + 1) * CONFIG_MMU_PAGE_SIZE;
+		struct z_page_frame *pf;
+
+		if (next < page ||
+		    arch_page_location_get(UINT_TO_POINTER(next), &location) !=
+		    ARCH_PAGE_LOCATION_PAGED_OUT) {
+			break;
+		}
+
+		pf = free_page_frame_list_get();
+		if (pf == NULL) {
+			break;
+		}
+
+		page_frame_fill_locked(pf, false, UINT_TO_POINTER(next),
+				       location, false, key);
+		paging_stats_readahead_inc(faulting_thread);
+	}
+
+	/* A fault right behind the pages read ahead continues the run */
+	last_fault_page = page + n * CONFIG_MMU_PAGE_SIZE;
+}
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD */
+
 static bool do_page_fault(void *addr, bool pin)
 {
 	struct z_page_frame *pf;
-	int key, ret;
-	uintptr_t page_in_location, page_out_location;
+	int key;
+	uintptr_t page_in_location;
 	enum arch_page_location status;
 	bool result;
-	bool dirty = false;
 	struct k_thread *faulting_thread = _current_cpu->current;
 
 	__ASSERT(page_frames_initialized, "page fault at %p happened too early",
@@ -1460,45 +1657,12 @@ static bool do_page_fault(void *addr, bool pin)
 		 "unexpected status value %d", status);
 
 	paging_stats_faults_inc(faulting_thread, key);
+	paging_stats_refaults_inc(faulting_thread, addr);
 
-	pf = free_page_frame_list_get();
-	if (pf == NULL) {
-		/* Need to evict a page frame */
-		pf = do_eviction_select(&dirty);
-		__ASSERT(pf != NULL, "failed to get a page frame");
-		LOG_DBG("evicting %p at 0x%lx", pf->addr,
-			z_page_frame_to_phys(pf));
-
-		paging_stats_eviction_inc(faulting_thread, dirty);
-	}
-	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
-	__ASSERT(ret == 0, "failed to prepare page frame");
-
-#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
-	irq_unlock(key);
-	/* Interrupts are now unlocked if they were not locked when we entered
-	 * this function, and we may service ISRs. The scheduler is still
-	 * locked.
-	 */
-#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	if (dirty) {
-		do_backing_store_page_out(page_out_location);
-	}
-	do_backing_store_page_in(page_in_location);
-
-#ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
-	key = irq_lock();
-	pf->flags &= ~Z_PAGE_FRAME_BUSY;
-#endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	if (pin) {
-		pf->flags |= Z_PAGE_FRAME_PINNED;
-	}
-	pf->flags |= Z_PAGE_FRAME_MAPPED;
-	pf->addr = UINT_TO_POINTER(POINTER_TO_UINT(addr)
-				   & ~(CONFIG_MMU_PAGE_SIZE - 1));
-
-	arch_mem_page_in(addr, z_page_frame_to_phys(pf));
-	k_mem_paging_backing_store_page_finalize(pf, page_in_location);
+	page_in_locked(addr, page_in_location, pin, faulting_thread, &key);
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+	read_ahead_locked(addr, faulting_thread, &key);
+#endif
 out:
 	irq_unlock(key);
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
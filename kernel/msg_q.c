@@ -36,6 +36,81 @@ static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
 }
 #endif /* CONFIG_POLL */
 
+#ifdef CONFIG_MSGQ_ZERO_COPY
+/* Let threads blocked in k_msgq_reserve() or k_msgq_claim() retry.
+ *
+ * @return true if a thread was woken and a reschedule is needed
+ */
+static inline bool handle_zc_waiters(struct k_msgq *msgq)
+{
+	if (z_waitq_head(&msgq->zc_wait_q) == NULL) {
+		return false;
+	}
+
+	return z_sched_wake_all(&msgq->zc_wait_q, 0, NULL);
+}
+
+static inline bool msgq_has_zc_waiters(struct k_msgq *msgq)
+{
+	return z_waitq_head(&msgq->zc_wait_q) != NULL;
+}
+
+/* Wait, with the lock held, until @a flag is clear, i.e. until the slot
+ * reserved with k_msgq_reserve() is committed or the message claimed with
+ * k_msgq_claim() is released.  @a timeout is updated to what is left of it.
+ *
+ * @return 0 once clear, -EBUSY without waiting, or the result of the wait
+ */
+static int wait_zc_flag_clear(struct k_msgq *msgq, uint8_t flag,
+			      k_spinlock_key_t *key, k_timeout_t *timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(*timeout);
+	int result;
+
+	while ((msgq->flags & flag) != 0U) {
+		if (K_TIMEOUT_EQ(*timeout, K_NO_WAIT)) {
+			return -EBUSY;
+		}
+
+		result = z_pend_curr(&msgq->lock, *key, &msgq->zc_wait_q,
+				     *timeout);
+		*key = k_spin_lock(&msgq->lock);
+		*timeout = sys_timepoint_timeout(end);
+		if (result != 0) {
+			return result;
+		}
+	}
+
+	return 0;
+}
+#else
+static inline bool handle_zc_waiters(struct k_msgq *msgq)
+{
+	ARG_UNUSED(msgq);
+
+	return false;
+}
+
+static inline bool msgq_has_zc_waiters(struct k_msgq *msgq)
+{
+	ARG_UNUSED(msgq);
+
+	return false;
+}
+
+static inline int wait_zc_flag_clear(struct k_msgq *msgq, uint8_t flag,
+				     k_spinlock_key_t *key,
+				     k_timeout_t *timeout)
+{
+	ARG_UNUSED(msgq);
+	ARG_UNUSED(flag);
+	ARG_UNUSED(key);
+	ARG_UNUSED(timeout);
+
+	return 0;
+}
+#endif /* CONFIG_MSGQ_ZERO_COPY */
+
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs)
 {
@@ -48,6 +123,10 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->used_msgs = 0;
 	msgq->flags = 0;
 	z_waitq_init(&msgq->wait_q);
+#ifdef CONFIG_MSGQ_ZERO_COPY
+	z_waitq_init(&msgq->zc_wait_q);
+	msgq->purged_msgs = 0;
+#endif
 	msgq->lock = (struct k_spinlock) {};
 #ifdef CONFIG_POLL
 	sys_dlist_init(&msgq->poll_events);
@@ -104,7 +183,8 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, cleanup, msgq);
 
-	CHECKIF(z_waitq_head(&msgq->wait_q) != NULL) {
+	CHECKIF((z_waitq_head(&msgq->wait_q) != NULL) ||
+		msgq_has_zc_waiters(msgq)) {
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, cleanup, msgq, -EBUSY);
 
 		return -EBUSY;
@@ -133,6 +213,14 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
 
+	/* the next slot may be reserved by k_msgq_reserve() */
+	result = wait_zc_flag_clear(msgq, K_MSGQ_FLAG_RESERVED, &key, &timeout);
+	if (result != 0) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+		k_spin_unlock(&msgq->lock, key);
+		return result;
+	}
+
 	if (msgq->used_msgs < msgq->max_msgs) {
 		/* message queue isn't full */
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
@@ -160,6 +248,11 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 #ifdef CONFIG_POLL
 			handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
 #endif /* CONFIG_POLL */
+			if (handle_zc_waiters(msgq)) {
+				SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, 0);
+				z_reschedule(&msgq->lock, key);
+				return 0;
+			}
 		}
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
@@ -225,6 +318,14 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
 
+	/* the first message may be claimed by k_msgq_claim() */
+	result = wait_zc_flag_clear(msgq, K_MSGQ_FLAG_CLAIMED, &key, &timeout);
+	if (result != 0) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+		k_spin_unlock(&msgq->lock, key);
+		return result;
+	}
+
 	if (msgq->used_msgs > 0U) {
 		/* take first available message from queue */
 		(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
@@ -259,6 +360,12 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 			return 0;
 		}
+
+		if (handle_zc_waiters(msgq)) {
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, 0);
+			z_reschedule(&msgq->lock, key);
+			return 0;
+		}
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		/* don't wait for a message to become available */
@@ -373,6 +480,217 @@ static inline int z_vrfy_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_
 #include <syscalls/k_msgq_peek_at_mrsh.c>
 #endif
 
+#ifdef CONFIG_MSGQ_ZERO_COPY
+int k_msgq_reserve(struct k_msgq *msgq, void **slot, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	/* Traced as the put it is the first half of */
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+
+	while (true) {
+		if (((msgq->flags & K_MSGQ_FLAG_RESERVED) == 0U) &&
+		    (msgq->used_msgs < msgq->max_msgs)) {
+			/* reserve the slot at the write pointer */
+			__ASSERT_NO_MSG(msgq->write_ptr >= msgq->buffer_start &&
+					msgq->write_ptr < msgq->buffer_end);
+			msgq->flags |= K_MSGQ_FLAG_RESERVED;
+			*slot = msgq->write_ptr;
+			result = 0;
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			/* don't wait for the reserved slot or message space */
+			result = ((msgq->flags & K_MSGQ_FLAG_RESERVED) != 0U) ?
+				 -EBUSY : -ENOMSG;
+			break;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
+
+		/* wait for a commit or a reader to free a slot, then check
+		 * again
+		 */
+		timeout = sys_timepoint_timeout(end);
+		result = z_pend_curr(&msgq->lock, key, &msgq->zc_wait_q,
+				     timeout);
+		key = k_spin_lock(&msgq->lock);
+		if (result != 0) {
+			break;
+		}
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int k_msgq_commit(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_RESERVED) == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~K_MSGQ_FLAG_RESERVED;
+
+	/* Only readers can be waiting, as writers wait for a full queue */
+	pending_thread = (z_waitq_head(&msgq->wait_q) != NULL) ?
+			 z_unpend_first_thread(&msgq->wait_q) : NULL;
+	if (pending_thread != NULL) {
+		/* give message to waiting thread, the slot stays free */
+		(void)memcpy(pending_thread->base.swap_data, msgq->write_ptr,
+			     msgq->msg_size);
+		/* wake up waiting thread */
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		/* and those waiting for the reservation to end */
+		(void)handle_zc_waiters(msgq);
+		z_reschedule(&msgq->lock, key);
+
+		return 0;
+	}
+
+	msgq->write_ptr += msgq->msg_size;
+	if (msgq->write_ptr == msgq->buffer_end) {
+		msgq->write_ptr = msgq->buffer_start;
+	}
+	msgq->used_msgs++;
+#ifdef CONFIG_POLL
+	handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+
+	if (handle_zc_waiters(msgq)) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
+int k_msgq_claim(struct k_msgq *msgq, void **msg, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	/* Traced as the get it is the first half of */
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+
+	while (true) {
+		if (((msgq->flags & K_MSGQ_FLAG_CLAIMED) == 0U) &&
+		    (msgq->used_msgs > 0U)) {
+			/* claim first available message in place */
+			msgq->flags |= K_MSGQ_FLAG_CLAIMED;
+			*msg = msgq->read_ptr;
+			result = 0;
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			/* don't wait for the claim to end or a message */
+			result = ((msgq->flags & K_MSGQ_FLAG_CLAIMED) != 0U) ?
+				 -EBUSY : -ENOMSG;
+			break;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
+
+		/* wait for a release or a writer to add a message, then check
+		 * again
+		 */
+		timeout = sys_timepoint_timeout(end);
+		result = z_pend_curr(&msgq->lock, key, &msgq->zc_wait_q,
+				     timeout);
+		key = k_spin_lock(&msgq->lock);
+		if (result != 0) {
+			break;
+		}
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int k_msgq_release(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t msgs;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_CLAIMED) == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+
+		return -EINVAL;
+	}
+
+	/* the claimed message, and the others if purged meanwhile */
+	msgs = MAX(msgq->purged_msgs, 1U);
+	msgq->purged_msgs = 0;
+
+	msgq->flags &= ~K_MSGQ_FLAG_CLAIMED;
+	msgq->read_ptr += msgs * msgq->msg_size;
+	if (msgq->read_ptr >= msgq->buffer_end) {
+		msgq->read_ptr -= msgq->buffer_end - msgq->buffer_start;
+	}
+	msgq->used_msgs -= msgs;
+
+	/* handle first thread waiting to write (if any) */
+	pending_thread = (z_waitq_head(&msgq->wait_q) != NULL) ?
+			 z_unpend_first_thread(&msgq->wait_q) : NULL;
+	if (pending_thread != NULL) {
+		/* add thread's message to queue */
+		__ASSERT_NO_MSG(msgq->write_ptr >= msgq->buffer_start &&
+				msgq->write_ptr < msgq->buffer_end);
+		(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
+		       msgq->msg_size);
+		msgq->write_ptr += msgq->msg_size;
+		if (msgq->write_ptr == msgq->buffer_end) {
+			msgq->write_ptr = msgq->buffer_start;
+		}
+		msgq->used_msgs++;
+
+		/* wake up waiting thread */
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		/* and those waiting for the claim to end */
+		(void)handle_zc_waiters(msgq);
+		z_reschedule(&msgq->lock, key);
+	} else if (handle_zc_waiters(msgq)) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_MSGQ_ZERO_COPY */
+
 void z_impl_k_msgq_purge(struct k_msgq *msgq)
 {
 	k_spinlock_key_t key;
@@ -387,6 +705,20 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 		arch_thread_return_value_set(pending_thread, -ENOMSG);
 		z_ready_thread(pending_thread);
 	}
+#ifdef CONFIG_MSGQ_ZERO_COPY
+	(void)z_sched_wake_all(&msgq->zc_wait_q, -ENOMSG, NULL);
+#endif
+
+#ifdef CONFIG_MSGQ_ZERO_COPY
+	if ((msgq->flags & K_MSGQ_FLAG_CLAIMED) != 0U) {
+		/* The claimer still reads the first message in place, drop
+		 * it and the messages behind it once it is released
+		 */
+		msgq->purged_msgs = msgq->used_msgs;
+		z_reschedule(&msgq->lock, key);
+		return;
+	}
+#endif
 
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
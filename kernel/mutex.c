@@ -24,6 +24,10 @@
  * When releasing the mutex, thread A must release M2 before it releases M1.
  * Failure to follow this nested model may result in threads running at
  * unexpected priority levels (too high, or too low).
+ *
+ * Inheritance is transitive: when the owner of the mutex is itself waiting
+ * on a mutex, the boost is passed on to that mutex's owner, and so on, for
+ * up to CONFIG_PRIORITY_INHERITANCE_DEPTH mutexes.
  */
 
 #include <zephyr/kernel.h>
@@ -44,17 +48,186 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
  * is protecting things like owner thread priorities which aren't
  * "part of" a single k_mutex.  Should move those bits of the API
  * under the scheduler lock so we can break this up.
+ *
+ * With CONFIG_SYNC_FAST_PATH, locking a free mutex, or re-locking one
+ * the caller already owns, doesn't need the lock: the owner field is
+ * claimed with an atomic compare-and-swap from NULL, and lock_count is
+ * only touched by the owner.  Everything that can make the owner NULL
+ * again (the unlock without waiters) holds the lock, so code under the
+ * lock that finds a non-NULL owner can rely on it staying that way.
+ *
+ * owner_orig_prio is read under the lock by other threads, and such a
+ * thread may boost a new owner before the owner got to record it.  It
+ * is therefore unset while the mutex is free, and whoever comes first
+ * records it: the new owner with the priority it had when it claimed
+ * the mutex, or the lock holder with the owner's priority before it
+ * boosts it (see mutex_orig_prio()).
+ *
+ * The contention statistics are only updated under the lock, so with
+ * CONFIG_OBJ_CORE_STATS_MUTEX locking always takes it.
  */
 static struct k_spinlock lock;
 
+#ifdef CONFIG_SYNC_FAST_PATH
+/* Make the current thread the owner of a free mutex */
+static inline bool owner_claim(struct k_mutex *mutex)
+{
+	int32_t prio = _current->base.prio;
+
+	if (!atomic_ptr_cas((atomic_ptr_t *)&mutex->owner, NULL, _current)) {
+		return false;
+	}
+
+	/* Unless a lock holder recorded it first */
+	(void)atomic_cas(&mutex->owner_orig_prio, Z_MUTEX_ORIG_PRIO_UNSET, prio);
+
+	return true;
+}
+
+/* Free the mutex, with the lock held */
+static inline void owner_release(struct k_mutex *mutex)
+{
+	atomic_set(&mutex->owner_orig_prio, Z_MUTEX_ORIG_PRIO_UNSET);
+
+	/* Last: from here on owner_claim() may succeed */
+	(void)atomic_ptr_set((atomic_ptr_t *)&mutex->owner, NULL);
+}
+
+static inline int32_t orig_prio_get(struct k_mutex *mutex)
+{
+	return (int32_t)atomic_get(&mutex->owner_orig_prio);
+}
+
+static inline void orig_prio_set(struct k_mutex *mutex, int32_t prio)
+{
+	atomic_set(&mutex->owner_orig_prio, prio);
+}
+#else
+/* Without the fast path these are only called with the lock held */
+static inline bool owner_claim(struct k_mutex *mutex)
+{
+	if (mutex->owner != NULL) {
+		return false;
+	}
+
+	mutex->owner = _current;
+	mutex->owner_orig_prio = _current->base.prio;
+
+	return true;
+}
+
+static inline void owner_release(struct k_mutex *mutex)
+{
+	mutex->owner = NULL;
+}
+
+static inline int32_t orig_prio_get(struct k_mutex *mutex)
+{
+	return mutex->owner_orig_prio;
+}
+
+static inline void orig_prio_set(struct k_mutex *mutex, int32_t prio)
+{
+	mutex->owner_orig_prio = prio;
+}
+#endif
+
 #ifdef CONFIG_OBJ_CORE_MUTEX
 static struct k_obj_type obj_type_mutex;
+
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+static int k_mutex_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_mutex    *mutex;
+	k_spinlock_key_t   key;
+
+	mutex = CONTAINER_OF(obj_core, struct k_mutex, obj_core);
+	key = k_spin_lock(&lock);
+	memcpy(stats, &mutex->stats, sizeof(mutex->stats));
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static int k_mutex_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_mutex    *mutex;
+	k_spinlock_key_t   key;
+
+	mutex = CONTAINER_OF(obj_core, struct k_mutex, obj_core);
+	key = k_spin_lock(&lock);
+	mutex->stats = (struct k_mutex_stats){};
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc mutex_stats_desc = {
+	.raw_size = sizeof(struct k_mutex_stats),
+	.query_size = sizeof(struct k_mutex_stats),
+	.raw   = k_mutex_stats_raw,
+	.query = k_mutex_stats_raw,
+	.reset = k_mutex_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+#endif
 #endif
 
+/* A thread just became the owner of the mutex */
+static inline void mutex_stats_taken(struct k_mutex *mutex)
+{
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	mutex->stats.locks++;
+	mutex->hold_start = k_cycle_get_32();
+#else
+	ARG_UNUSED(mutex);
+#endif
+}
+
+/* The owner is about to release the mutex, with the lock held */
+static inline void mutex_stats_released(struct k_mutex *mutex)
+{
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	uint32_t held = k_cycle_get_32() - mutex->hold_start;
+
+	mutex->stats.hold_total += held;
+	mutex->stats.hold_max = MAX(mutex->stats.hold_max, held);
+#else
+	ARG_UNUSED(mutex);
+#endif
+}
+
+/* A wait that started at [start] ended, with the lock held */
+static inline void mutex_stats_waited(struct k_mutex *mutex, uint32_t start,
+				      bool timed_out)
+{
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	uint32_t waited = k_cycle_get_32() - start;
+
+	mutex->stats.wait_total += waited;
+	mutex->stats.wait_max = MAX(mutex->stats.wait_max, waited);
+	if (timed_out) {
+		mutex->stats.timeouts++;
+	}
+#else
+	ARG_UNUSED(mutex);
+	ARG_UNUSED(start);
+	ARG_UNUSED(timed_out);
+#endif
+}
+
 int z_impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
 	mutex->lock_count = 0U;
+#ifdef CONFIG_SYNC_FAST_PATH
+	atomic_set(&mutex->owner_orig_prio, Z_MUTEX_ORIG_PRIO_UNSET);
+#endif
 
 	z_waitq_init(&mutex->wait_q);
 
@@ -64,6 +237,12 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 	k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
 #endif
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	mutex->stats = (struct k_mutex_stats){};
+	k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->stats,
+				  sizeof(struct k_mutex_stats));
+#endif
+
 	SYS_PORT_TRACING_OBJ_INIT(k_mutex, mutex, 0);
 
 	return 0;
@@ -101,31 +280,149 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
-int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+/* The priority the owner of the mutex had before it was boosted, with the
+ * lock held.  With the fast path, records it if the owner has not got to
+ * it yet.
+ */
+static int32_t mutex_orig_prio(struct k_mutex *mutex)
+{
+#ifdef CONFIG_SYNC_FAST_PATH
+	(void)atomic_cas(&mutex->owner_orig_prio, Z_MUTEX_ORIG_PRIO_UNSET,
+			 mutex->owner->base.prio);
+#endif
+
+	return orig_prio_get(mutex);
+}
+
+/* The mutex the owner of @a mutex is waiting for, if any */
+static inline struct k_mutex *owner_pended_mutex(struct k_mutex *mutex)
+{
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+	return mutex->owner->pended_mutex;
+#else
+	ARG_UNUSED(mutex);
+	return NULL;
+#endif
+}
+
+static inline void set_pended_mutex(struct k_thread *thread,
+				    struct k_mutex *mutex)
+{
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+	thread->pended_mutex = mutex;
+#else
+	ARG_UNUSED(thread);
+	ARG_UNUSED(mutex);
+#endif
+}
+
+/* Boost the owner of the mutex to at least [prio], and the owners of the
+ * mutexes it waits for in turn.  Stops at the first owner that already
+ * runs at that priority or higher, and at a mutex that was released after
+ * its waiter timed out.
+ */
+static bool boost_owner_chain(struct k_mutex *mutex, int32_t prio)
 {
-	int new_prio;
-	k_spinlock_key_t key;
 	bool resched = false;
 
-	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+	for (int depth = 0; (mutex != NULL) && (mutex->owner != NULL) &&
+	     (depth < CONFIG_PRIORITY_INHERITANCE_DEPTH); depth++) {
+		int32_t new_prio;
 
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
+		(void)mutex_orig_prio(mutex);
+		new_prio = new_prio_for_inheritance(prio,
+						    mutex->owner->base.prio);
 
-	key = k_spin_lock(&lock);
+		if (!z_is_prio_higher(new_prio, mutex->owner->base.prio)) {
+			break;
+		}
 
-	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+		LOG_DBG("adjusting prio up on mutex %p", mutex);
 
-		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
-					_current->base.prio :
-					mutex->owner_orig_prio;
+		resched = adjust_owner_prio(mutex, new_prio) || resched;
+		prio = new_prio;
+		mutex = owner_pended_mutex(mutex);
+	}
+
+	return resched;
+}
+
+/* Drop the owner of the mutex back to the priority it is owed by the
+ * remaining waiters, and the owners of the mutexes it waits for in turn.
+ * Stops at the first owner that does not lose priority, and at a mutex
+ * that was released after its waiter timed out.
+ */
+static bool restore_owner_chain(struct k_mutex *mutex)
+{
+	bool resched = false;
+
+	for (int depth = 0; (mutex != NULL) && (mutex->owner != NULL) &&
+	     (depth < CONFIG_PRIORITY_INHERITANCE_DEPTH); depth++) {
+		struct k_thread *waiter = z_waitq_head(&mutex->wait_q);
+		int32_t orig_prio = mutex_orig_prio(mutex);
+		int32_t new_prio = (waiter != NULL) ?
+			new_prio_for_inheritance(waiter->base.prio,
+						 orig_prio) :
+			orig_prio;
+
+		if (!z_is_prio_higher(mutex->owner->base.prio, new_prio)) {
+			break;
+		}
+
+		LOG_DBG("adjusting prio down on mutex %p", mutex);
+
+		resched = adjust_owner_prio(mutex, new_prio) || resched;
+		mutex = owner_pended_mutex(mutex);
+	}
+
+	return resched;
+}
 
+/* Take the mutex if it is free or already ours, with the lock held
+ * unless CONFIG_SYNC_FAST_PATH is enabled
+ */
+static inline bool mutex_claim(struct k_mutex *mutex)
+{
+	if (owner_claim(mutex)) {
+		mutex->lock_count = 1U;
+		mutex_stats_taken(mutex);
+	} else if (mutex->owner == _current) {
 		mutex->lock_count++;
-		mutex->owner = _current;
+	} else {
+		return false;
+	}
+
+	LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
+		_current, mutex, mutex->lock_count,
+		(int)orig_prio_get(mutex));
 
-		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
-			_current, mutex, mutex->lock_count,
-			mutex->owner_orig_prio);
+	return true;
+}
+
+int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	bool resched;
+	uint32_t wait_start = 0U;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
+
+	if (IS_ENABLED(CONFIG_SYNC_FAST_PATH) &&
+	    !IS_ENABLED(CONFIG_OBJ_CORE_STATS_MUTEX) &&
+	    likely(mutex_claim(mutex))) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
+
+		return 0;
+	}
 
+	key = k_spin_lock(&lock);
+
+	/* With the fast path it may have been released while we took the
+	 * lock
+	 */
+	if (likely(mutex_claim(mutex))) {
 		k_spin_unlock(&lock, key);
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
@@ -143,14 +440,14 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
 
-	new_prio = new_prio_for_inheritance(_current->base.prio,
-					    mutex->owner->base.prio);
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	mutex->stats.contended++;
+	mutex->stats.contended_owner = mutex->owner;
+	wait_start = k_cycle_get_32();
+#endif
 
-	LOG_DBG("adjusting prio up on mutex %p", mutex);
-
-	if (z_is_prio_higher(new_prio, mutex->owner->base.prio)) {
-		resched = adjust_owner_prio(mutex, new_prio);
-	}
+	resched = boost_owner_chain(mutex, _current->base.prio);
+	set_pended_mutex(_current, mutex);
 
 	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
 
@@ -160,6 +457,12 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		got_mutex ? 'y' : 'n');
 
 	if (got_mutex == 0) {
+		if (IS_ENABLED(CONFIG_OBJ_CORE_STATS_MUTEX)) {
+			key = k_spin_lock(&lock);
+			mutex_stats_waited(mutex, wait_start, false);
+			k_spin_unlock(&lock, key);
+		}
+
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 		return 0;
 	}
@@ -170,20 +473,14 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
+	mutex_stats_waited(mutex, wait_start, true);
+
 	/*
 	 * Check if mutex was unlocked after this thread was unpended.
 	 * If so, skip adjusting owner's priority down.
 	 */
 	if (likely(mutex->owner != NULL)) {
-		struct k_thread *waiter = z_waitq_head(&mutex->wait_q);
-
-		new_prio = (waiter != NULL) ?
-			new_prio_for_inheritance(waiter->base.prio, mutex->owner_orig_prio) :
-			mutex->owner_orig_prio;
-
-		LOG_DBG("adjusting prio down on mutex %p", mutex);
-
-		resched = adjust_owner_prio(mutex, new_prio) || resched;
+		resched = restore_owner_chain(mutex) || resched;
 	}
 
 	if (resched) {
@@ -251,13 +548,13 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	adjust_owner_prio(mutex, mutex->owner_orig_prio);
+	mutex_stats_released(mutex);
+	/* Recorded by now, we are past our own mutex_claim() */
+	adjust_owner_prio(mutex, orig_prio_get(mutex));
 
 	/* Get the new owner, if any */
 	new_owner = z_unpend_first_thread(&mutex->wait_q);
 
-	mutex->owner = new_owner;
-
 	LOG_DBG("new owner of mutex %p: %p (prio: %d)",
 		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
 
@@ -267,12 +564,15 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 		 * waiter since the wait queue is priority-based: no need to
 		 * adjust its priority
 		 */
-		mutex->owner_orig_prio = new_owner->base.prio;
+		mutex->owner = new_owner;
+		orig_prio_set(mutex, new_owner->base.prio);
+		mutex_stats_taken(mutex);
 		arch_thread_return_value_set(new_owner, 0);
 		z_ready_thread(new_owner);
 		z_reschedule(&lock, key);
 	} else {
 		mutex->lock_count = 0U;
+		owner_release(mutex);
 		k_spin_unlock(&lock, key);
 	}
 
@@ -301,10 +601,18 @@ static int init_mutex_obj_core_list(void)
 	z_obj_type_init(&obj_type_mutex, K_OBJ_TYPE_MUTEX_ID,
 			offsetof(struct k_mutex, obj_core));
 
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	k_obj_type_stats_init(&obj_type_mutex, &mutex_stats_desc);
+#endif
+
 	/* Initialize and link statically defined mutexs */
 
 	STRUCT_SECTION_FOREACH(k_mutex, mutex) {
 		k_obj_core_init_and_link(K_OBJ_CORE(mutex), &obj_type_mutex);
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+		k_obj_core_stats_register(K_OBJ_CORE(mutex), &mutex->stats,
+					  sizeof(struct k_mutex_stats));
+#endif
 	}
 
 	return 0;
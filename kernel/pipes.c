@@ -20,6 +20,7 @@
 #include <zephyr/internal/syscall_handler.h>
 #include <kernel_internal.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/math_extras.h>
 
 struct waitq_walk_data {
 	sys_dlist_t *list;
@@ -28,13 +29,71 @@ struct waitq_walk_data {
 };
 
 static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
-			     void *data, size_t bytes_to_read,
-			     size_t *bytes_read, size_t min_xfer,
-			     k_timeout_t timeout);
+			     const struct k_pipe_iovec *iov,
+			     size_t bytes_to_read, size_t *bytes_read,
+			     size_t min_xfer, k_timeout_t timeout);
 #ifdef CONFIG_OBJ_CORE_PIPE
 static struct k_obj_type obj_type_pipe;
+
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+static int k_pipe_stats_raw(struct k_obj_core *obj_core, void *stats)
+{
+	__ASSERT((obj_core != NULL) && (stats != NULL), "NULL parameter");
+
+	struct k_pipe     *pipe;
+	k_spinlock_key_t   key;
+
+	pipe = CONTAINER_OF(obj_core, struct k_pipe, obj_core);
+	key = k_spin_lock(&pipe->lock);
+	memcpy(stats, &pipe->stats, sizeof(pipe->stats));
+	k_spin_unlock(&pipe->lock, key);
+
+	return 0;
+}
+
+static int k_pipe_stats_reset(struct k_obj_core *obj_core)
+{
+	__ASSERT(obj_core != NULL, "NULL parameter");
+
+	struct k_pipe     *pipe;
+	k_spinlock_key_t   key;
+
+	pipe = CONTAINER_OF(obj_core, struct k_pipe, obj_core);
+	key = k_spin_lock(&pipe->lock);
+	pipe->stats = (struct k_pipe_stats){};
+	k_spin_unlock(&pipe->lock, key);
+
+	return 0;
+}
+
+static struct k_obj_core_stats_desc pipe_stats_desc = {
+	.raw_size = sizeof(struct k_pipe_stats),
+	.query_size = sizeof(struct k_pipe_stats),
+	.raw   = k_pipe_stats_raw,
+	.query = k_pipe_stats_raw,
+	.reset = k_pipe_stats_reset,
+	.disable = NULL,
+	.enable = NULL,
+};
+#endif
 #endif
 
+static inline void pipe_stats_add(struct k_pipe *pipe, bool direct,
+				  size_t bytes)
+{
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+	if (direct) {
+		pipe->stats.direct_bytes += bytes;
+	} else {
+		pipe->stats.buffered_bytes += bytes;
+	}
+#else
+	ARG_UNUSED(pipe);
+	ARG_UNUSED(direct);
+	ARG_UNUSED(bytes);
+#endif
+}
+
 
 void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 {
@@ -58,6 +117,11 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 #ifdef CONFIG_OBJ_CORE_PIPE
 	k_obj_core_init_and_link(K_OBJ_CORE(pipe), &obj_type_pipe);
 #endif
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+	pipe->stats = (struct k_pipe_stats){};
+	k_obj_core_stats_register(K_OBJ_CORE(pipe), &pipe->stats,
+				  sizeof(struct k_pipe_stats));
+#endif
 }
 
 int z_impl_k_pipe_alloc_init(struct k_pipe *pipe, size_t size)
@@ -113,8 +177,10 @@ void z_impl_k_pipe_flush(struct k_pipe *pipe)
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
-	(void) pipe_get_internal(key, pipe, NULL, (size_t) -1, &bytes_read, 0U,
-				 K_NO_WAIT);
+	struct k_pipe_iovec discard = { NULL, (size_t) -1 };
+
+	(void) pipe_get_internal(key, pipe, &discard, discard.iov_len,
+				 &bytes_read, 0U, K_NO_WAIT);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, flush, pipe);
 }
@@ -138,7 +204,9 @@ void z_impl_k_pipe_buffer_flush(struct k_pipe *pipe)
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
 	if (pipe->buffer != NULL) {
-		(void) pipe_get_internal(key, pipe, NULL, pipe->size,
+		struct k_pipe_iovec discard = { NULL, pipe->size };
+
+		(void) pipe_get_internal(key, pipe, &discard, discard.iov_len,
 					 &bytes_read, 0U, K_NO_WAIT);
 	} else {
 		k_spin_unlock(&pipe->lock, key);
@@ -214,6 +282,65 @@ static size_t pipe_xfer(unsigned char *dest, size_t dest_size,
 	return num_bytes;
 }
 
+/**
+ * @brief Add up the lengths of the segments in @a iov
+ *
+ * @return true if the total does not fit in a size_t
+ */
+static bool pipe_iov_len(const struct k_pipe_iovec *iov, size_t iovcnt,
+			 size_t *total)
+{
+	*total = 0U;
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		if (size_add_overflow(*total, iov[i].iov_len, total)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief Set up a descriptor for transferring the @a total bytes of the
+ * segments in @a iov
+ */
+static void pipe_desc_init(struct _pipe_desc *desc,
+			   const struct k_pipe_iovec *iov, size_t total)
+{
+	desc->buffer = NULL;
+	desc->seg_left = 0U;
+	desc->bytes_to_xfer = total;
+	desc->iov = iov;
+
+	/* Move on to the first non-empty segment */
+	while ((desc->seg_left == 0U) && (desc->bytes_to_xfer != 0U)) {
+		desc->buffer = desc->iov->iov_base;
+		desc->seg_left = desc->iov->iov_len;
+		desc->iov++;
+	}
+}
+
+/**
+ * @brief Account for @a bytes transferred to/from a descriptor
+ *
+ * Moves on to the next non-empty segment once the current one is done.
+ */
+static void pipe_desc_advance(struct _pipe_desc *desc, size_t bytes)
+{
+	desc->bytes_to_xfer -= bytes;
+	desc->seg_left -= bytes;
+	if (desc->buffer != NULL) {
+		desc->buffer += bytes;
+	}
+
+	while ((desc->seg_left == 0U) && (desc->bytes_to_xfer != 0U)) {
+		desc->buffer = desc->iov->iov_base;
+		desc->seg_left = desc->iov->iov_len;
+		desc->iov++;
+	}
+}
+
 /**
  * @brief Callback routine used to populate wait list
  *
@@ -276,17 +403,22 @@ static size_t pipe_buffer_list_populate(sys_dlist_t         *list,
 
 	desc[0].thread = NULL;
 	desc[0].buffer = &buffer[start];
+	desc[0].iov = NULL;
 
 	if (start < end) {
 		desc[0].bytes_to_xfer = end - start;
+		desc[0].seg_left = end - start;
 		return end - start;
 	}
 
 	desc[0].bytes_to_xfer = size - start;
+	desc[0].seg_left = size - start;
 
 	desc[1].thread = NULL;
 	desc[1].buffer = &buffer[0];
 	desc[1].bytes_to_xfer = end;
+	desc[1].seg_left = end;
+	desc[1].iov = NULL;
 
 	sys_dlist_append(list, &desc[1].node);
 
@@ -335,16 +467,14 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 	dest = (struct _pipe_desc *)sys_dlist_get(dest_list);
 
 	while ((src != NULL) && (dest != NULL)) {
-		bytes_copied = pipe_xfer(dest->buffer, dest->bytes_to_xfer,
-					 src->buffer, src->bytes_to_xfer);
+		bytes_copied = pipe_xfer(dest->buffer, dest->seg_left,
+					 src->buffer, src->seg_left);
 
 		num_bytes_written   += bytes_copied;
 
-		dest->buffer        += bytes_copied;
-		dest->bytes_to_xfer -= bytes_copied;
-
-		src->buffer         += bytes_copied;
-		src->bytes_to_xfer  -= bytes_copied;
+		pipe_desc_advance(dest, bytes_copied);
+		pipe_desc_advance(src, bytes_copied);
+		pipe_stats_add(pipe, dest->thread != NULL, bytes_copied);
 
 		if (dest->thread == NULL) {
 
@@ -377,9 +507,10 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 	return num_bytes_written;
 }
 
-int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
-		     size_t *bytes_written, size_t min_xfer,
-		      k_timeout_t timeout)
+static int pipe_put_internal(struct k_pipe *pipe,
+			     const struct k_pipe_iovec *iov,
+			     size_t bytes_to_write, size_t *bytes_written,
+			     size_t min_xfer, k_timeout_t timeout)
 {
 	struct _pipe_desc  pipe_desc[2];
 	struct _pipe_desc  isr_desc;
@@ -406,6 +537,16 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	/*
+	 * Do not use the pipe descriptor stored within k_thread if
+	 * invoked from within an ISR as that is not safe to do.
+	 */
+
+	src_desc = k_is_in_isr() ? &isr_desc : &_current->pipe_desc;
+
+	pipe_desc_init(src_desc, iov, bytes_to_write);
+	src_desc->thread = _current;
+
 	/*
 	 * First, write to any waiting readers, if any exist.
 	 * Second, write to the pipe buffer, if it exists.
@@ -438,16 +579,6 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 		return -EIO;
 	}
 
-	/*
-	 * Do not use the pipe descriptor stored within k_thread if
-	 * invoked from within an ISR as that is not safe to do.
-	 */
-
-	src_desc = k_is_in_isr() ? &isr_desc : &_current->pipe_desc;
-
-	src_desc->buffer        = data;
-	src_desc->bytes_to_xfer = bytes_to_write;
-	src_desc->thread        = _current;
 	sys_dlist_append(&src_list, &src_desc->node);
 
 	*bytes_written = pipe_write(pipe, &src_list,
@@ -512,6 +643,34 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 	return ret;
 }
 
+int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
+		     size_t *bytes_written, size_t min_xfer,
+		      k_timeout_t timeout)
+{
+	struct k_pipe_iovec iov = { data, bytes_to_write };
+
+	return pipe_put_internal(pipe, &iov, bytes_to_write, bytes_written,
+				 min_xfer, timeout);
+}
+
+int k_pipe_putv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		size_t iovcnt, size_t *bytes_written, size_t min_xfer,
+		k_timeout_t timeout)
+{
+	size_t bytes_to_write;
+
+	CHECKIF((iov == NULL) && (iovcnt != 0U)) {
+		return -EINVAL;
+	}
+
+	CHECKIF(pipe_iov_len(iov, iovcnt, &bytes_to_write)) {
+		return -EINVAL;
+	}
+
+	return pipe_put_internal(pipe, iov, bytes_to_write, bytes_written,
+				 min_xfer, timeout);
+}
+
 #ifdef CONFIG_USERSPACE
 int z_vrfy_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 		     size_t *bytes_written, size_t min_xfer,
@@ -529,9 +688,9 @@ int z_vrfy_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 #endif
 
 static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
-			     void *data, size_t bytes_to_read,
-			     size_t *bytes_read, size_t min_xfer,
-			     k_timeout_t timeout)
+			     const struct k_pipe_iovec *iov,
+			     size_t bytes_to_read, size_t *bytes_read,
+			     size_t min_xfer, k_timeout_t timeout)
 {
 	sys_dlist_t         src_list;
 	struct _pipe_desc   pipe_desc[2];
@@ -543,6 +702,16 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 	size_t         bytes_can_read = 0U;
 	bool           reschedule_needed = false;
 
+	/*
+	 * Do not use the pipe descriptor stored within k_thread if
+	 * invoked from within an ISR as that is not safe to do.
+	 */
+
+	dest_desc = k_is_in_isr() ? &isr_desc : &_current->pipe_desc;
+
+	pipe_desc_init(dest_desc, iov, bytes_to_read);
+	dest_desc->thread = _current;
+
 	/*
 	 * Data copying takes place in the following order.
 	 * 1. Copy data from the pipe buffer to the receive buffer.
@@ -576,33 +745,17 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 		return -EIO;
 	}
 
-	/*
-	 * Do not use the pipe descriptor stored within k_thread if
-	 * invoked from within an ISR as that is not safe to do.
-	 */
-
-	dest_desc = k_is_in_isr() ? &isr_desc : &_current->pipe_desc;
-
-	dest_desc->buffer = data;
-	dest_desc->bytes_to_xfer = bytes_to_read;
-	dest_desc->thread = _current;
-
 	src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
 	while (src_desc != NULL) {
 		bytes_copied = pipe_xfer(dest_desc->buffer,
-					  dest_desc->bytes_to_xfer,
+					  dest_desc->seg_left,
 					  src_desc->buffer,
-					  src_desc->bytes_to_xfer);
+					  src_desc->seg_left);
 
 		num_bytes_read += bytes_copied;
 
-		src_desc->buffer += bytes_copied;
-		src_desc->bytes_to_xfer -= bytes_copied;
-
-		if (dest_desc->buffer != NULL) {
-			dest_desc->buffer += bytes_copied;
-		}
-		dest_desc->bytes_to_xfer -= bytes_copied;
+		pipe_desc_advance(src_desc, bytes_copied);
+		pipe_desc_advance(dest_desc, bytes_copied);
 
 		if (src_desc->thread == NULL) {
 
@@ -613,16 +766,25 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 			if (pipe->read_index >= pipe->size) {
 				pipe->read_index -= pipe->size;
 			}
-		} else if (src_desc->bytes_to_xfer == 0U) {
+		} else {
+			pipe_stats_add(pipe, true, bytes_copied);
 
-			/* The thread's write request has been satisfied. */
+			if (src_desc->bytes_to_xfer == 0U) {
 
-			z_unpend_thread(src_desc->thread);
-			z_ready_thread(src_desc->thread);
+				/* The thread's write request has been satisfied. */
 
-			reschedule_needed = true;
+				z_unpend_thread(src_desc->thread);
+				z_ready_thread(src_desc->thread);
+
+				reschedule_needed = true;
+			}
+		}
+
+		/* Either side may span several segments */
+		if ((src_desc->bytes_to_xfer == 0U) ||
+		    (dest_desc->bytes_to_xfer == 0U)) {
+			src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
 		}
-		src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
 	}
 
 	if (pipe->bytes_used != pipe->size) {
@@ -696,8 +858,9 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 	return ret;
 }
 
-int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
-		     size_t *bytes_read, size_t min_xfer, k_timeout_t timeout)
+static int pipe_get(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		    size_t bytes_to_read, size_t *bytes_read,
+		    size_t min_xfer, k_timeout_t timeout)
 {
 	__ASSERT(((arch_is_in_isr() == false) ||
 		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
@@ -713,14 +876,41 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
-	int ret = pipe_get_internal(key, pipe, data, bytes_to_read, bytes_read,
-				    min_xfer, timeout);
+	int ret = pipe_get_internal(key, pipe, iov, bytes_to_read,
+				    bytes_read, min_xfer, timeout);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get, pipe, timeout, ret);
 
 	return ret;
 }
 
+int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
+		     size_t *bytes_read, size_t min_xfer, k_timeout_t timeout)
+{
+	struct k_pipe_iovec iov = { data, bytes_to_read };
+
+	return pipe_get(pipe, &iov, bytes_to_read, bytes_read, min_xfer,
+			timeout);
+}
+
+int k_pipe_getv(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		size_t iovcnt, size_t *bytes_read, size_t min_xfer,
+		k_timeout_t timeout)
+{
+	size_t bytes_to_read;
+
+	CHECKIF((iov == NULL) && (iovcnt != 0U)) {
+		return -EINVAL;
+	}
+
+	CHECKIF(pipe_iov_len(iov, iovcnt, &bytes_to_read)) {
+		return -EINVAL;
+	}
+
+	return pipe_get(pipe, iov, bytes_to_read, bytes_read,
+			min_xfer, timeout);
+}
+
 #ifdef CONFIG_USERSPACE
 int z_vrfy_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 		      size_t *bytes_read, size_t min_xfer, k_timeout_t timeout)
@@ -818,10 +1008,18 @@ static int init_pipe_obj_core_list(void)
 	z_obj_type_init(&obj_type_pipe, K_OBJ_TYPE_PIPE_ID,
 			offsetof(struct k_pipe, obj_core));
 
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+	k_obj_type_stats_init(&obj_type_pipe, &pipe_stats_desc);
+#endif
+
 	/* Initialize and link statically defined pipes */
 
 	STRUCT_SECTION_FOREACH(k_pipe, pipe) {
 		k_obj_core_init_and_link(K_OBJ_CORE(pipe), &obj_type_pipe);
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+		k_obj_core_stats_register(K_OBJ_CORE(pipe), &pipe->stats,
+					  sizeof(struct k_pipe_stats));
+#endif
 	}
 
 	return 0;
@@ -35,10 +35,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET = Z_POLL_SET_MODE };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static int signal_poll_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -109,22 +110,37 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+/* Events of poll sets have no thread to rank them by: they go behind the
+ * events of all polling threads, in the order they were registered.
+ */
+static inline bool poller_outranks(struct z_poller *poller,
+				   struct k_poll_event *pending)
+{
+	if (pending->poller->mode == MODE_SET) {
+		return poller->mode != MODE_SET;
+	}
+
+	if (poller->mode == MODE_SET) {
+		return false;
+	}
+
+	return z_sched_prio_cmp(poller_thread(poller),
+				poller_thread(pending->poller)) > 0;
+}
+
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
 	struct k_poll_event *pending;
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+	if ((pending == NULL) || !poller_outranks(poller, pending)) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if (poller_outranks(poller, pending)) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -443,6 +459,10 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	struct z_poller *poller = event->poller;
 	int retcode = 0;
 
+	if ((poller != NULL) && (poller->mode == MODE_SET)) {
+		return signal_poll_set(event, state);
+	}
+
 	if (poller != NULL) {
 		if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
@@ -477,6 +497,182 @@ void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 	k_spin_unlock(&lock, key);
 }
 
+static inline struct k_poll_set *poller_set(struct z_poller *p)
+{
+	return CONTAINER_OF(p, struct k_poll_set, poller);
+}
+
+/* must be called with interrupts locked */
+static void poll_set_make_ready(struct k_poll_set *set,
+				struct k_poll_event *event)
+{
+	struct k_thread *thread;
+
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+}
+
+/* must be called with interrupts locked */
+static int signal_poll_set(struct k_poll_event *event, uint32_t state)
+{
+	/* The object already unlinked the event: it stays in the set, and
+	 * only moves over to the ready list.
+	 */
+	event->state = state;
+	poll_set_make_ready(poller_set(event->poller), event);
+
+	return 0;
+}
+
+/* must be called with interrupts locked */
+static int poll_set_collect(struct k_poll_set *set, struct k_poll_event **ready,
+			    int max_events)
+{
+	sys_dlist_t reported = SYS_DLIST_STATIC_INIT(&reported);
+	struct k_poll_event *event;
+	sys_dnode_t *node;
+	int num_ready = 0;
+
+	while (num_ready < max_events) {
+		uint32_t state = 0U;
+		bool met;
+
+		node = sys_dlist_get(&set->ready);
+		if (node == NULL) {
+			break;
+		}
+		event = CONTAINER_OF(node, struct k_poll_event, _node);
+
+		/* The object may have been taken since it signaled */
+		met = is_condition_met(event, &state);
+		state |= event->state & K_POLL_STATE_CANCELLED;
+		event->state = state;
+
+		if (state != K_POLL_STATE_NOT_READY) {
+			ready[num_ready++] = event;
+		}
+
+		/* Keep events that are still ready at hand, so they are checked
+		 * again by the next wait for as long as they stay ready.
+		 */
+		if (met) {
+			sys_dlist_append(&reported, &event->_node);
+		} else {
+			register_event(event, &set->poller);
+		}
+	}
+
+	while ((node = sys_dlist_get(&reported)) != NULL) {
+		sys_dlist_append(&set->ready, node);
+	}
+
+	return num_ready;
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	sys_dlist_init(&set->ready);
+	z_waitq_init(&set->wait_q);
+	set->poller.is_polling = false;
+	set->poller.mode = MODE_SET;
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key;
+	uint32_t state;
+
+	__ASSERT(!arch_is_in_isr(), "");
+
+	if (event->type == K_POLL_TYPE_IGNORE) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (event->poller != NULL) {
+		k_spin_unlock(&lock, key);
+
+		return -EBUSY;
+	}
+
+	event->state = K_POLL_STATE_NOT_READY;
+	if (is_condition_met(event, &state)) {
+		event->poller = &set->poller;
+		poll_set_make_ready(set, event);
+	} else {
+		register_event(event, &set->poller);
+	}
+
+	z_reschedule(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (event->poller != &set->poller) {
+		k_spin_unlock(&lock, key);
+
+		return -EINVAL;
+	}
+
+	/* The event is either registered with its object or ready */
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+	event->poller = NULL;
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **ready,
+		    int max_events, k_timeout_t timeout)
+{
+	k_timepoint_t end = sys_timepoint_calc(timeout);
+	k_spinlock_key_t key;
+	int num_ready;
+
+	__ASSERT(!arch_is_in_isr(), "");
+
+	if (max_events <= 0) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	/* Another waiter may get to the ready events first, so wait again
+	 * until there is something to return or the timeout expires.
+	 */
+	while ((num_ready = poll_set_collect(set, ready, max_events)) == 0) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+
+			return -EAGAIN;
+		}
+
+		if (z_pend_curr(&lock, key, &set->wait_q, timeout) == -EAGAIN) {
+			return -EAGAIN;
+		}
+
+		timeout = sys_timepoint_timeout(end);
+		key = k_spin_lock(&lock);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return num_ready;
+}
+
 void z_impl_k_poll_signal_init(struct k_poll_signal *sig)
 {
 	sys_dlist_init(&sig->poll_events);
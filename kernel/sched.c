@@ -22,7 +22,7 @@
 
 LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 
-#if defined(CONFIG_SCHED_DUMB)
+#if defined(CONFIG_SCHED_DUMB) || defined(CONFIG_SCHED_WORK_STEALING)
 #define _priq_run_add		z_priq_dumb_add
 #define _priq_run_remove	z_priq_dumb_remove
 # if defined(CONFIG_SCHED_CPU_MASK)
@@ -38,6 +38,9 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 #define _priq_run_add		z_priq_mq_add
 #define _priq_run_remove	z_priq_mq_remove
 #define _priq_run_best		z_priq_mq_best
+#endif
+
+#if defined(CONFIG_SCHED_MULTIQ) || defined(CONFIG_WAITQ_MULTIQ)
 static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 					struct k_thread *thread);
 static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
@@ -48,6 +51,10 @@ static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
 #define z_priq_wait_add		z_priq_rb_add
 #define _priq_wait_remove	z_priq_rb_remove
 #define _priq_wait_best		z_priq_rb_best
+#elif defined(CONFIG_WAITQ_MULTIQ)
+#define z_priq_wait_add		z_priq_mq_add
+#define _priq_wait_remove	z_priq_mq_remove
+#define _priq_wait_best		z_priq_mq_best
 #elif defined(CONFIG_WAITQ_DUMB)
 #define z_priq_wait_add		z_priq_dumb_add
 #define _priq_wait_remove	z_priq_dumb_remove
@@ -57,6 +64,7 @@ static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
 struct k_spinlock sched_spinlock;
 
 static void update_cache(int preempt_ok);
+static void ready_thread(struct k_thread *thread);
 static void halt_thread(struct k_thread *thread, uint8_t new_state);
 static void add_to_waitq_locked(struct k_thread *thread, _wait_q_t *wait_q);
 
@@ -186,7 +194,8 @@ static ALWAYS_INLINE struct k_thread *_priq_dumb_mask_best(sys_dlist_t *pq)
 }
 #endif
 
-#if defined(CONFIG_SCHED_DUMB) || defined(CONFIG_WAITQ_DUMB)
+#if defined(CONFIG_SCHED_DUMB) || defined(CONFIG_SCHED_WORK_STEALING) || \
+	defined(CONFIG_WAITQ_DUMB)
 static ALWAYS_INLINE void z_priq_dumb_add(sys_dlist_t *pq,
 					  struct k_thread *thread)
 {
@@ -206,9 +215,44 @@ static ALWAYS_INLINE void z_priq_dumb_add(sys_dlist_t *pq,
 }
 #endif
 
+#ifdef CONFIG_SCHED_WORK_STEALING
+/* Each CPU's ready queue has a lock of its own, which guards the list
+ * and is taken for every add, remove and look at its head, including
+ * those of other CPUs stealing from it.  It nests inside sched_spinlock,
+ * which still guards the thread state that decides whether a thread is
+ * queued at all.
+ */
+static struct k_spinlock runq_lock[CONFIG_MP_MAX_NUM_CPUS];
+
+/* The CPU whose queue a newly ready thread goes to: preferably the one
+ * it last ran on, whose cache may still hold its working set
+ */
+static ALWAYS_INLINE int runq_home_cpu(struct k_thread *thread)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	uint32_t m = thread->base.cpu_mask;
+#else
+	uint32_t m = BIT_MASK(CONFIG_MP_MAX_NUM_CPUS);
+#endif
+
+	if ((m & BIT(thread->base.cpu)) != 0U) {
+		return thread->base.cpu;
+	}
+	if ((m & BIT(_current_cpu->id)) != 0U) {
+		return _current_cpu->id;
+	}
+
+	/* Same masked-off edge case as in thread_runq() */
+	return m == 0U ? 0 : u32_count_trailing_zeros(m);
+}
+#endif
+
 static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_WORK_STEALING)
+	/* Set by runq_add() */
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY)
 	int cpu, m = thread->base.cpu_mask;
 
 	/* Edge case: it's legal per the API to "make runnable" a
@@ -228,7 +272,7 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_PER_CPU_READY_Q
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
@@ -237,17 +281,68 @@ static ALWAYS_INLINE void *curr_cpu_runq(void)
 
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
+#ifdef CONFIG_SCHED_WORK_STEALING
+	int cpu = runq_home_cpu(thread);
+
+	K_SPINLOCK(&runq_lock[cpu]) {
+		thread->base.runq_cpu = cpu;
+		_priq_run_add(thread_runq(thread), thread);
+	}
+#else
 	_priq_run_add(thread_runq(thread), thread);
+#endif
 }
 
 static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 {
+#ifdef CONFIG_SCHED_WORK_STEALING
+	K_SPINLOCK(&runq_lock[thread->base.runq_cpu]) {
+		_priq_run_remove(thread_runq(thread), thread);
+	}
+#else
 	_priq_run_remove(thread_runq(thread), thread);
+#endif
 }
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_WORK_STEALING
+	unsigned int num_cpus = arch_num_cpus();
+	unsigned int id = _current_cpu->id;
+	struct k_thread *best = NULL;
+
+	K_SPINLOCK(&runq_lock[id]) {
+		best = _priq_run_best(curr_cpu_runq());
+	}
+
+	/* Steal from another CPU's queue when it holds something more
+	 * important than (or, if we are idle, anything instead of) our
+	 * own best candidate.  _priq_run_best() only returns threads
+	 * allowed on this CPU, so the CPU masks are respected when
+	 * stealing.  Ties go to the local queue, and starting the scan
+	 * at our neighbour spreads the stealing.
+	 */
+	for (unsigned int i = 1; i < num_cpus; i++) {
+		unsigned int cpu = id + i;
+		struct k_thread *thread = NULL;
+
+		if (cpu >= num_cpus) {
+			cpu -= num_cpus;
+		}
+
+		K_SPINLOCK(&runq_lock[cpu]) {
+			thread = _priq_run_best(&_kernel.cpus[cpu].ready_q.runq);
+		}
+		if ((thread != NULL) &&
+		    ((best == NULL) || (z_sched_prio_cmp(thread, best) > 0))) {
+			best = thread;
+		}
+	}
+
+	return best;
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif
 }
 
 /* _current is never in the run queue until context switch on
@@ -633,6 +728,262 @@ static bool thread_active_elsewhere(struct k_thread *thread)
 	return false;
 }
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+/* Utilization of reservations is accounted in millionths of a CPU */
+#define CBS_UTIL_SCALE 1000000ULL
+
+/* Protects the budgets and the per-CPU budget timers.  The switch hooks
+ * run both with and without sched_spinlock held, so this is a leaf lock:
+ * when both are needed, sched_spinlock is taken first.
+ */
+static struct k_spinlock cbs_lock;
+static struct _timeout cbs_budget_timeouts[CONFIG_MP_MAX_NUM_CPUS];
+static struct k_thread *cbs_current[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t cbs_total_util;
+
+static void cbs_budget_timeout(struct _timeout *t);
+static void cbs_replenish(struct _timeout *t);
+
+static uint32_t cbs_now(void)
+{
+	uint32_t now = k_cycle_get_32();
+
+	/* A zero start time means "not running" */
+	return (now == 0U) ? 1U : now;
+}
+
+static uint64_t cbs_util(uint32_t runtime, uint32_t period)
+{
+	return (period == 0U) ? 0U : (runtime * CBS_UTIL_SCALE) / period;
+}
+
+static int32_t cbs_deadline_left(struct k_thread *thread, uint32_t now)
+{
+	return (int32_t)((uint32_t)thread->base.prio_deadline - now);
+}
+
+/* Charges a running thread for the cycles since it was last charged */
+static void cbs_charge(struct k_thread *thread, uint32_t now)
+{
+	struct _thread_cbs *cbs = &thread->base.cbs;
+
+	if (cbs->start != 0U) {
+		cbs->budget -= (int32_t)(now - cbs->start);
+		cbs->start = now;
+	}
+}
+
+static void cbs_arm_budget(int cpu, struct k_thread *thread)
+{
+	int32_t ticks = k_cyc_to_ticks_ceil32(MAX(thread->base.cbs.budget, 0));
+
+	/* Expiring up to a tick early is fine, the handler rearms for
+	 * whatever budget is left.
+	 */
+	z_abort_timeout(&cbs_budget_timeouts[cpu]);
+	z_add_timeout(&cbs_budget_timeouts[cpu], cbs_budget_timeout,
+		      K_TICKS(MAX(ticks - 1, 0)));
+}
+
+/* Starts the next period: the budget is refilled, less any overrun of
+ * the previous one, and the deadline moves one period ahead (or a period
+ * from now, if the server has fallen behind).
+ */
+static void cbs_refill(struct k_thread *thread, uint32_t now)
+{
+	struct _thread_cbs *cbs = &thread->base.cbs;
+	uint32_t deadline = (uint32_t)thread->base.prio_deadline + cbs->period;
+
+	if ((int32_t)(deadline - now) <= 0) {
+		deadline = now + cbs->period;
+	}
+
+	cbs->budget = MIN(cbs->budget + (int32_t)cbs->runtime,
+			  (int32_t)cbs->runtime);
+	thread->base.prio_deadline = (int)deadline;
+}
+
+/* Keeps a thread off the CPU until its deadline, when the budget is
+ * replenished
+ */
+static void cbs_throttle(struct k_thread *thread, uint32_t now)
+{
+	int32_t left = cbs_deadline_left(thread, now);
+
+	thread->base.cbs.throttled = true;
+	if (z_is_thread_queued(thread)) {
+		if (thread_active_elsewhere(thread)) {
+			/* The _current of another CPU is only flagged as
+			 * queued, z_requeue_current() links it into the run
+			 * queue once that CPU has switched away from it.
+			 * Clearing the flag keeps it out, dequeue_thread()
+			 * would unlink a node that is not in the queue.
+			 */
+			thread->base.thread_state &= ~_THREAD_QUEUED;
+		} else {
+			dequeue_thread(thread);
+		}
+	}
+
+	z_add_timeout(&thread->base.cbs.replenish, cbs_replenish,
+		      K_TICKS(k_cyc_to_ticks_ceil32(MAX(left, 0))));
+	update_cache(0);
+	flag_ipi();
+}
+
+static void cbs_budget_timeout(struct _timeout *t)
+{
+	int cpu = ARRAY_INDEX(cbs_budget_timeouts, t);
+
+	K_SPINLOCK(&sched_spinlock) {
+		k_spinlock_key_t key = k_spin_lock(&cbs_lock);
+		struct k_thread *thread = cbs_current[cpu];
+		uint32_t now = cbs_now();
+
+		if ((thread == NULL) || (thread->base.cbs.period == 0U) ||
+		    z_is_thread_prevented_from_running(thread)) {
+			k_spin_unlock(&cbs_lock, key);
+			K_SPINLOCK_BREAK;
+		}
+
+		cbs_charge(thread, now);
+		if ((thread->base.cbs.budget <= 0) &&
+		    (cbs_deadline_left(thread, now) <= 0)) {
+			/* Overran past its deadline: just start a new period */
+			cbs_refill(thread, now);
+			if (z_is_thread_queued(thread) &&
+			    !thread_active_elsewhere(thread)) {
+				dequeue_thread(thread);
+				queue_thread(thread);
+				update_cache(0);
+			}
+		}
+
+		if (thread->base.cbs.budget > 0) {
+			cbs_arm_budget(cpu, thread);
+		} else {
+			cbs_throttle(thread, now);
+		}
+		k_spin_unlock(&cbs_lock, key);
+	}
+}
+
+static void cbs_replenish(struct _timeout *t)
+{
+	struct k_thread *thread = CONTAINER_OF(t, struct k_thread,
+					       base.cbs.replenish);
+
+	K_SPINLOCK(&sched_spinlock) {
+		k_spinlock_key_t key = k_spin_lock(&cbs_lock);
+		uint32_t now = cbs_now();
+
+		thread->base.cbs.throttled = false;
+		cbs_refill(thread, now);
+		if (thread->base.cbs.budget <= 0) {
+			cbs_throttle(thread, now);
+		}
+		k_spin_unlock(&cbs_lock, key);
+
+		/* Another CPU may not have switched away from it yet, it
+		 * then just keeps running, see z_ready_thread()
+		 */
+		if (!thread_active_elsewhere(thread)) {
+			ready_thread(thread);
+		}
+	}
+}
+
+/* Applies the constant bandwidth server wakeup rule to a thread being
+ * made ready.  Returns false if it has to stay throttled.
+ */
+static bool cbs_wakeup(struct k_thread *thread)
+{
+	struct _thread_cbs *cbs = &thread->base.cbs;
+	bool ready = true;
+
+	if (cbs->period == 0U) {
+		return true;
+	}
+
+	K_SPINLOCK(&cbs_lock) {
+		uint32_t now = cbs_now();
+		int32_t left = cbs_deadline_left(thread, now);
+
+		/* The current deadline is kept only if the budget left can
+		 * be used before it without exceeding the reserved
+		 * bandwidth; otherwise a new period starts now.
+		 */
+		if ((left <= 0) ||
+		    ((uint64_t)MAX(cbs->budget, 0) * cbs->period >=
+		     (uint64_t)left * cbs->runtime)) {
+			cbs->budget = cbs->runtime;
+			thread->base.prio_deadline = (int)(now + cbs->period);
+		} else if (cbs->budget <= 0) {
+			cbs_throttle(thread, now);
+			ready = false;
+		}
+	}
+
+	return ready;
+}
+
+/* Drops the reservation of a thread that is going away */
+static void cbs_release(struct k_thread *thread)
+{
+	struct _thread_cbs *cbs = &thread->base.cbs;
+
+	K_SPINLOCK(&cbs_lock) {
+		cbs_total_util -= cbs_util(cbs->runtime, cbs->period);
+		cbs->runtime = 0U;
+		cbs->period = 0U;
+		cbs->throttled = false;
+		z_abort_timeout(&cbs->replenish);
+
+		for (int i = 0; i < ARRAY_SIZE(cbs_current); i++) {
+			if (cbs_current[i] == thread) {
+				cbs_current[i] = NULL;
+			}
+		}
+	}
+}
+
+void z_sched_cbs_start(struct k_thread *thread)
+{
+	int cpu = _current_cpu->id;
+	k_spinlock_key_t key = k_spin_lock(&cbs_lock);
+
+	/* The budget timer keeps running if the same thread resumes */
+	if (cbs_current[cpu] != thread) {
+		z_abort_timeout(&cbs_budget_timeouts[cpu]);
+		cbs_current[cpu] = NULL;
+		/* Dummy threads may be uninitialized memory */
+		if (!z_is_thread_state_set(thread, _THREAD_DUMMY) &&
+		    (thread->base.cbs.period != 0U)) {
+			cbs_current[cpu] = thread;
+			cbs_arm_budget(cpu, thread);
+		}
+	}
+
+	if (cbs_current[cpu] != NULL) {
+		thread->base.cbs.start = cbs_now();
+	}
+	k_spin_unlock(&cbs_lock, key);
+}
+
+void z_sched_cbs_stop(void)
+{
+	int cpu = _current_cpu->id;
+	k_spinlock_key_t key = k_spin_lock(&cbs_lock);
+	struct k_thread *thread = cbs_current[cpu];
+
+	if (thread != NULL) {
+		cbs_charge(thread, cbs_now());
+		thread->base.cbs.start = 0U;
+	}
+	k_spin_unlock(&cbs_lock, key);
+}
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
+
 static void ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
@@ -643,8 +994,14 @@ static void ready_thread(struct k_thread *thread)
 	 * run queue again
 	 */
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+		if (!cbs_wakeup(thread)) {
+			return;
+		}
+#endif
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+		z_sched_usage_ready(thread);
 		queue_thread(thread);
 		update_cache(0);
 		flag_ipi();
@@ -878,6 +1235,12 @@ static inline void unpend_thread_no_timeout(struct k_thread *thread)
 	_priq_wait_remove(&pended_on_thread(thread)->waitq, thread);
 	z_mark_thread_as_not_pending(thread);
 	thread->base.pended_on = NULL;
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+	/* No longer part of a priority inheritance chain, whether it got
+	 * the mutex, timed out or was aborted
+	 */
+	thread->pended_mutex = NULL;
+#endif
 }
 
 ALWAYS_INLINE void z_unpend_thread_no_timeout(struct k_thread *thread)
@@ -1034,6 +1397,16 @@ bool z_set_prio(struct k_thread *thread, int prio)
 				thread->base.prio = prio;
 			}
 			update_cache(1);
+		} else if (z_is_thread_pending(thread) &&
+			   (thread->base.pended_on != NULL)) {
+			/* Keep the wait queue sorted.  The multiqueue one
+			 * also needs the old priority to find the thread.
+			 */
+			_wait_q_t *wait_q = pended_on_thread(thread);
+
+			_priq_wait_remove(&wait_q->waitq, thread);
+			thread->base.prio = prio;
+			z_priq_wait_add(&wait_q->waitq, thread);
 		} else {
 			thread->base.prio = prio;
 		}
@@ -1337,7 +1710,7 @@ struct k_thread *z_priq_rb_best(struct _priq_rb *pq)
 	return thread;
 }
 
-#ifdef CONFIG_SCHED_MULTIQ
+#if defined(CONFIG_SCHED_MULTIQ) || defined(CONFIG_WAITQ_MULTIQ)
 # if (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO) > 31
 # error Too many priorities for multiqueue scheduler (max 32)
 # endif
@@ -1347,8 +1720,11 @@ static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 {
 	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
 
+	if ((pq->bitmask & BIT(priority_bit)) == 0U) {
+		sys_dlist_init(&pq->queues[priority_bit]);
+		pq->bitmask |= BIT(priority_bit);
+	}
 	sys_dlist_append(&pq->queues[priority_bit], &thread->base.qnode_dlist);
-	pq->bitmask |= BIT(priority_bit);
 }
 
 static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
@@ -1379,6 +1755,29 @@ struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 	return thread;
 }
 
+/* Thread following @thread in priority (then FIFO) order, for walking
+ * a multiqueue with one plain loop
+ */
+struct k_thread *z_priq_mq_next(struct _priq_mq *pq, struct k_thread *thread)
+{
+	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	sys_dnode_t *n = sys_dlist_peek_next_no_check(&pq->queues[priority_bit],
+						      &thread->base.qnode_dlist);
+
+	if (n == NULL) {
+		/* Lists of lower priority than this one */
+		unsigned int rest = pq->bitmask &
+			~(BIT(priority_bit) | (BIT(priority_bit) - 1U));
+
+		if (rest == 0U) {
+			return NULL;
+		}
+		n = sys_dlist_peek_head(&pq->queues[__builtin_ctz(rest)]);
+	}
+
+	return CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+}
+
 int z_unpend_all(_wait_q_t *wait_q)
 {
 	int need_sched = 0;
@@ -1412,7 +1811,7 @@ void init_ready_q(struct _ready_q *rq)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#ifdef CONFIG_SCHED_PER_CPU_READY_Q
 	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
@@ -1492,6 +1891,94 @@ static inline void z_vrfy_k_thread_deadline_set(k_tid_t tid, int deadline)
 }
 #include <syscalls/k_thread_deadline_set_mrsh.c>
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+int z_impl_k_thread_cbs_set(k_tid_t tid, uint32_t runtime_us,
+			    uint32_t period_us)
+{
+	struct k_thread *thread = tid;
+	struct _thread_cbs *cbs = &thread->base.cbs;
+	uint64_t runtime = k_us_to_cyc_ceil64(runtime_us);
+	uint64_t period = k_us_to_cyc_floor64(period_us);
+	uint64_t max_util = (uint64_t)CONFIG_SCHED_DEADLINE_CBS_UTILIZATION *
+			    arch_num_cpus() * (CBS_UTIL_SCALE / 100U);
+	uint64_t util, old_util;
+	k_spinlock_key_t key, cbs_key;
+	bool throttled;
+	uint32_t now;
+
+	/* Deadlines must stay within half of the 32 bit cycle space */
+	if (((runtime_us == 0U) != (period_us == 0U)) ||
+	    (runtime_us > period_us) || (period > (INT32_MAX / 2)) ||
+	    ((period_us != 0U) && (runtime == 0U || period == 0U)) ||
+	    z_is_idle_thread_object(thread)) {
+		return -EINVAL;
+	}
+
+	util = cbs_util(runtime, period);
+
+	key = k_spin_lock(&sched_spinlock);
+	cbs_key = k_spin_lock(&cbs_lock);
+
+	old_util = cbs_util(cbs->runtime, cbs->period);
+	if ((cbs_total_util - old_util + util) > max_util) {
+		k_spin_unlock(&cbs_lock, cbs_key);
+		k_spin_unlock(&sched_spinlock, key);
+		return -EBUSY;
+	}
+	cbs_total_util = cbs_total_util - old_util + util;
+
+	now = cbs_now();
+	throttled = cbs->throttled;
+	z_abort_timeout(&cbs->replenish);
+	cbs->runtime = (uint32_t)runtime;
+	cbs->period = (uint32_t)period;
+	cbs->budget = (int32_t)runtime;
+	cbs->throttled = false;
+	if (period != 0U) {
+		thread->base.prio_deadline = (int)(now + (uint32_t)period);
+	}
+
+	/* The calling thread is charged right away, others from the next
+	 * time they are switched in
+	 */
+	if (thread == _current) {
+		int cpu = _current_cpu->id;
+
+		z_abort_timeout(&cbs_budget_timeouts[cpu]);
+		cbs_current[cpu] = NULL;
+		cbs->start = 0U;
+		if (period != 0U) {
+			cbs_current[cpu] = thread;
+			cbs->start = now;
+			cbs_arm_budget(cpu, thread);
+		}
+	}
+	k_spin_unlock(&cbs_lock, cbs_key);
+
+	if (z_is_thread_queued(thread) && !thread_active_elsewhere(thread)) {
+		dequeue_thread(thread);
+		queue_thread(thread);
+	}
+	if (throttled && !thread_active_elsewhere(thread)) {
+		ready_thread(thread);
+	}
+	k_spin_unlock(&sched_spinlock, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_thread_cbs_set(k_tid_t tid, uint32_t runtime_us,
+					  uint32_t period_us)
+{
+	K_OOPS(K_SYSCALL_OBJ(tid, K_OBJ_THREAD));
+
+	return z_impl_k_thread_cbs_set(tid, runtime_us, period_us);
+}
+#include <syscalls/k_thread_cbs_set_mrsh.c>
+#endif
+#endif /* CONFIG_SCHED_DEADLINE_CBS */
 #endif
 
 bool k_can_yield(void)
@@ -1744,6 +2231,13 @@ static int cpu_mask_mod(k_tid_t thread, uint32_t enable_mask, uint32_t disable_m
 		if (z_is_thread_prevented_from_running(thread)) {
 			thread->base.cpu_mask |= enable_mask;
 			thread->base.cpu_mask  &= ~disable_mask;
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+			/* Under the lock, so that the queue matches the
+			 * latest mask when masks are changed concurrently
+			 */
+			z_migrate_timeout(&thread->base.timeout,
+					  thread->base.cpu_mask);
+#endif
 		} else {
 			ret = -EINVAL;
 		}
@@ -1834,6 +2328,9 @@ static void halt_thread(struct k_thread *thread, uint8_t new_state)
 			}
 			(void)z_abort_thread_timeout(thread);
 			unpend_all(&thread->join_queue);
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+			cbs_release(thread);
+#endif
 		}
 #ifdef CONFIG_SMP
 		unpend_all(&thread->halt_queue);
@@ -1874,6 +2371,16 @@ static void halt_thread(struct k_thread *thread, uint8_t new_state)
 
 void z_thread_abort(struct k_thread *thread)
 {
+#ifdef CONFIG_THREAD_POOL
+	/* Aborting the current thread does not come back, so release its
+	 * pool slot first; the next user of the slot joins it
+	 */
+	bool self = (thread == _current) && !arch_is_in_isr();
+
+	if (self) {
+		z_thread_pool_abort(thread);
+	}
+#endif
 	k_spinlock_key_t key = k_spin_lock(&sched_spinlock);
 
 	if ((thread->base.user_options & K_ESSENTIAL) != 0) {
@@ -1889,6 +2396,12 @@ void z_thread_abort(struct k_thread *thread)
 	}
 
 	z_thread_halt(thread, key, true);
+
+#ifdef CONFIG_THREAD_POOL
+	if (!self) {
+		z_thread_pool_abort(thread);
+	}
+#endif
 }
 
 #if !defined(CONFIG_ARCH_HAS_THREAD_ABORT)
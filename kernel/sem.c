@@ -32,9 +32,14 @@
 /* We use a system-wide lock to synchronize semaphores, which has
  * unfortunate performance impact vs. using a per-object lock
  * (semaphores are *very* widely used).  But per-object locks require
- * significant extra RAM.  A properly spin-aware semaphore
- * implementation would spin on atomic access to the count variable,
- * and not a spinlock per se.  Useful optimization for the future...
+ * significant extra RAM.
+ *
+ * With CONFIG_SYNC_FAST_PATH the uncontended cases skip the lock
+ * entirely and work on the count with atomic compare-and-swap.  That
+ * relies on the count only being nonzero while no thread is pended: a
+ * thread pends with the lock held after seeing a zero count, and only
+ * the locked give path raises the count from zero.  So a nonzero count
+ * may be taken, or raised further, without looking at the wait queue.
  */
 static struct k_spinlock lock;
 
@@ -42,6 +47,76 @@ static struct k_spinlock lock;
 static struct k_obj_type obj_type_sem;
 #endif
 
+#ifdef CONFIG_SYNC_FAST_PATH
+static inline void count_set(struct k_sem *sem, unsigned int count)
+{
+	atomic_set(&sem->count, (atomic_val_t)count);
+}
+
+/* Take one from a nonzero count, false if it is zero */
+static inline bool count_take(struct k_sem *sem)
+{
+	atomic_val_t count = atomic_get(&sem->count);
+
+	while (count != 0) {
+		if (atomic_cas(&sem->count, count,
+			       (atomic_val_t)((unsigned int)count - 1U))) {
+			return true;
+		}
+		count = atomic_get(&sem->count);
+	}
+
+	return false;
+}
+
+/* Add one to the count, saturating at the limit.  Without the lock
+ * held a zero count is left alone (there may be waiters) and false
+ * returned.
+ */
+static inline bool count_give(struct k_sem *sem, bool locked)
+{
+	atomic_val_t count = atomic_get(&sem->count);
+
+	while ((count != 0) || locked) {
+		if ((unsigned int)count == sem->limit) {
+			return true;
+		}
+		if (atomic_cas(&sem->count, count,
+			       (atomic_val_t)((unsigned int)count + 1U))) {
+			return true;
+		}
+		count = atomic_get(&sem->count);
+	}
+
+	return false;
+}
+#else
+/* Without the fast path these are only called with the lock held */
+static inline void count_set(struct k_sem *sem, unsigned int count)
+{
+	sem->count = count;
+}
+
+static inline bool count_take(struct k_sem *sem)
+{
+	if (sem->count == 0U) {
+		return false;
+	}
+	sem->count--;
+
+	return true;
+}
+
+static inline bool count_give(struct k_sem *sem, bool locked)
+{
+	__ASSERT_NO_MSG(locked);
+
+	sem->count += (sem->count != sem->limit) ? 1U : 0U;
+
+	return true;
+}
+#endif
+
 int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 		      unsigned int limit)
 {
@@ -54,7 +129,7 @@ int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 		return -EINVAL;
 	}
 
-	sem->count = initial_count;
+	count_set(sem, initial_count);
 	sem->limit = limit;
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_sem, init, sem, 0);
@@ -95,19 +170,27 @@ static inline bool handle_poll_events(struct k_sem *sem)
 
 void z_impl_k_sem_give(struct k_sem *sem)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key;
 	struct k_thread *thread;
 	bool resched = true;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_sem, give, sem);
 
+	/* Pollers are only signalled from the locked path */
+	if (IS_ENABLED(CONFIG_SYNC_FAST_PATH) && !IS_ENABLED(CONFIG_POLL) &&
+	    count_give(sem, false)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, give, sem);
+		return;
+	}
+
+	key = k_spin_lock(&lock);
 	thread = z_unpend_first_thread(&sem->wait_q);
 
 	if (thread != NULL) {
 		arch_thread_return_value_set(thread, 0);
 		z_ready_thread(thread);
 	} else {
-		sem->count += (sem->count != sem->limit) ? 1U : 0U;
+		(void)count_give(sem, true);
 		resched = handle_poll_events(sem);
 	}
 
@@ -131,19 +214,25 @@ static inline void z_vrfy_k_sem_give(struct k_sem *sem)
 
 int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 {
+	k_spinlock_key_t key;
 	int ret = 0;
 
 	__ASSERT(((arch_is_in_isr() == false) ||
 		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
-
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_sem, take, sem, timeout);
 
-	if (likely(sem->count > 0U)) {
-		sem->count--;
+	if (IS_ENABLED(CONFIG_SYNC_FAST_PATH) && likely(count_take(sem))) {
+		goto out;
+	}
+
+	key = k_spin_lock(&lock);
+
+	/* With the fast path a locked give may have raised it from zero
+	 * since the check above
+	 */
+	if (likely(count_take(sem))) {
 		k_spin_unlock(&lock, key);
-		ret = 0;
 		goto out;
 	}
 
@@ -176,7 +265,7 @@ void z_impl_k_sem_reset(struct k_sem *sem)
 		arch_thread_return_value_set(thread, -EAGAIN);
 		z_ready_thread(thread);
 	}
-	sem->count = 0;
+	count_set(sem, 0U);
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_sem, reset, sem);
 
@@ -622,6 +622,9 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 	k_object_access_grant(new_thread, new_thread);
 #endif
 	z_waitq_init(&new_thread->join_queue);
+#if CONFIG_PRIORITY_INHERITANCE_DEPTH > 1
+	new_thread->pended_mutex = NULL;
+#endif
 
 	/* Initialize various struct k_thread members */
 	z_init_thread_base(&new_thread->base, prio, _THREAD_PRESTART, options);
@@ -684,6 +687,9 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 		new_thread->base.cpu_mask = -1; /* allow all cpus */
 	}
 #endif
+#ifdef CONFIG_THREAD_POOL
+	new_thread->thread_pool = NULL;
+#endif
 #ifdef CONFIG_ARCH_HAS_CUSTOM_SWAP_TO_MAIN
 	/* _current may be null if the dummy thread is not used */
 	if (!_current) {
@@ -712,6 +718,9 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 	new_thread->base.usage.track_usage =
 		CONFIG_SCHED_THREAD_USAGE_AUTO_ENABLE;
 #endif
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+	new_thread->base.ready_stamp = 0U;
+#endif
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_thread, create, new_thread);
 
@@ -892,6 +901,11 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->slice_expired = NULL;
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	thread_base->cbs = (struct _thread_cbs){};
+	z_init_timeout(&thread_base->cbs.replenish);
+#endif
+
 	/* swap_data does not need to be initialized */
 
 	z_init_thread_timeout(thread_base);
@@ -1199,6 +1213,13 @@ int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats)
 		stats->average_cycles   += tmp_stats.average_cycles;
 #endif
 		stats->idle_cycles      += tmp_stats.idle_cycles;
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+		for (int j = 0; j < CONFIG_SCHED_THREAD_LATENCY_BUCKETS; j++) {
+			stats->latency[j] += tmp_stats.latency[j];
+		}
+		stats->latency_max = MAX(stats->latency_max,
+					 tmp_stats.latency_max);
+#endif
 	}
 #endif
 
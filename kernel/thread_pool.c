@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/spinlock.h>
+#include <kernel_internal.h>
+
+/* Each slot of a pool has one thread, created by the first spawn on the
+ * slot.  After running an entry point the thread releases its slot and
+ * waits on the start semaphore of the slot for the next one, so spawning
+ * only hands over the entry point.
+ *
+ * With CONFIG_INIT_STACKS, the thread exits after its entry point
+ * instead, and the next spawn on the slot creates it again, which paints
+ * its whole stack from the spawning thread.
+ *
+ * A pool thread that exits or is aborted releases its slot from
+ * z_thread_pool_abort().
+ */
+
+static void pool_release(struct k_thread_pool *pool,
+			 struct z_thread_pool_slot *slot)
+{
+	k_spinlock_key_t key = k_spin_lock(&pool->lock);
+
+	slot->busy = false;
+	k_spin_unlock(&pool->lock, key);
+
+	k_sem_give(&pool->free);
+}
+
+static void pool_thread(void *p1, void *p2, void *p3)
+{
+	struct k_thread_pool *pool = p1;
+	struct z_thread_pool_slot *slot = p2;
+
+	ARG_UNUSED(p3);
+
+	do {
+		slot->entry(slot->p1, slot->p2, slot->p3);
+
+		if (IS_ENABLED(CONFIG_INIT_STACKS)) {
+			/* Released when aborted on the way out */
+			return;
+		}
+
+		pool_release(pool, slot);
+	} while (k_sem_take(&slot->start, K_FOREVER) == 0);
+}
+
+void z_thread_pool_abort(struct k_thread *thread)
+{
+	struct k_thread_pool *pool = thread->thread_pool;
+	struct z_thread_pool_slot *slot;
+	k_spinlock_key_t key;
+	bool busy;
+
+	if (pool == NULL) {
+		return;
+	}
+
+	slot = CONTAINER_OF(thread, struct z_thread_pool_slot, thread);
+
+	key = k_spin_lock(&pool->lock);
+
+	/* Once per thread, the abort of the current thread may be
+	 * reported by more than one CPU
+	 */
+	if (thread->thread_pool == NULL) {
+		k_spin_unlock(&pool->lock, key);
+		return;
+	}
+
+	thread->thread_pool = NULL;
+	slot->created = false;
+	busy = slot->busy;
+	slot->busy = false;
+	k_spin_unlock(&pool->lock, key);
+
+	if (busy) {
+		k_sem_give(&pool->free);
+	}
+}
+
+static struct z_thread_pool_slot *slot_get(struct k_thread_pool *pool,
+					   bool *created)
+{
+	struct z_thread_pool_slot *slot = NULL;
+	k_spinlock_key_t key = k_spin_lock(&pool->lock);
+
+	for (uint16_t i = 0; i < pool->count; i++) {
+		if (!pool->slots[i].busy) {
+			slot = &pool->slots[i];
+			slot->busy = true;
+			*created = slot->created;
+			break;
+		}
+	}
+
+	k_spin_unlock(&pool->lock, key);
+
+	return slot;
+}
+
+k_tid_t k_thread_pool_spawn(struct k_thread_pool *pool,
+			    k_thread_entry_t entry,
+			    void *p1, void *p2, void *p3,
+			    int prio, k_timeout_t timeout)
+{
+	struct z_thread_pool_slot *slot;
+	k_thread_stack_t *stack;
+	k_spinlock_key_t key;
+	bool created = false;
+
+	__ASSERT(!k_is_in_isr(), "");
+	__ASSERT_NO_MSG(entry != NULL);
+
+	if (k_sem_take(&pool->free, timeout) != 0) {
+		return NULL;
+	}
+
+	/* The semaphore count guarantees a slot that is not busy */
+	slot = slot_get(pool, &created);
+	__ASSERT_NO_MSG(slot != NULL);
+
+	slot->entry = entry;
+	slot->p1 = p1;
+	slot->p2 = p2;
+	slot->p3 = p3;
+
+	if (created) {
+		k_thread_priority_set(&slot->thread, prio);
+		k_sem_give(&slot->start);
+
+		return &slot->thread;
+	}
+
+	if (slot->started) {
+		/* A thread that exits or is aborted releases its slot before
+		 * it is dead
+		 */
+		(void)k_thread_join(&slot->thread, K_FOREVER);
+	}
+
+	k_sem_init(&slot->start, 0, 1);
+	slot->started = true;
+
+	stack = (k_thread_stack_t *)((uint8_t *)pool->stacks +
+				     (slot - pool->slots) * pool->stack_len);
+
+	(void)k_thread_create(&slot->thread, stack, pool->stack_size,
+			      pool_thread, pool, slot, NULL, prio,
+			      pool->options, K_FOREVER);
+
+	/* Set after k_thread_create(), which clears it */
+	key = k_spin_lock(&pool->lock);
+	slot->thread.thread_pool = pool;
+	slot->created = true;
+	k_spin_unlock(&pool->lock, key);
+
+	k_thread_start(&slot->thread);
+
+	return &slot->thread;
+}
@@ -12,11 +12,47 @@
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+#include <timeout_wheel.h>
+#endif
+
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+#define NUM_TIMEOUT_QUEUES CONFIG_MP_MAX_NUM_CPUS
+#else
+#define NUM_TIMEOUT_QUEUES 1
+#endif
+
+/* With per-CPU queues, timeouts are armed on the calling CPU's queue
+ * and each queue lock protects only its own entries.  The clock state
+ * (curr_tick, announce_remaining) is only ever modified with all
+ * queue locks held, so holding any single one is enough to read it.
+ */
+struct timeout_queue {
+	struct k_spinlock lock;
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	struct z_timeout_wheel wheel;
+#else
+	sys_dlist_t list;
+#endif
+};
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+static struct timeout_queue timeout_queues[NUM_TIMEOUT_QUEUES];
+#else
+#define TIMEOUT_QUEUE_INIT(i, _) \
+	{ .list = SYS_DLIST_STATIC_INIT(&timeout_queues[i].list) }
 
-static struct k_spinlock timeout_lock;
+static struct timeout_queue timeout_queues[NUM_TIMEOUT_QUEUES] = {
+	LISTIFY(NUM_TIMEOUT_QUEUES, TIMEOUT_QUEUE_INIT, (,))
+};
+#endif
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+/* Absolute expiry the timer was last programmed for */
+static uint64_t programmed_expiry = UINT64_MAX;
+#endif
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
 		  ? K_TICKS_FOREVER : INT_MAX)
@@ -36,29 +72,228 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
-static struct _timeout *first(void)
+static inline struct timeout_queue *queue_of(const struct _timeout *to)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	return &timeout_queues[to->queue];
+#else
+	ARG_UNUSED(to);
+
+	return &timeout_queues[0];
+#endif
+}
+
+/* Lock the calling CPU's queue */
+static struct timeout_queue *lock_local(k_spinlock_key_t *key)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	struct timeout_queue *q;
+
+	/* We can move to another CPU until the lock is held, which
+	 * keeps interrupts locked and so pins us to the CPU
+	 */
+	do {
+		q = &timeout_queues[arch_curr_cpu()->id];
+		*key = k_spin_lock(&q->lock);
+		if (q == &timeout_queues[arch_curr_cpu()->id]) {
+			break;
+		}
+		k_spin_unlock(&q->lock, *key);
+	} while (true);
+
+	return q;
+#else
+	*key = k_spin_lock(&timeout_queues[0].lock);
+
+	return &timeout_queues[0];
+#endif
+}
+
+/* Lock the queue a timeout is (or was last) linked on */
+static struct timeout_queue *lock_queue_of(const struct _timeout *to,
+					   k_spinlock_key_t *key)
+{
+	struct timeout_queue *q;
+
+	/* The timeout can be re-armed on another CPU until we hold the
+	 * lock of the queue it is recorded on
+	 */
+	do {
+		q = queue_of(to);
+		*key = k_spin_lock(&q->lock);
+		if (q == queue_of(to)) {
+			break;
+		}
+		k_spin_unlock(&q->lock, *key);
+	} while (true);
+
+	return q;
+}
+
+static k_spinlock_key_t lock_all(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&timeout_queues[0].lock);
+
+	for (int i = 1; i < NUM_TIMEOUT_QUEUES; i++) {
+		(void)k_spin_lock(&timeout_queues[i].lock);
+	}
+
+	return key;
+}
+
+static void unlock_all(k_spinlock_key_t key)
+{
+	for (int i = NUM_TIMEOUT_QUEUES - 1; i > 0; i--) {
+		k_spin_release(&timeout_queues[i].lock);
+	}
+
+	k_spin_unlock(&timeout_queues[0].lock, key);
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+/* The timing wheel stores absolute expiry ticks in dticks */
+
+static struct _timeout *first(struct timeout_queue *q)
+{
+	return z_tw_first(&q->wheel);
+}
+
+/* Ticks from curr_tick until the timeout expires */
+static k_ticks_t first_dticks(struct timeout_queue *q,
+			      const struct _timeout *t)
+{
+	return (k_ticks_t)(z_tw_expiry(&q->wheel, t) - curr_tick);
+}
+
+/* Insert a timeout expiring to->dticks ticks after curr_tick */
+static void insert_timeout(struct timeout_queue *q, struct _timeout *to)
+{
+	z_tw_insert(&q->wheel, to, curr_tick + to->dticks);
+}
+
+static void remove_timeout(struct timeout_queue *q, struct _timeout *t)
+{
+	z_tw_remove(&q->wheel, t);
+}
+
+/* Remove the first timeout once curr_tick has reached its expiry */
+static void expire_first(struct timeout_queue *q, struct _timeout *t)
+{
+	remove_timeout(q, t);
+	z_tw_advance(&q->wheel, curr_tick);
+}
+
+/* Account for curr_tick having moved forward by @a ticks */
+static void advance_timeouts(struct timeout_queue *q, k_ticks_t ticks)
+{
+	ARG_UNUSED(ticks);
+
+	z_tw_advance(&q->wheel, curr_tick);
+}
+
+#else
+
+static struct _timeout *first(struct timeout_queue *q)
 {
-	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
+	sys_dnode_t *t = sys_dlist_peek_head(&q->list);
 
 	return t == NULL ? NULL : CONTAINER_OF(t, struct _timeout, node);
 }
 
-static struct _timeout *next(struct _timeout *t)
+static struct _timeout *next(struct timeout_queue *q, struct _timeout *t)
 {
-	sys_dnode_t *n = sys_dlist_peek_next(&timeout_list, &t->node);
+	sys_dnode_t *n = sys_dlist_peek_next(&q->list, &t->node);
 
 	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
-static void remove_timeout(struct _timeout *t)
+/* Only valid for first(), later entries store deltas from their
+ * predecessor
+ */
+static k_ticks_t first_dticks(struct timeout_queue *q,
+			      const struct _timeout *t)
+{
+	ARG_UNUSED(q);
+
+	return t->dticks;
+}
+
+static void insert_timeout(struct timeout_queue *q, struct _timeout *to)
 {
-	if (next(t) != NULL) {
-		next(t)->dticks += t->dticks;
+	struct _timeout *t;
+
+	for (t = first(q); t != NULL; t = next(q, t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&q->list, &to->node);
+	}
+}
+
+static void remove_timeout(struct timeout_queue *q, struct _timeout *t)
+{
+	if (next(q, t) != NULL) {
+		next(q, t)->dticks += t->dticks;
 	}
 
 	sys_dlist_remove(&t->node);
 }
 
+static void expire_first(struct timeout_queue *q, struct _timeout *t)
+{
+	t->dticks = 0;
+	remove_timeout(q, t);
+}
+
+static void advance_timeouts(struct timeout_queue *q, k_ticks_t ticks)
+{
+	struct _timeout *t = first(q);
+
+	if (t != NULL) {
+		t->dticks -= ticks;
+	}
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+/* Earliest timeout across all queues, must be locked (all queues) */
+static struct _timeout *first_all(struct timeout_queue **qp)
+{
+	struct _timeout *best = NULL;
+
+	*qp = &timeout_queues[0];
+
+	for (int i = 0; i < NUM_TIMEOUT_QUEUES; i++) {
+		struct timeout_queue *q = &timeout_queues[i];
+		struct _timeout *t = first(q);
+
+		if ((t != NULL) && ((best == NULL) ||
+		    (first_dticks(q, t) < first_dticks(*qp, best)))) {
+			best = t;
+			*qp = q;
+		}
+	}
+
+	return best;
+}
+
+/* Account for curr_tick having moved forward in every queue but @a skip */
+static void advance_queues(struct timeout_queue *skip, k_ticks_t ticks)
+{
+	for (int i = 0; i < NUM_TIMEOUT_QUEUES; i++) {
+		if (&timeout_queues[i] != skip) {
+			advance_timeouts(&timeout_queues[i], ticks);
+		}
+	}
+}
+
 static int32_t elapsed(void)
 {
 	/* While sys_clock_announce() is executing, new relative timeouts will be
@@ -80,25 +315,67 @@ static int32_t elapsed(void)
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
 }
 
+/* must be locked (all queues) */
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
+	struct timeout_queue *q;
+	struct _timeout *to = first_all(&q);
 	int32_t ticks_elapsed = elapsed();
 	int32_t ret;
 
 	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	    ((int64_t)(first_dticks(q, to) - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, first_dticks(q, to) - ticks_elapsed);
 	}
 
 	return ret;
 }
 
+/* must be locked (all queues) */
+static void program_next_timeout(void)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	struct timeout_queue *q;
+	struct _timeout *to = first_all(&q);
+
+	programmed_expiry = (to == NULL) ? UINT64_MAX
+					 : curr_tick + first_dticks(q, to);
+#endif
+
+	sys_clock_set_timeout(next_timeout(), false);
+}
+
+#ifdef CONFIG_TIMEOUT_SLACK
+/* Defer the expiry of a timeout within its slack window to the next
+ * multiple of the largest power of two that fits in the window, so that
+ * timeouts with overlapping windows end up expiring on the same tick.
+ * Must be locked.
+ */
+static void apply_slack(struct _timeout *to)
+{
+	uint64_t expiry = curr_tick + to->dticks;
+	uint64_t align;
+
+	if (to->slack == 0U) {
+		to->deferred = 0U;
+		return;
+	}
+
+	align = BIT64(63 - __builtin_clzll((uint64_t)to->slack + 1U));
+	to->deferred = (uint32_t)(-expiry & (align - 1U));
+	to->dticks += to->deferred;
+}
+#endif
+
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		   k_timeout_t timeout)
 {
+	struct timeout_queue *q;
+	k_spinlock_key_t key;
+	bool reprogram;
+
 	if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 		return;
 	}
@@ -110,53 +387,72 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	__ASSERT(!sys_dnode_is_linked(&to->node), "");
 	to->fn = fn;
 
-	K_SPINLOCK(&timeout_lock) {
-		struct _timeout *t;
+	q = lock_local(&key);
 
-		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
-		    Z_TICK_ABS(timeout.ticks) >= 0) {
-			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
+	if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
+	    Z_TICK_ABS(timeout.ticks) >= 0) {
+		k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
 
-			to->dticks = MAX(1, ticks);
-		} else {
-			to->dticks = timeout.ticks + 1 + elapsed();
-		}
+		to->dticks = MAX(1, ticks);
+	} else {
+		to->dticks = timeout.ticks + 1 + elapsed();
+	}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
+#ifdef CONFIG_TIMEOUT_SLACK
+	apply_slack(to);
+#endif
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	to->queue = q - timeout_queues;
+#endif
 
-		if (to == first()) {
-			sys_clock_set_timeout(next_timeout(), false);
-		}
+	insert_timeout(q, to);
+
+	reprogram = (to == first(q));
+
+#ifdef CONFIG_TIMEOUT_QUEUE_PER_CPU
+	/* Only a new global head needs the timer reprogrammed, which
+	 * requires looking at every queue.  Most timeouts land behind
+	 * what is already programmed and never leave the local lock.
+	 */
+	reprogram = reprogram &&
+		    (curr_tick + first_dticks(q, to) < programmed_expiry);
+
+	k_spin_unlock(&q->lock, key);
+
+	if (reprogram) {
+		key = lock_all();
+		program_next_timeout();
+		unlock_all(key);
+	}
+#else
+	if (reprogram) {
+		program_next_timeout();
 	}
+
+	k_spin_unlock(&q->lock, key);
+#endif
 }
 
 int z_abort_timeout(struct _timeout *to)
 {
+	k_spinlock_key_t key;
+	struct timeout_queue *q = lock_queue_of(to, &key);
 	int ret = -EINVAL;
 
-	K_SPINLOCK(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
-			remove_timeout(to);
-			ret = 0;
-		}
+	if (sys_dnode_is_linked(&to->node)) {
+		remove_timeout(q, to);
+		ret = 0;
 	}
 
+	k_spin_unlock(&q->lock, key);
+
 	return ret;
 }
 
 /* must be locked */
-static k_ticks_t timeout_rem(const struct _timeout *timeout)
+static k_ticks_t timeout_rem(struct timeout_queue *q,
+			     const struct _timeout *timeout)
 {
 	k_ticks_t ticks = 0;
 
@@ -164,51 +460,80 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 		return 0;
 	}
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	ticks = first_dticks(q, timeout);
+#else
+	for (struct _timeout *t = first(q); t != NULL; t = next(q, t)) {
 		ticks += t->dticks;
 		if (timeout == t) {
 			break;
 		}
 	}
+#endif
 
 	return ticks - elapsed();
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
 {
-	k_ticks_t ticks = 0;
+	k_spinlock_key_t key;
+	struct timeout_queue *q = lock_queue_of(timeout, &key);
+	k_ticks_t ticks = timeout_rem(q, timeout);
 
-	K_SPINLOCK(&timeout_lock) {
-		ticks = timeout_rem(timeout);
-	}
+	k_spin_unlock(&q->lock, key);
 
 	return ticks;
 }
 
 k_ticks_t z_timeout_expires(const struct _timeout *timeout)
 {
-	k_ticks_t ticks = 0;
+	k_spinlock_key_t key;
+	struct timeout_queue *q = lock_queue_of(timeout, &key);
+	k_ticks_t ticks = curr_tick + timeout_rem(q, timeout) + elapsed();
 
-	K_SPINLOCK(&timeout_lock) {
-		ticks = curr_tick + timeout_rem(timeout) + elapsed();
-	}
+	k_spin_unlock(&q->lock, key);
 
 	return ticks;
 }
 
 int32_t z_get_next_timeout_expiry(void)
 {
-	int32_t ret = (int32_t) K_TICKS_FOREVER;
+	k_spinlock_key_t key = lock_all();
+	int32_t ret = next_timeout();
+
+	unlock_all(key);
 
-	K_SPINLOCK(&timeout_lock) {
-		ret = next_timeout();
-	}
 	return ret;
 }
 
+#if defined(CONFIG_TIMEOUT_QUEUE_PER_CPU) && defined(CONFIG_SCHED_CPU_MASK)
+void z_migrate_timeout(struct _timeout *to, uint32_t cpu_mask)
+{
+	k_spinlock_key_t key = lock_all();
+	struct timeout_queue *src = queue_of(to);
+
+	cpu_mask &= BIT_MASK(NUM_TIMEOUT_QUEUES);
+
+	if (sys_dnode_is_linked(&to->node) && (cpu_mask != 0) &&
+	    ((cpu_mask & BIT(to->queue)) == 0)) {
+		/* Same absolute expiry; as the global head does not
+		 * change, the timer needs no reprogramming
+		 */
+		k_ticks_t ticks = timeout_rem(src, to) + elapsed();
+
+		remove_timeout(src, to);
+		to->dticks = ticks;
+		to->queue = find_lsb_set(cpu_mask) - 1;
+		insert_timeout(queue_of(to), to);
+	}
+
+	unlock_all(key);
+}
+#endif
+
 void sys_clock_announce(int32_t ticks)
 {
-	k_spinlock_key_t key = k_spin_lock(&timeout_lock);
+	k_spinlock_key_t key = lock_all();
 
 	/* We release the lock around the callbacks below, so on SMP
 	 * systems someone might be already running the loop.  Don't
@@ -218,39 +543,37 @@ void sys_clock_announce(int32_t ticks)
 	 */
 	if (IS_ENABLED(CONFIG_SMP) && (announce_remaining != 0)) {
 		announce_remaining += ticks;
-		k_spin_unlock(&timeout_lock, key);
+		unlock_all(key);
 		return;
 	}
 
 	announce_remaining = ticks;
 
+	struct timeout_queue *q;
 	struct _timeout *t;
 
-	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
-	     t = first()) {
-		int dt = t->dticks;
+	for (t = first_all(&q);
+	     (t != NULL) && (first_dticks(q, t) <= announce_remaining);
+	     t = first_all(&q)) {
+		int dt = first_dticks(q, t);
 
 		curr_tick += dt;
-		t->dticks = 0;
-		remove_timeout(t);
+		expire_first(q, t);
+		advance_queues(q, dt);
 
-		k_spin_unlock(&timeout_lock, key);
+		unlock_all(key);
 		t->fn(t);
-		key = k_spin_lock(&timeout_lock);
+		key = lock_all();
 		announce_remaining -= dt;
 	}
 
-	if (t != NULL) {
-		t->dticks -= announce_remaining;
-	}
-
 	curr_tick += announce_remaining;
+	advance_queues(NULL, announce_remaining);
 	announce_remaining = 0;
 
-	sys_clock_set_timeout(next_timeout(), false);
+	program_next_timeout();
 
-	k_spin_unlock(&timeout_lock, key);
+	unlock_all(key);
 
 #ifdef CONFIG_TIMESLICING
 	z_time_slice();
@@ -259,11 +582,12 @@ void sys_clock_announce(int32_t ticks)
 
 int64_t sys_clock_tick_get(void)
 {
-	uint64_t t = 0U;
+	k_spinlock_key_t key;
+	struct timeout_queue *q = lock_local(&key);
+	uint64_t t = curr_tick + elapsed();
+
+	k_spin_unlock(&q->lock, key);
 
-	K_SPINLOCK(&timeout_lock) {
-		t = curr_tick + elapsed();
-	}
 	return t;
 }
 
@@ -329,7 +653,45 @@ k_timeout_t sys_timepoint_timeout(k_timepoint_t timepoint)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	/* The wheel is indexed by absolute tick, so re-file everything
+	 * pending at the same distance from the new tick, as the
+	 * relative dlist representation would do implicitly.
+	 */
+	k_spinlock_key_t key = lock_all();
+	sys_dlist_t pending[NUM_TIMEOUT_QUEUES];
+	sys_dnode_t *node;
+	struct _timeout *t;
+
+	for (int i = 0; i < NUM_TIMEOUT_QUEUES; i++) {
+		struct timeout_queue *q = &timeout_queues[i];
+
+		sys_dlist_init(&pending[i]);
+		while ((t = first(q)) != NULL) {
+			k_ticks_t dt = first_dticks(q, t);
+
+			remove_timeout(q, t);
+			t->dticks = dt;
+			sys_dlist_append(&pending[i], &t->node);
+		}
+	}
+
 	curr_tick = tick;
+
+	for (int i = 0; i < NUM_TIMEOUT_QUEUES; i++) {
+		struct timeout_queue *q = &timeout_queues[i];
+
+		q->wheel.base = tick;
+		while ((node = sys_dlist_get(&pending[i])) != NULL) {
+			t = CONTAINER_OF(node, struct _timeout, node);
+			insert_timeout(q, t);
+		}
+	}
+
+	unlock_all(key);
+#else
+	curr_tick = tick;
+#endif
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
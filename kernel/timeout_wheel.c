@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/math_extras.h>
+#include <timeout_wheel.h>
+
+#define LEVELS    CONFIG_TIMEOUT_WHEEL_LEVELS
+#define SLOT_MASK (Z_TW_SLOTS - 1)
+
+/* Level of an expiry: the highest bit group in which it differs from
+ * the base, or LEVELS for the overflow list.
+ */
+static int tw_level(uint64_t base, uint64_t expiry)
+{
+	uint64_t diff = base ^ expiry;
+	int lvl;
+
+	if (diff == 0) {
+		return 0;
+	}
+
+	lvl = (63 - u64_count_leading_zeros(diff)) / Z_TW_SLOT_BITS;
+
+	return MIN(lvl, LEVELS);
+}
+
+static inline int tw_slot(int lvl, uint64_t expiry)
+{
+	return (int)((expiry >> (lvl * Z_TW_SLOT_BITS)) & SLOT_MASK);
+}
+
+static void tw_place(struct z_timeout_wheel *tw, struct _timeout *to,
+		     uint64_t expiry)
+{
+	int lvl = tw_level(tw->base, expiry);
+
+	if (lvl < LEVELS) {
+		struct z_tw_level *l = &tw->levels[lvl];
+		int idx = tw_slot(lvl, expiry);
+
+		if ((l->bitmask & BIT64(idx)) == 0) {
+			sys_dlist_init(&l->slots[idx]);
+			l->bitmask |= BIT64(idx);
+		}
+		sys_dlist_append(&l->slots[idx], &to->node);
+	} else {
+		if (!tw->overflow_used) {
+			sys_dlist_init(&tw->overflow);
+			tw->overflow_used = true;
+		}
+		sys_dlist_append(&tw->overflow, &to->node);
+	}
+}
+
+void z_tw_insert(struct z_timeout_wheel *tw, struct _timeout *to,
+		 uint64_t expiry)
+{
+	__ASSERT_NO_MSG(expiry >= tw->base);
+
+	to->dticks = expiry;
+	tw_place(tw, to, expiry);
+
+	/* Equal expiries keep the cached (older) entry first */
+	if ((tw->next != NULL) && (expiry < z_tw_expiry(tw, tw->next))) {
+		tw->next = to;
+	}
+}
+
+void z_tw_remove(struct z_timeout_wheel *tw, struct _timeout *to)
+{
+	uint64_t expiry = z_tw_expiry(tw, to);
+	int lvl = tw_level(tw->base, expiry);
+
+	sys_dlist_remove(&to->node);
+
+	if (lvl < LEVELS) {
+		struct z_tw_level *l = &tw->levels[lvl];
+		int idx = tw_slot(lvl, expiry);
+
+		if (sys_dlist_is_empty(&l->slots[idx])) {
+			l->bitmask &= ~BIT64(idx);
+		}
+	} else if (sys_dlist_is_empty(&tw->overflow)) {
+		tw->overflow_used = false;
+	}
+
+	if (tw->next == to) {
+		tw->next = NULL;
+	}
+}
+
+/* Earliest entry of a slot, first inserted on ties */
+static struct _timeout *tw_earliest(struct z_timeout_wheel *tw,
+				    sys_dlist_t *list)
+{
+	struct _timeout *best = NULL, *t;
+	uint64_t best_expiry = UINT64_MAX;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(list, t, node) {
+		uint64_t expiry = z_tw_expiry(tw, t);
+
+		if (expiry < best_expiry) {
+			best = t;
+			best_expiry = expiry;
+		}
+	}
+
+	return best;
+}
+
+struct _timeout *z_tw_first(struct z_timeout_wheel *tw)
+{
+	if (tw->next != NULL) {
+		return tw->next;
+	}
+
+	for (int lvl = 0; lvl < LEVELS; lvl++) {
+		struct z_tw_level *l = &tw->levels[lvl];
+
+		if (l->bitmask != 0) {
+			sys_dlist_t *slot =
+				&l->slots[u64_count_trailing_zeros(l->bitmask)];
+
+			/* All entries of a level 0 slot share one expiry */
+			if (lvl == 0) {
+				tw->next = CONTAINER_OF(sys_dlist_peek_head(slot),
+							struct _timeout, node);
+			} else {
+				tw->next = tw_earliest(tw, slot);
+			}
+			return tw->next;
+		}
+	}
+
+	if (tw->overflow_used) {
+		tw->next = tw_earliest(tw, &tw->overflow);
+	}
+
+	return tw->next;
+}
+
+void z_tw_advance(struct z_timeout_wheel *tw, uint64_t now)
+{
+	int lvl;
+	sys_dlist_t cascade;
+	sys_dlist_t *src;
+	sys_dnode_t *node;
+
+	if (now <= tw->base) {
+		return;
+	}
+
+	lvl = tw_level(tw->base, now);
+	tw->base = now;
+
+	if (lvl == 0) {
+		return;
+	}
+
+	/* Nothing can be stored below the level in which the old and
+	 * new base differ (it would have expired already), so only
+	 * the one slot at that level which the new base has entered
+	 * needs re-filing.  Entries there land on lower levels.
+	 */
+	if (lvl < LEVELS) {
+		struct z_tw_level *l = &tw->levels[lvl];
+		int idx = tw_slot(lvl, now);
+
+		if ((l->bitmask & BIT64(idx)) == 0) {
+			return;
+		}
+		l->bitmask &= ~BIT64(idx);
+		src = &l->slots[idx];
+	} else {
+		if (!tw->overflow_used) {
+			return;
+		}
+		tw->overflow_used = false;
+		src = &tw->overflow;
+	}
+
+	/* Detach first: overflow entries may be re-filed to overflow */
+	sys_dlist_init(&cascade);
+	while ((node = sys_dlist_get(src)) != NULL) {
+		sys_dlist_append(&cascade, node);
+	}
+
+	while ((node = sys_dlist_get(&cascade)) != NULL) {
+		struct _timeout *t = CONTAINER_OF(node, struct _timeout, node);
+
+		tw_place(tw, t, z_tw_expiry(tw, t));
+	}
+}
@@ -59,6 +59,13 @@ void z_timer_expiration_handler(struct _timeout *t)
 		/* see note about z_add_timeout() in z_impl_k_timer_start() */
 		next.ticks = MAX(next.ticks - 1, 0);
 
+#ifdef CONFIG_TIMEOUT_SLACK
+		/* Stride from the requested expiry rather than from the
+		 * tick it was deferred to, so the slack does not add up
+		 */
+		next.ticks = MAX(next.ticks - (k_ticks_t)t->deferred, 0);
+#endif
+
 #ifdef CONFIG_TIMEOUT_64BIT
 		/* Exploit the fact that uptime during a kernel
 		 * timeout handler reflects the time of the scheduled
@@ -319,6 +326,17 @@ static inline k_ticks_t z_vrfy_k_timer_remaining_ticks(
 }
 #include <syscalls/k_timer_remaining_ticks_mrsh.c>
 
+#ifdef CONFIG_TIMEOUT_SLACK
+static inline void z_vrfy_k_timer_slack_set(struct k_timer *timer,
+					    k_timeout_t slack)
+{
+	K_OOPS(K_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	K_OOPS(K_SYSCALL_VERIFY(slack.ticks >= 0));
+	z_impl_k_timer_slack_set(timer, slack);
+}
+#include <syscalls/k_timer_slack_set_mrsh.c>
+#endif
+
 static inline k_ticks_t z_vrfy_k_timer_expires_ticks(
 						const struct k_timer *timer)
 {
@@ -10,6 +10,7 @@
 #include <ksched.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/math_extras.h>
 
 /* Need one of these for this to work */
 #if !defined(CONFIG_USE_SWITCH) && !defined(CONFIG_INSTRUMENT_THREAD_SWITCHING)
@@ -58,6 +59,63 @@ static void sched_cpu_update_usage(struct _cpu *cpu, uint32_t cycles)
 #define sched_cpu_update_usage(cpu, cycles)   do { } while (0)
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+void z_sched_latency_ready(struct k_thread *thread)
+{
+	thread->base.ready_stamp = usage_now();
+}
+
+static void latency_update(struct k_cycle_stats *stats, uint32_t cycles)
+{
+	uint32_t bucket = 0U;
+
+	if (cycles > 1U) {
+		bucket = MIN(31U - u32_count_leading_zeros(cycles),
+			     CONFIG_SCHED_THREAD_LATENCY_BUCKETS - 1U);
+	}
+
+	stats->latency[bucket]++;
+
+	if (stats->latency_max < cycles) {
+		stats->latency_max = cycles;
+	}
+}
+
+/* Accounts for the latency of a thread being switched in at [now] */
+static void sched_latency_update(struct _cpu *cpu, struct k_thread *thread,
+				 uint32_t now)
+{
+	uint32_t stamp = thread->base.ready_stamp;
+	uint32_t cycles;
+
+	if (stamp == 0U) {
+		return;
+	}
+
+	thread->base.ready_stamp = 0U;
+	cycles = now - stamp;
+
+	if (thread->base.usage.track_usage) {
+		latency_update(&thread->base.usage, cycles);
+	}
+
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	if (cpu->usage->track_usage) {
+		latency_update(cpu->usage, cycles);
+	}
+#else
+	ARG_UNUSED(cpu);
+#endif
+}
+
+static void latency_copy(struct k_thread_runtime_stats *stats,
+			 const struct k_cycle_stats *usage)
+{
+	memcpy(stats->latency, usage->latency, sizeof(stats->latency));
+	stats->latency_max = usage->latency_max;
+}
+#endif
+
 static void sched_thread_update_usage(struct k_thread *thread, uint32_t cycles)
 {
 	thread->base.usage.total += cycles;
@@ -85,7 +143,23 @@ void z_sched_usage_start(struct k_thread *thread)
 		thread->base.usage.current = 0;
 	}
 
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+	sched_latency_update(_current_cpu, thread, _current_cpu->usage0);
+#endif
+
 	k_spin_unlock(&usage_lock, key);
+#elif defined(CONFIG_SCHED_THREAD_LATENCY)
+	k_spinlock_key_t  key;
+
+	_current_cpu->usage0 = usage_now();
+
+	/* Only lock to update the histograms, not on every switch */
+	if (thread->base.ready_stamp != 0U) {
+		key = k_spin_lock(&usage_lock);
+		sched_latency_update(_current_cpu, thread,
+				     _current_cpu->usage0);
+		k_spin_unlock(&usage_lock, key);
+	}
 #else
 	/* One write through a volatile pointer doesn't require
 	 * synchronization as long as _usage() treats it as volatile
@@ -94,6 +168,10 @@ void z_sched_usage_start(struct k_thread *thread)
 
 	_current_cpu->usage0 = usage_now();
 #endif
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	z_sched_cbs_start(thread);
+#endif
 }
 
 void z_sched_usage_stop(void)
@@ -116,6 +194,10 @@ void z_sched_usage_stop(void)
 
 	cpu->usage0 = 0;
 	k_spin_unlock(&usage_lock, k);
+
+#ifdef CONFIG_SCHED_DEADLINE_CBS
+	z_sched_cbs_stop();
+#endif
 }
 
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
@@ -164,6 +246,10 @@ void z_sched_cpu_usage(uint8_t cpu_id, struct k_thread_runtime_stats *stats)
 	stats->idle_cycles =
 		_kernel.cpus[cpu_id].idle_thread->base.usage.total;
 
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+	latency_copy(stats, cpu->usage);
+#endif
+
 	stats->execution_cycles = stats->total_cycles + stats->idle_cycles;
 
 	k_spin_unlock(&usage_lock, key);
@@ -222,6 +308,10 @@ void z_sched_thread_usage(struct k_thread *thread,
 #endif
 	stats->execution_cycles = thread->base.usage.total;
 
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+	latency_copy(stats, &thread->base.usage);
+#endif
+
 	k_spin_unlock(&usage_lock, key);
 }
 
@@ -383,6 +473,10 @@ int z_thread_stats_reset(struct k_obj_core *obj_core)
 	stats->longest = 0ULL;
 	stats->num_windows = (thread->base.usage.track_usage) ?  1U : 0U;
 #endif
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+	memset(stats->latency, 0, sizeof(stats->latency));
+	stats->latency_max = 0U;
+#endif
 
 	if (thread != _current_cpu->current) {
 
@@ -77,6 +77,152 @@ static inline void init_flusher(struct z_work_flusher *flusher)
 	k_work_init(&flusher->work, handle_flush);
 }
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+
+/* Test whether a node of a pending list is a flusher, see struct
+ * z_work_flusher.
+ */
+static inline bool is_flusher(sys_snode_t *node)
+{
+	return CONTAINER_OF(node, struct k_work, node)->handler == handle_flush;
+}
+
+static inline void release_flusher(sys_snode_t *node)
+{
+	k_sem_give(&CONTAINER_OF(node, struct z_work_flusher, work.node)->sem);
+}
+
+/* Take the flushers that followed a work item just removed from a
+ * pending list.
+ *
+ * Invoked with work lock held.
+ *
+ * @param list the pending list
+ * @param prev the node that preceded the item, NULL if it was the head
+ * @param flushes the flushes of the worker that will run the item or is
+ * running it, or NULL to release the flushers because the item was
+ * removed without running
+ */
+static void take_flushes_locked(sys_slist_t *list, sys_snode_t *prev,
+				sys_slist_t *flushes)
+{
+	sys_snode_t *node = (prev != NULL) ? sys_slist_peek_next(prev) :
+		sys_slist_peek_head(list);
+
+	while ((node != NULL) && is_flusher(node)) {
+		sys_snode_t *next = sys_slist_peek_next(node);
+
+		sys_slist_remove(list, prev, node);
+		if (flushes != NULL) {
+			sys_slist_append(flushes, node);
+		} else {
+			release_flusher(node);
+		}
+		node = next;
+	}
+}
+
+/* Release the flushers waiting for the item a worker ran.
+ *
+ * Invoked with work lock held.
+ */
+static void release_flushes_locked(struct z_work_worker *worker)
+{
+	sys_snode_t *node;
+
+	while ((node = sys_slist_get(&worker->flushes)) != NULL) {
+		release_flusher(node);
+	}
+}
+
+/* Remove a work item, and the flushers following it, from a pending
+ * list.
+ *
+ * Invoked with work lock held.
+ *
+ * @param flushes as with take_flushes_locked()
+ *
+ * @return true if the item was found in the list
+ */
+static bool pending_remove_locked(sys_slist_t *list, struct k_work *work,
+				  sys_slist_t *flushes)
+{
+	sys_snode_t *prev = NULL;
+	sys_snode_t *node;
+
+	SYS_SLIST_FOR_EACH_NODE(list, node) {
+		if (node == &work->node) {
+			sys_slist_remove(list, prev, node);
+			take_flushes_locked(list, prev, flushes);
+			return true;
+		}
+		prev = node;
+	}
+
+	return false;
+}
+
+/* Find the worker of a queue animated by a thread, or NULL.
+ *
+ * Invoked with work lock held.
+ */
+static struct z_work_worker *worker_find_locked(struct k_work_q *queue,
+						struct k_thread *thread)
+{
+	struct z_work_worker *w;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, w, node) {
+		if (w->thread == thread) {
+			return w;
+		}
+	}
+
+	return NULL;
+}
+
+/* Find the worker of a queue running a work item, or NULL.
+ *
+ * Invoked with work lock held.
+ */
+static struct z_work_worker *worker_running_locked(struct k_work_q *queue,
+						   struct k_work *work)
+{
+	struct z_work_worker *w;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, w, node) {
+		if (w->running == work) {
+			return w;
+		}
+	}
+
+	return NULL;
+}
+
+/* Queue a flusher right behind a queued work item, in whichever
+ * pending list holds it.  The list only matters when the item is its
+ * tail.
+ *
+ * Invoked with work lock held.
+ */
+static void insert_flusher_locked(struct k_work_q *queue,
+				  struct k_work *work,
+				  struct z_work_flusher *flusher)
+{
+	sys_slist_t *list = &queue->pending;
+	struct z_work_worker *w;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, w, node) {
+		if (sys_slist_peek_tail(&w->pending) == &work->node) {
+			list = &w->pending;
+			break;
+		}
+	}
+
+	sys_slist_insert(list, &work->node, &flusher->work.node);
+}
+
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 /* List of pending cancellations. */
 static sys_slist_t pending_cancels;
 
@@ -168,6 +314,7 @@ int k_work_busy_get(const struct k_work *work)
  * queue
  * @param flusher an uninitialized/unused flusher object
  */
+#ifndef CONFIG_WORKQUEUE_WORKERS
 static void queue_flusher_locked(struct k_work_q *queue,
 				 struct k_work *work,
 				 struct z_work_flusher *flusher)
@@ -191,6 +338,7 @@ static void queue_flusher_locked(struct k_work_q *queue,
 		sys_slist_prepend(&queue->pending, &flusher->work.node);
 	}
 }
+#endif /* !CONFIG_WORKQUEUE_WORKERS */
 
 /* Try to remove a work item from the given queue.
  *
@@ -203,7 +351,26 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 				       struct k_work *work)
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
+#ifdef CONFIG_WORKQUEUE_WORKERS
+		/* Flushers of an item requeued while running now wait for
+		 * the running instance, the others are released.
+		 */
+		struct z_work_worker *w = flag_test(&work->flags,
+						    K_WORK_RUNNING_BIT) ?
+			worker_running_locked(queue, work) : NULL;
+		sys_slist_t *flushes = (w != NULL) ? &w->flushes : NULL;
+
+		if (!pending_remove_locked(&queue->pending, work, flushes)) {
+			SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, w, node) {
+				if (pending_remove_locked(&w->pending, work,
+							  flushes)) {
+					break;
+				}
+			}
+		}
+#else
 		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
+#endif
 	}
 }
 
@@ -243,20 +410,44 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
  *
  * @param work to be submitted
  *
+ * @param notify false if the caller notifies the queue itself, once it
+ * has submitted a batch of work
+ *
  * @retval 1 if successfully queued
  * @retval -EINVAL if no queue is provided
  * @retval -ENODEV if the queue is not started
  * @retval -EBUSY if the submission was rejected (draining, plugged)
  */
 static inline int queue_submit_locked(struct k_work_q *queue,
-				      struct k_work *work)
+				      struct k_work *work,
+				      bool notify)
 {
 	if (queue == NULL) {
 		return -EINVAL;
 	}
 
 	int ret = -EBUSY;
+	sys_slist_t *pending = &queue->pending;
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	/* A running item may only be requeued to the worker running it,
+	 * so it can't start on another one before completing.  Items
+	 * submitted by a worker's handlers stay local to that worker.
+	 */
+	struct z_work_worker *self = k_is_in_isr() ? NULL :
+		worker_find_locked(queue, _current);
+	struct z_work_worker *w = flag_test(&work->flags, K_WORK_RUNNING_BIT) ?
+		worker_running_locked(queue, work) : NULL;
+	bool chained = (self != NULL);
+
+	if (w == NULL) {
+		w = self;
+	}
+	if (w != NULL) {
+		pending = &w->pending;
+	}
+#else
 	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+#endif
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -274,9 +465,11 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else if (plugged && !draining) {
 		ret = -EBUSY;
 	} else {
-		sys_slist_append(&queue->pending, &work->node);
+		sys_slist_append(pending, &work->node);
 		ret = 1;
-		(void)notify_queue_locked(queue);
+		if (notify) {
+			(void)notify_queue_locked(queue);
+		}
 	}
 
 	return ret;
@@ -300,6 +493,8 @@ static inline int queue_submit_locked(struct k_work_q *queue,
  * the queue it was submitted to.  That may or may not be the queue provided
  * on input.
  *
+ * @param notify as with queue_submit_locked()
+ *
  * @retval 0 if work was already submitted to a queue
  * @retval 1 if work was not submitted and has been queued to @p queue
  * @retval 2 if work was running and has been queued to the queue that was
@@ -309,7 +504,8 @@ static inline int queue_submit_locked(struct k_work_q *queue,
  * @retval -ENODEV if the queue is not started
  */
 static int submit_to_queue_locked(struct k_work *work,
-				  struct k_work_q **queuep)
+				  struct k_work_q **queuep,
+				  bool notify)
 {
 	int ret = 0;
 
@@ -336,7 +532,7 @@ static int submit_to_queue_locked(struct k_work *work,
 			ret = 2;
 		}
 
-		int rc = queue_submit_locked(*queuep, work);
+		int rc = queue_submit_locked(*queuep, work, notify);
 
 		if (rc < 0) {
 			ret = rc;
@@ -374,7 +570,7 @@ int z_work_submit_to_queue(struct k_work_q *queue,
 
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	int ret = submit_to_queue_locked(work, &queue);
+	int ret = submit_to_queue_locked(work, &queue, true);
 
 	k_spin_unlock(&lock, key);
 
@@ -413,6 +609,58 @@ int k_work_submit(struct k_work *work)
 	return ret;
 }
 
+int k_work_submit_batch_to_queue(struct k_work_q *queue,
+				 struct k_work *const *work, size_t count)
+{
+	__ASSERT_NO_MSG((work != NULL) || (count == 0));
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, submit_batch_to_queue, queue, count);
+
+	struct k_work_q *notify = NULL;
+	int ret = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (size_t i = 0; i < count; i++) {
+		struct k_work_q *wq = queue;
+
+		__ASSERT_NO_MSG(work[i] != NULL);
+		__ASSERT_NO_MSG(work[i]->handler != NULL);
+
+		if (submit_to_queue_locked(work[i], &wq, false) <= 0) {
+			continue;
+		}
+
+		ret++;
+
+		/* Items may land on different queues (running items stay
+		 * on theirs, and a NULL queue means the last one used).
+		 * Wake the common one once at the end, others as we go.
+		 */
+		if ((notify == NULL) || (wq == notify)) {
+			notify = wq;
+		} else {
+			(void)notify_queue_locked(wq);
+		}
+	}
+
+	(void)notify_queue_locked(notify);
+
+	k_spin_unlock(&lock, key);
+
+	if (ret > 0) {
+		z_reschedule_unlocked();
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, submit_batch_to_queue, queue, count, ret);
+
+	return ret;
+}
+
+int k_work_submit_batch(struct k_work *const *work, size_t count)
+{
+	return k_work_submit_batch_to_queue(&k_sys_work_q, work, count);
+}
+
 /* Flush the work item if necessary.
  *
  * Flushing is necessary only if the work is either queued or running.
@@ -439,8 +687,21 @@ static bool work_flush_locked(struct k_work *work,
 
 		__ASSERT_NO_MSG(queue != NULL);
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+		init_flusher(flusher);
+		if (flag_test(&work->flags, K_WORK_QUEUED_BIT)) {
+			insert_flusher_locked(queue, work, flusher);
+		} else {
+			struct z_work_worker *w =
+				worker_running_locked(queue, work);
+
+			__ASSERT_NO_MSG(w != NULL);
+			sys_slist_append(&w->flushes, &flusher->work.node);
+		}
+#else
 		queue_flusher_locked(queue, work, flusher);
 		notify_queue_locked(queue);
+#endif
 	}
 
 	return need_flush;
@@ -593,34 +854,140 @@ bool k_work_cancel_sync(struct k_work *work,
 	return pending;
 }
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+
+/* Take the next work item for a worker of a queue, or NULL.
+ *
+ * The worker's own pending list goes first, then the items submitted
+ * to the queue from outside, and finally the worker steals from the
+ * pending lists of the other workers.  Items that were requeued while
+ * running stay with the worker running them.  The flushers following
+ * the item move to the worker's flushes.
+ *
+ * Invoked with work lock held.
+ */
+static struct k_work *worker_take_locked(struct k_work_q *queue,
+					 struct z_work_worker *worker)
+{
+	sys_slist_t *list = &worker->pending;
+	struct z_work_worker *w;
+	struct k_work *work;
+	sys_snode_t *prev;
+	sys_snode_t *node;
+
+	node = sys_slist_get(list);
+	if (node == NULL) {
+		list = &queue->pending;
+		node = sys_slist_get(list);
+	}
+	if (node != NULL) {
+		take_flushes_locked(list, NULL, &worker->flushes);
+		return CONTAINER_OF(node, struct k_work, node);
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, w, node) {
+		if (w == worker) {
+			continue;
+		}
+
+		prev = NULL;
+		SYS_SLIST_FOR_EACH_NODE(&w->pending, node) {
+			work = CONTAINER_OF(node, struct k_work, node);
+			if (!flag_test(&work->flags, K_WORK_RUNNING_BIT) &&
+			    !is_flusher(node)) {
+				sys_slist_remove(&w->pending, prev, node);
+				take_flushes_locked(&w->pending, prev,
+						    &worker->flushes);
+				return work;
+			}
+			prev = node;
+		}
+	}
+
+	return NULL;
+}
+
+/* Test whether any work is pending on a queue.
+ *
+ * Invoked with work lock held.
+ */
+static bool queue_has_pending_locked(struct k_work_q *queue)
+{
+	struct z_work_worker *w;
+
+	if (!sys_slist_is_empty(&queue->pending)) {
+		return true;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, w, node) {
+		if (!sys_slist_is_empty(&w->pending)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#else
+
+static inline bool queue_has_pending_locked(struct k_work_q *queue)
+{
+	return !sys_slist_is_empty(&queue->pending);
+}
+
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 /* Loop executed by a work queue thread.
  *
  * @param workq_ptr pointer to the work queue structure
+ * @param p2 pointer to the worker animated by the thread, if the queue
+ * has several worker threads
  */
 static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 {
-	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
 	struct k_work_q *queue = (struct k_work_q *)workq_ptr;
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	struct z_work_worker *worker = p2;
+#else
+	ARG_UNUSED(p2);
+#endif
 
 	while (true) {
-		sys_snode_t *node;
 		struct k_work *work = NULL;
 		k_work_handler_t handler = NULL;
 		k_spinlock_key_t key = k_spin_lock(&lock);
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
+#ifdef CONFIG_WORKQUEUE_WORKERS
+		work = worker_take_locked(queue, worker);
+#else
+		sys_snode_t *node = sys_slist_get(&queue->pending);
+
 		if (node != NULL) {
+			work = CONTAINER_OF(node, struct k_work, node);
+		}
+#endif
+		if (work != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
 			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
-			work = CONTAINER_OF(node, struct k_work, node);
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
+#ifdef CONFIG_WORKQUEUE_WORKERS
+			worker->running = work;
+			queue->nbusy += 1U;
+
+			/* Submitters wake a single worker, so pass the
+			 * rest of a batch on to the next idle one.
+			 */
+			if (queue_has_pending_locked(queue)) {
+				(void)notify_queue_locked(queue);
+			}
+#endif
 
 			/* Static code analysis tool can raise a false-positive violation
 			 * in the line below that 'work' is checked for null after being
@@ -635,6 +1002,12 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * This means that if node is not NULL, then work will not be NULL.
 			 */
 			handler = work->handler;
+		} else if (IS_ENABLED(CONFIG_WORKQUEUE_WORKERS) &&
+			   flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT)) {
+			/* Another worker is still running an item, and the
+			 * last one to finish completes any drain.
+			 */
+			;
 		} else if (flag_test_and_clear(&queue->flags,
 					       K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
@@ -683,7 +1056,16 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			finalize_cancel_locked(work);
 		}
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+		worker->running = NULL;
+		release_flushes_locked(worker);
+		queue->nbusy -= 1U;
+		if (queue->nbusy == 0U) {
+			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		}
+#else
 		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+#endif
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -723,6 +1105,15 @@ void k_work_queue_start(struct k_work_q *queue,
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+#ifdef CONFIG_WORKQUEUE_WORKERS
+	sys_slist_init(&queue->workers);
+	sys_slist_init(&queue->primary.pending);
+	queue->primary.running = NULL;
+	sys_slist_init(&queue->primary.flushes);
+	queue->primary.thread = &queue->thread;
+	sys_slist_append(&queue->workers, &queue->primary.node);
+	queue->nbusy = 0U;
+#endif
 
 	if ((cfg != NULL) && cfg->no_yield) {
 		flags |= K_WORK_QUEUE_NO_YIELD;
@@ -735,8 +1126,10 @@ void k_work_queue_start(struct k_work_q *queue,
 	flags_set(&queue->flags, flags);
 
 	(void)k_thread_create(&queue->thread, stack, stack_size,
-			      work_queue_main, queue, NULL, NULL,
-			      prio, 0, K_FOREVER);
+			      work_queue_main, queue,
+			      COND_CODE_1(CONFIG_WORKQUEUE_WORKERS,
+					  (&queue->primary), (NULL)),
+			      NULL, prio, 0, K_FOREVER);
 
 	if ((cfg != NULL) && (cfg->name != NULL)) {
 		k_thread_name_set(&queue->thread, cfg->name);
@@ -747,6 +1140,60 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_WORKERS
+int k_work_queue_add_worker(struct k_work_q *queue,
+			    struct k_work_q_worker *worker,
+			    k_thread_stack_t *stack,
+			    size_t stack_size,
+			    int cpu)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(worker);
+	__ASSERT_NO_MSG(stack);
+
+	struct z_work_worker *w = &worker->worker;
+
+	if (!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT)) {
+		return -ENODEV;
+	}
+
+	if ((cpu >= 0) && !IS_ENABLED(CONFIG_SCHED_CPU_MASK)) {
+		return -ENOTSUP;
+	}
+
+	sys_slist_init(&w->pending);
+	w->running = NULL;
+	sys_slist_init(&w->flushes);
+	w->thread = &worker->thread;
+
+	(void)k_thread_create(&worker->thread, stack, stack_size,
+			      work_queue_main, queue, w, NULL,
+			      queue->thread.base.prio, 0,
+			      K_FOREVER);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (cpu >= 0) {
+		int ret = k_thread_cpu_pin(&worker->thread, cpu);
+
+		if (ret != 0) {
+			k_thread_abort(&worker->thread);
+			return ret;
+		}
+	}
+#endif
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	sys_slist_append(&queue->workers, &w->node);
+
+	k_spin_unlock(&lock, key);
+
+	k_thread_start(&worker->thread);
+
+	return 0;
+}
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -761,7 +1208,7 @@ int k_work_queue_drain(struct k_work_q *queue,
 	if (((flags_get(&queue->flags)
 	      & (K_WORK_QUEUE_BUSY | K_WORK_QUEUE_DRAIN)) != 0U)
 	    || plug
-	    || !sys_slist_is_empty(&queue->pending)) {
+	    || queue_has_pending_locked(queue)) {
 		flag_set(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 		if (plug) {
 			flag_set(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
@@ -824,7 +1271,7 @@ static void work_timeout(struct _timeout *to)
 	 */
 	if (flag_test_and_clear(&wp->flags, K_WORK_DELAYED_BIT)) {
 		queue = dw->queue;
-		(void)submit_to_queue_locked(wp, &queue);
+		(void)submit_to_queue_locked(wp, &queue, true);
 	}
 
 	k_spin_unlock(&lock, key);
@@ -892,7 +1339,7 @@ static int schedule_for_queue_locked(struct k_work_q **queuep,
 	struct k_work *work = &dwork->work;
 
 	if (K_TIMEOUT_EQ(delay, K_NO_WAIT)) {
-		return submit_to_queue_locked(work, queuep);
+		return submit_to_queue_locked(work, queuep, true);
 	}
 
 	flag_set(&work->flags, K_WORK_DELAYED_BIT);
@@ -1039,6 +1486,31 @@ int k_work_cancel_delayable(struct k_work_delayable *dwork)
 	return ret;
 }
 
+int k_work_cancel_delayable_batch(struct k_work_delayable *const *dwork,
+				  size_t count)
+{
+	__ASSERT_NO_MSG((dwork != NULL) || (count == 0));
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, cancel_delayable_batch, count);
+
+	int ret = 0;
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (size_t i = 0; i < count; i++) {
+		__ASSERT_NO_MSG(dwork[i] != NULL);
+
+		if (cancel_delayable_async_locked(dwork[i]) != 0) {
+			ret++;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, cancel_delayable_batch, count, ret);
+
+	return ret;
+}
+
 bool k_work_cancel_delayable_sync(struct k_work_delayable *dwork,
 				  struct k_work_sync *sync)
 {
@@ -1102,7 +1574,7 @@ bool k_work_flush_delayable(struct k_work_delayable *dwork,
 	if (unschedule_locked(dwork)) {
 		struct k_work_q *queue = dwork->queue;
 
-		(void)submit_to_queue_locked(work, &queue);
+		(void)submit_to_queue_locked(work, &queue, true);
 	}
 
 	/* Wait for it to finish */
@@ -268,3 +268,175 @@ int ring_buf_item_get(struct ring_buf *buf, uint16_t *type, uint8_t *value,
 
 	return 0;
 }
+
+/*
+ * Multi-producer multi-consumer ring buffer. Each slot carries a sequence
+ * number telling which lap of which side it is waiting for: a slot at
+ * position pos is free for the writer claiming pos when its sequence is
+ * pos, and holds an item for the reader claiming pos when it is pos + 1.
+ * Writers and readers claim positions with a compare-and-swap of put_pos
+ * and get_pos, and hand the slot over by advancing its sequence.
+ *
+ * The sequence stored is less the slot index, so that a zeroed slot array
+ * is an empty ring buffer.
+ */
+static inline int32_t mpmc_slot_lag(struct ring_buf_mpmc *buf, uint32_t idx,
+				    atomic_val_t pos)
+{
+	uint32_t seq = (uint32_t)atomic_get(&buf->slots[idx].seq) + idx;
+
+	return (int32_t)(seq - (uint32_t)pos);
+}
+
+static inline int mpmc_slot_index(struct ring_buf_mpmc *buf, uint8_t *data,
+				  uint32_t *idx)
+{
+	uintptr_t offset = (uintptr_t)(data - buf->buffer);
+
+	if (unlikely(data < buf->buffer ||
+		     offset >= (uintptr_t)buf->item_size * (buf->mask + 1) ||
+		     offset % buf->item_size != 0)) {
+		return -EINVAL;
+	}
+
+	*idx = offset / buf->item_size;
+
+	return 0;
+}
+
+uint32_t ring_buf_mpmc_put_claim(struct ring_buf_mpmc *buf, uint8_t **data,
+				 uint32_t size)
+{
+	atomic_val_t pos;
+	uint32_t idx;
+	int32_t lag;
+
+	if (size == 0) {
+		return 0;
+	}
+
+	pos = atomic_get(&buf->put_pos);
+	while (true) {
+		idx = (uint32_t)pos & buf->mask;
+		lag = mpmc_slot_lag(buf, idx, pos);
+		if (lag == 0) {
+			if (atomic_cas(&buf->put_pos, pos, pos + 1)) {
+				break;
+			}
+		} else if (lag < 0) {
+			/* Slot still holds the item from the previous lap */
+			return 0;
+		}
+		/* Another writer got the slot first */
+		pos = atomic_get(&buf->put_pos);
+	}
+
+	*data = &buf->buffer[idx * buf->item_size];
+
+	return MIN(size, buf->item_size);
+}
+
+int ring_buf_mpmc_put_finish(struct ring_buf_mpmc *buf, uint8_t *data,
+			     uint32_t size)
+{
+	uint32_t idx;
+
+	if (mpmc_slot_index(buf, data, &idx) != 0 || size > buf->item_size) {
+		return -EINVAL;
+	}
+
+	buf->slots[idx].size = size;
+	(void)atomic_inc(&buf->slots[idx].seq);
+
+	return 0;
+}
+
+uint32_t ring_buf_mpmc_put(struct ring_buf_mpmc *buf, const uint8_t *data,
+			   uint32_t size)
+{
+	uint8_t *dst;
+	int err;
+
+	size = ring_buf_mpmc_put_claim(buf, &dst, size);
+	if (size == 0) {
+		return 0;
+	}
+
+	memcpy(dst, data, size);
+
+	err = ring_buf_mpmc_put_finish(buf, dst, size);
+	__ASSERT_NO_MSG(err == 0);
+	ARG_UNUSED(err);
+
+	return size;
+}
+
+uint32_t ring_buf_mpmc_get_claim(struct ring_buf_mpmc *buf, uint8_t **data)
+{
+	atomic_val_t pos;
+	uint32_t idx, size;
+	int32_t lag;
+
+	pos = atomic_get(&buf->get_pos);
+	while (true) {
+		idx = (uint32_t)pos & buf->mask;
+		lag = mpmc_slot_lag(buf, idx, pos + 1);
+		if (lag == 0) {
+			if (atomic_cas(&buf->get_pos, pos, pos + 1)) {
+				size = buf->slots[idx].size;
+				if (size != 0) {
+					break;
+				}
+				/* Dropped item, release it and go on */
+				(void)atomic_add(&buf->slots[idx].seq,
+						 buf->mask);
+			}
+		} else if (lag < 0) {
+			/* Slot not written yet */
+			return 0;
+		}
+		pos = atomic_get(&buf->get_pos);
+	}
+
+	*data = &buf->buffer[idx * buf->item_size];
+
+	return size;
+}
+
+int ring_buf_mpmc_get_finish(struct ring_buf_mpmc *buf, uint8_t *data)
+{
+	uint32_t idx;
+
+	if (mpmc_slot_index(buf, data, &idx) != 0) {
+		return -EINVAL;
+	}
+
+	/* From pos + 1 to pos + capacity, the next lap's writer */
+	(void)atomic_add(&buf->slots[idx].seq, buf->mask);
+
+	return 0;
+}
+
+uint32_t ring_buf_mpmc_get(struct ring_buf_mpmc *buf, uint8_t *data,
+			   uint32_t size)
+{
+	uint8_t *src;
+	uint32_t item_size;
+	int err;
+
+	item_size = ring_buf_mpmc_get_claim(buf, &src);
+	if (item_size == 0) {
+		return 0;
+	}
+
+	size = MIN(size, item_size);
+	if (data) {
+		memcpy(data, src, size);
+	}
+
+	err = ring_buf_mpmc_get_finish(buf, src);
+	__ASSERT_NO_MSG(err == 0);
+	ARG_UNUSED(err);
+
+	return size;
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Aging eviction algorithm for demand paging
+ */
+#include <zephyr/kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+#include <zephyr/kernel/mm/demand_paging.h>
+
+/* Each page frame has an 8-bit age counter. A periodic timer shifts all
+ * counters right by one and moves the accessed bit of the page into the
+ * top bit, clearing the accessed bit in the page tables. The counter
+ * thus holds the access history of the last 8 periods, most recent
+ * first, and a lower value means less recently used.
+ *
+ * When a page frame needs to be evicted, the one with the lowest age
+ * is picked, counting a still set accessed bit as one more period of
+ * history. Among page frames of equal age a clean one is preferred.
+ */
+static uint8_t ages[Z_NUM_PAGE_FRAMES];
+
+static void aging_periodic_update(struct k_timer *timer)
+{
+	uintptr_t phys, flags;
+	struct z_page_frame *pf;
+	unsigned int key = irq_lock();
+
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		uint8_t *age = &ages[pf - z_page_frames];
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		flags = arch_page_info_get(pf->addr, NULL, true);
+		*age = (*age >> 1) |
+		       (((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) ? 0x80 : 0);
+	}
+
+	irq_unlock(key);
+}
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	unsigned int last_prec = UINT_MAX;
+	struct z_page_frame *last_pf = NULL, *pf;
+	bool accessed;
+	bool last_accessed = false;
+	bool last_dirty = false;
+	bool dirty = false;
+	uintptr_t flags, phys;
+
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		unsigned int prec;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		flags = arch_page_info_get(pf->addr, NULL, false);
+		accessed = (flags & ARCH_DATA_PAGE_ACCESSED) != 0UL;
+		dirty = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		/* 9 bits of history, then the dirty state */
+		prec = (((accessed ? 0x100U : 0U) | ages[pf - z_page_frames])
+			<< 1) | (dirty ? 1U : 0U);
+		if (prec == 0) {
+			/* Unused for 8 periods and clean, can't do better */
+			last_pf = pf;
+			last_accessed = accessed;
+			last_dirty = dirty;
+			break;
+		}
+
+		if (prec < last_prec) {
+			last_prec = prec;
+			last_pf = pf;
+			last_accessed = accessed;
+			last_dirty = dirty;
+		}
+	}
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(last_pf != NULL, "no page to evict");
+
+	if (last_pf != NULL) {
+		/* The page frame starts over with the page paged into it */
+		ages[last_pf - z_page_frames] = 0U;
+	}
+
+	*dirty_ptr = last_dirty;
+	k_mem_paging_eviction_accessed(last_accessed);
+
+	return last_pf;
+}
+
+static K_TIMER_DEFINE(aging_timer, aging_periodic_update, NULL);
+
+void k_mem_paging_eviction_init(void)
+{
+	k_timer_start(&aging_timer, K_NO_WAIT,
+		      K_MSEC(CONFIG_EVICTION_AGING_PERIOD));
+}
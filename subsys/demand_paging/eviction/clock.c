@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * CLOCK (second chance) eviction algorithm for demand paging
+ */
+#include <zephyr/kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+#include <zephyr/kernel/mm/demand_paging.h>
+
+/* The page frames form a circle with a hand pointing at the next one to
+ * look at. A page frame whose accessed bit is set gets a second chance:
+ * the bit is cleared and the hand moves on. The first page frame found
+ * with the bit clear is evicted. This approximates LRU, as a page has to
+ * go unused for a full turn of the hand to be evicted.
+ *
+ * Two turns are always enough, as the first one clears the accessed bit
+ * of every evictable page frame. A page frame is only evicted while its
+ * page is marked as recently accessed when it takes the second turn: it
+ * was passed over for that reason on the first one.
+ */
+static struct z_page_frame *hand = z_page_frames;
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *pf;
+	uintptr_t flags;
+
+	for (size_t n = 0; n < 2 * Z_NUM_PAGE_FRAMES; n++) {
+		pf = hand;
+		hand = (hand == &z_page_frames[Z_NUM_PAGE_FRAMES - 1]) ?
+		       z_page_frames : hand + 1;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		/* Read and clear the accessed bit */
+		flags = arch_page_info_get(pf->addr, NULL, true);
+
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) == 0UL) {
+			*dirty_ptr = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+			k_mem_paging_eviction_accessed(n >= Z_NUM_PAGE_FRAMES);
+			return pf;
+		}
+	}
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(false, "no page to evict");
+
+	return NULL;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+}
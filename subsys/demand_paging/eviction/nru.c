@@ -47,6 +47,7 @@ struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
 	unsigned int last_prec = 4U;
 	struct z_page_frame *last_pf = NULL, *pf;
 	bool accessed;
+	bool last_accessed = false;
 	bool last_dirty = false;
 	bool dirty = false;
 	uintptr_t flags, phys;
@@ -74,6 +75,7 @@ struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
 		if (prec == 0) {
 			/* If we find a not accessed, clean page we're done */
 			last_pf = pf;
+			last_accessed = accessed;
 			last_dirty = dirty;
 			break;
 		}
@@ -81,6 +83,7 @@ struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
 		if (prec < last_prec) {
 			last_prec = prec;
 			last_pf = pf;
+			last_accessed = accessed;
 			last_dirty = dirty;
 		}
 	}
@@ -88,6 +91,7 @@ struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
 	__ASSERT(last_pf != NULL, "no page to evict");
 
 	*dirty_ptr = last_dirty;
+	k_mem_paging_eviction_accessed(last_accessed);
 
 	return last_pf;
 }
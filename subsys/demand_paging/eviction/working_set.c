@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Working set (WSClock) eviction algorithm for demand paging
+ */
+#include <zephyr/kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+#include <zephyr/kernel/mm/demand_paging.h>
+
+/* Each page frame remembers when its page was last seen accessed, as
+ * sampled by a periodic timer and by the eviction hand itself. A page
+ * not accessed for longer than CONFIG_EVICTION_WORKING_SET_WINDOW
+ * milliseconds has left the working set and may be evicted.
+ *
+ * The page frames are scanned clock-wise from where the last scan left
+ * off. The first clean page outside the working set is evicted right
+ * away. Otherwise the first dirty page outside the working set is
+ * evicted, and if every page is in the working set, the least recently
+ * used one.
+ */
+static uint32_t last_used[Z_NUM_PAGE_FRAMES];
+static struct z_page_frame *hand = z_page_frames;
+
+static void ws_periodic_update(struct k_timer *timer)
+{
+	uintptr_t phys, flags;
+	struct z_page_frame *pf;
+	uint32_t now = k_uptime_get_32();
+	unsigned int key = irq_lock();
+
+	Z_PAGE_FRAME_FOREACH(phys, pf) {
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		flags = arch_page_info_get(pf->addr, NULL, true);
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			last_used[pf - z_page_frames] = now;
+		}
+	}
+
+	irq_unlock(key);
+}
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *pf, *old_pf = NULL, *lru_pf = NULL;
+	uint32_t now = k_uptime_get_32();
+	uint32_t age, lru_age = 0U;
+	bool lru_accessed = false;
+	bool lru_dirty = false;
+	bool accessed;
+	bool dirty;
+	uintptr_t flags;
+
+	for (size_t n = 0; n < Z_NUM_PAGE_FRAMES; n++) {
+		pf = hand;
+		hand = (hand == &z_page_frames[Z_NUM_PAGE_FRAMES - 1]) ?
+		       z_page_frames : hand + 1;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		/* Read and clear the accessed bit */
+		flags = arch_page_info_get(pf->addr, NULL, true);
+		accessed = (flags & ARCH_DATA_PAGE_ACCESSED) != 0UL;
+		dirty = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if (accessed) {
+			last_used[pf - z_page_frames] = now;
+		}
+
+		/* Pages outside the working set weren't accessed just now */
+		age = now - last_used[pf - z_page_frames];
+		if (age > CONFIG_EVICTION_WORKING_SET_WINDOW) {
+			if (!dirty) {
+				*dirty_ptr = false;
+				k_mem_paging_eviction_accessed(false);
+				goto out;
+			}
+			if (old_pf == NULL) {
+				old_pf = pf;
+			}
+		}
+
+		if (lru_pf == NULL || age > lru_age) {
+			lru_pf = pf;
+			lru_age = age;
+			lru_accessed = accessed;
+			lru_dirty = dirty;
+		}
+	}
+
+	if (old_pf != NULL) {
+		/* No clean page outside the working set, take the first
+		 * dirty one
+		 */
+		pf = old_pf;
+		*dirty_ptr = true;
+		k_mem_paging_eviction_accessed(false);
+	} else {
+		/* Everything is in the working set */
+		pf = lru_pf;
+		*dirty_ptr = lru_dirty;
+		k_mem_paging_eviction_accessed(lru_accessed);
+	}
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(pf != NULL, "no page to evict");
+	if (pf == NULL) {
+		return NULL;
+	}
+
+	hand = (pf == &z_page_frames[Z_NUM_PAGE_FRAMES - 1]) ?
+	       z_page_frames : pf + 1;
+out:
+	/* The page paged into this page frame is about to be used */
+	last_used[pf - z_page_frames] = now;
+
+	return pf;
+}
+
+static K_TIMER_DEFINE(ws_timer, ws_periodic_update, NULL);
+
+void k_mem_paging_eviction_init(void)
+{
+	k_timer_start(&ws_timer, K_NO_WAIT,
+		      K_MSEC(CONFIG_EVICTION_WORKING_SET_PERIOD));
+}
@@ -18,6 +18,8 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #include <errno.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/sys_heap.h>
 
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
@@ -57,8 +59,17 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 /** Remote address specified */
 #define NET_CONN_LOCAL_ADDR_SPEC	BIT(6)
 
+/** Connection is indexed in the hash table */
+#define NET_CONN_HASHED			BIT(7)
+
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+/** All of the remote and local address and port specified */
+#define NET_CONN_EXACT			(NET_CONN_REMOTE_ADDR_SPEC | \
+					 NET_CONN_REMOTE_PORT_SPEC | \
+					 NET_CONN_LOCAL_ADDR_SPEC | \
+					 NET_CONN_LOCAL_PORT_SPEC)
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
@@ -116,6 +127,177 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+#if defined(CONFIG_NET_CONN_HASH)
+/* A fully specified connection has the highest rank, so it is the best
+ * match of a unicast packet with its 4-tuple. These connections are
+ * indexed by their 4-tuple and the other UDP and TCP connections with a
+ * local port by their protocol and local port, chained through hash_next
+ * in the same order as in conn_used. The remaining UDP and TCP
+ * connections are chained in conn_wild. The hash table and the chains
+ * are protected by conn_lock.
+ */
+#define CONN_HASH_HEAP_SIZE (CONFIG_NET_MAX_CONN * \
+			     (2 * sizeof(uint64_t) + 12 * sizeof(void *)) + 256)
+
+static uint8_t conn_hash_mem[CONN_HASH_HEAP_SIZE] __aligned(8);
+static struct sys_heap conn_hash_heap;
+static struct net_conn *conn_wild;
+
+static void *conn_hash_alloc(void *ptr, size_t size)
+{
+	if (size == 0) {
+		sys_heap_free(&conn_hash_heap, ptr);
+		return NULL;
+	}
+
+	return sys_heap_realloc(&conn_hash_heap, ptr, size);
+}
+
+SYS_HASHMAP_SC_DEFINE_STATIC_ADVANCED(conn_map, sys_hash32_murmur3,
+				      conn_hash_alloc,
+				      SYS_HASHMAP_CONFIG(CONFIG_NET_MAX_CONN,
+							 SYS_HASHMAP_DEFAULT_LOAD_FACTOR));
+
+static inline uint64_t conn_hash_port_key(uint16_t proto, uint16_t local_port)
+{
+	return ((uint64_t)proto << 16) | local_port;
+}
+
+/* Ports are in network byte order */
+static uint64_t conn_hash_exact_key(uint16_t proto,
+				    const uint8_t *remote_addr,
+				    const uint8_t *local_addr,
+				    size_t addr_len,
+				    uint16_t remote_port,
+				    uint16_t local_port)
+{
+	uint8_t buf[1 + 2 * sizeof(struct in6_addr)];
+	uint32_t hash;
+
+	buf[0] = (uint8_t)proto;
+	memcpy(&buf[1], remote_addr, addr_len);
+	memcpy(&buf[1 + addr_len], local_addr, addr_len);
+
+	hash = sys_hash32_murmur3(buf, 1 + 2 * addr_len);
+
+	/* The top bit keeps exact keys apart from port keys */
+	return BIT64(63) | ((uint64_t)hash << 32) |
+		((uint32_t)remote_port << 16) | local_port;
+}
+
+static bool conn_hash_key(struct net_conn *conn, uint64_t *key)
+{
+	uint16_t remote_port = net_sin(&conn->remote_addr)->sin_port;
+	uint16_t local_port = net_sin(&conn->local_addr)->sin_port;
+
+	if ((conn->flags & NET_CONN_EXACT) == NET_CONN_EXACT) {
+		if (IS_ENABLED(CONFIG_NET_IPV6) && conn->family == AF_INET6) {
+			*key = conn_hash_exact_key(
+				conn->proto,
+				net_sin6(&conn->remote_addr)->sin6_addr.s6_addr,
+				net_sin6(&conn->local_addr)->sin6_addr.s6_addr,
+				sizeof(struct in6_addr),
+				remote_port, local_port);
+			return true;
+		} else if (IS_ENABLED(CONFIG_NET_IPV4) && conn->family == AF_INET) {
+			*key = conn_hash_exact_key(
+				conn->proto,
+				net_sin(&conn->remote_addr)->sin_addr.s4_addr,
+				net_sin(&conn->local_addr)->sin_addr.s4_addr,
+				sizeof(struct in_addr),
+				remote_port, local_port);
+			return true;
+		}
+	}
+
+	if (conn->flags & NET_CONN_LOCAL_PORT_SPEC) {
+		*key = conn_hash_port_key(conn->proto, local_port);
+		return true;
+	}
+
+	return false;
+}
+
+static bool conn_is_hashable(struct net_conn *conn)
+{
+	return (conn->proto == IPPROTO_UDP || conn->proto == IPPROTO_TCP) &&
+		(conn->family == AF_INET || conn->family == AF_INET6 ||
+		 conn->family == AF_UNSPEC);
+}
+
+static void conn_chain_remove(struct net_conn **head, struct net_conn *conn)
+{
+	struct net_conn **prev;
+
+	for (prev = head; *prev != NULL; prev = &(*prev)->hash_next) {
+		if (*prev == conn) {
+			*prev = conn->hash_next;
+			break;
+		}
+	}
+}
+
+static void conn_hash_add(struct net_conn *conn)
+{
+	uint64_t head = 0U;
+	uint64_t key;
+
+	if (!conn_is_hashable(conn)) {
+		return;
+	}
+
+	if (conn_hash_key(conn, &key)) {
+		(void)sys_hashmap_get(&conn_map, key, &head);
+
+		if (sys_hashmap_insert(&conn_map, key, POINTER_TO_UINT(conn),
+				       NULL) >= 0) {
+			conn->hash_next = (struct net_conn *)(uintptr_t)head;
+			conn->hash_key = key;
+			conn->flags |= NET_CONN_HASHED;
+			return;
+		}
+
+		NET_DBG("[%p] cannot hash connection", conn);
+	}
+
+	conn->hash_next = conn_wild;
+	conn_wild = conn;
+}
+
+static void conn_hash_remove(struct net_conn *conn)
+{
+	struct net_conn *head;
+	uint64_t value;
+
+	if (!conn_is_hashable(conn)) {
+		return;
+	}
+
+	if (!(conn->flags & NET_CONN_HASHED)) {
+		conn_chain_remove(&conn_wild, conn);
+		return;
+	}
+
+	if (!sys_hashmap_get(&conn_map, conn->hash_key, &value)) {
+		return;
+	}
+
+	head = (struct net_conn *)(uintptr_t)value;
+	conn_chain_remove(&head, conn);
+
+	if (head == NULL) {
+		(void)sys_hashmap_remove(&conn_map, conn->hash_key, NULL);
+	} else {
+		/* Replacing the value of a key does not allocate */
+		(void)sys_hashmap_insert(&conn_map, conn->hash_key,
+					 POINTER_TO_UINT(head), NULL);
+	}
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_remove(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -141,6 +323,7 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	conn_hash_add(conn);
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -415,6 +598,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	conn_hash_remove(conn);
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -495,6 +679,135 @@ static bool conn_addr_cmp(struct net_pkt *pkt,
 	return true;
 }
 
+static bool conn_ip_match(struct net_conn *conn, struct net_pkt *pkt,
+			  union net_ip_header *ip_hdr,
+			  uint16_t src_port, uint16_t dst_port)
+{
+	if (net_sin(&conn->remote_addr)->sin_port &&
+	    net_sin(&conn->remote_addr)->sin_port != src_port) {
+		return false; /* wrong remote port */
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port &&
+	    net_sin(&conn->local_addr)->sin_port != dst_port) {
+		return false; /* wrong local port */
+	}
+
+	if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+		return false; /* wrong remote address */
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+
+		/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
+		 * has no IPV6_V6ONLY option set and if the local IPV6 address
+		 * is unspecified, then we could accept a connection from IPv4
+		 * address by mapping it to IPv6 address.
+		 */
+		if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
+			if (!(conn->family == AF_INET6 &&
+			      net_pkt_family(pkt) == AF_INET &&
+			      !conn->v6only &&
+			      net_ipv6_is_addr_unspecified(
+				      &net_sin6(&conn->local_addr)->sin6_addr))) {
+				return false; /* wrong local address */
+			}
+		} else {
+			return false; /* wrong local address */
+		}
+
+		/* We might have a match for v4-to-v6 mapping */
+	}
+
+	return true;
+}
+
+#if defined(CONFIG_NET_CONN_HASH)
+static bool conn_hash_match(struct net_conn *conn, struct net_pkt *pkt,
+			    union net_ip_header *ip_hdr, uint8_t proto,
+			    uint16_t src_port, uint16_t dst_port)
+{
+	uint8_t pkt_family = net_pkt_family(pkt);
+
+	if (conn->context != NULL &&
+	    net_context_is_bound_to_iface(conn->context) &&
+	    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+		return false; /* wrong interface */
+	}
+
+	if (conn->family != AF_UNSPEC && conn->family != pkt_family &&
+	    !(IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6) &&
+	      conn->family == AF_INET6 && pkt_family == AF_INET &&
+	      !conn->v6only)) {
+		return false; /* wrong protocol family */
+	}
+
+	return conn->proto == proto &&
+		conn_ip_match(conn, pkt, ip_hdr, src_port, dst_port);
+}
+
+/* Find the best match of a unicast UDP or TCP packet, like the scan of
+ * conn_used in net_conn_input() would.
+ */
+static struct net_conn *conn_hash_find(struct net_pkt *pkt,
+				       union net_ip_header *ip_hdr,
+				       uint8_t proto,
+				       uint16_t src_port, uint16_t dst_port)
+{
+	struct net_conn *chains[] = { NULL, conn_wild };
+	struct net_conn *best_match = NULL;
+	int16_t best_rank = -1;
+	struct net_conn *conn;
+	uint64_t value;
+	uint64_t key;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		key = conn_hash_exact_key(proto, ip_hdr->ipv6->src,
+					  ip_hdr->ipv6->dst,
+					  sizeof(struct in6_addr),
+					  src_port, dst_port);
+	} else {
+		key = conn_hash_exact_key(proto, ip_hdr->ipv4->src,
+					  ip_hdr->ipv4->dst,
+					  sizeof(struct in_addr),
+					  src_port, dst_port);
+	}
+
+	/* No other connection can rank higher than a fully specified one */
+	if (sys_hashmap_get(&conn_map, key, &value)) {
+		for (conn = (struct net_conn *)(uintptr_t)value; conn != NULL;
+		     conn = conn->hash_next) {
+			if (conn_hash_match(conn, pkt, ip_hdr, proto,
+					    src_port, dst_port)) {
+				return conn;
+			}
+		}
+	}
+
+	if (sys_hashmap_get(&conn_map, conn_hash_port_key(proto, dst_port),
+			    &value)) {
+		chains[0] = (struct net_conn *)(uintptr_t)value;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(chains); i++) {
+		for (conn = chains[i]; conn != NULL; conn = conn->hash_next) {
+			if (best_rank < NET_CONN_RANK(conn->flags) &&
+			    conn_hash_match(conn, pkt, ip_hdr, proto,
+					    src_port, dst_port)) {
+				best_rank = NET_CONN_RANK(conn->flags);
+				best_match = conn;
+			}
+		}
+	}
+
+	return best_match;
+}
+#else
+#define conn_hash_find(...) NULL
+#endif /* CONFIG_NET_CONN_HASH */
+
 static inline void conn_send_icmp_error(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_DISABLE_ICMP_DESTINATION_UNREACHABLE)) {
@@ -661,6 +974,13 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 
+	if (IS_ENABLED(CONFIG_NET_CONN_HASH) && !is_mcast_pkt &&
+	    (pkt_family == AF_INET || pkt_family == AF_INET6) &&
+	    (proto == IPPROTO_UDP || proto == IPPROTO_TCP)) {
+		best_match = conn_hash_find(pkt, ip_hdr, proto, src_port, dst_port);
+		goto matched;
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
@@ -749,43 +1069,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 			/* Is the candidate connection matching the packet's TCP/UDP
 			 * address and port?
 			 */
-			if (net_sin(&conn->remote_addr)->sin_port &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
-
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-
-				/* Check if we could do a v4-mapping-to-v6 and the IPv6 socket
-				 * has no IPV6_V6ONLY option set and if the local IPV6 address
-				 * is unspecified, then we could accept a connection from IPv4
-				 * address by mapping it to IPv6 address.
-				 */
-				if (IS_ENABLED(CONFIG_NET_IPV4_MAPPING_TO_IPV6)) {
-					if (!(conn->family == AF_INET6 && pkt_family == AF_INET &&
-					      !conn->v6only &&
-					      net_ipv6_is_addr_unspecified(
-						      &net_sin6(&conn->local_addr)->sin6_addr))) {
-						continue; /* wrong local address */
-					}
-				} else {
-					continue; /* wrong local address */
-				}
-
-				/* We might have a match for v4-to-v6 mapping,
-				 * continue with rank checking.
-				 */
+			if (!conn_ip_match(conn, pkt, ip_hdr, src_port, dst_port)) {
+				continue;
 			}
 
 			if (best_rank < NET_CONN_RANK(conn->flags)) {
@@ -829,6 +1114,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	} /* loop end */
 
+matched:
 	if (best_match) {
 		cb = best_match->cb;
 		user_data = best_match->user_data;
@@ -916,6 +1202,10 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_heap_init(&conn_hash_heap, conn_hash_mem, sizeof(conn_hash_mem));
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
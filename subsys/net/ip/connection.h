@@ -82,6 +82,14 @@ struct net_conn {
 
 	/** Is v4-mapping-to-v6 enabled for this connection */
 	uint8_t v6only : 1;
+
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Next connection with the same hash key, or without one */
+	struct net_conn *hash_next;
+
+	/** Hash key of the connection */
+	uint64_t hash_key;
+#endif
 };
 
 /**
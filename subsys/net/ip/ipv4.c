@@ -412,6 +412,11 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 		goto drop;
 	}
 
+	if (hdr->proto == IPPROTO_TCP &&
+	    net_tcp_gro_receive(pkt) == NET_OK) {
+		return NET_OK;
+	}
+
 	ip.ipv4 = hdr;
 
 	verdict = net_conn_input(pkt, &ip, hdr->proto, &proto_hdr);
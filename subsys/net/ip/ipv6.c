@@ -744,6 +744,11 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 		return verdict;
 	}
 
+	if (current_hdr == IPPROTO_TCP &&
+	    net_tcp_gro_receive(pkt) == NET_OK) {
+		return NET_OK;
+	}
+
 	ip.ipv6 = hdr;
 
 	verdict = net_conn_input(pkt, &ip, current_hdr, &proto_hdr);
@@ -407,6 +407,15 @@ int net_send_data(struct net_pkt *pkt)
 		 * to RX processing.
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
+
+		/* A large TCP packet is received as one segment */
+		if (net_pkt_gso_size(pkt) > 0) {
+			status = net_tcp_gso_finalize(pkt);
+			if (status < 0) {
+				return status;
+			}
+		}
+
 		processing_data(pkt, true);
 		return 0;
 	}
@@ -30,6 +30,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "ipv4.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
+#include "tcp_internal.h"
 
 #include "net_stats.h"
 
@@ -205,6 +206,32 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+static bool net_if_tcp_seg_offload(struct net_if *iface)
+{
+#if defined(CONFIG_NET_L2_ETHERNET)
+	return net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET) &&
+	       (net_eth_get_hw_capabilities(iface) &
+		ETHERNET_HW_TCP_SEG_OFFLOAD);
+#else
+	ARG_UNUSED(iface);
+
+	return false;
+#endif
+}
+
+static int net_if_l2_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	/* TCP packets larger than the MTU are segmented here, unless
+	 * the driver does it.
+	 */
+	if (IS_ENABLED(CONFIG_NET_TCP_GSO) && net_pkt_gso_size(pkt) > 0 &&
+	    !net_if_tcp_seg_offload(iface)) {
+		return net_tcp_gso_send(iface, pkt);
+	}
+
+	return net_if_l2(iface)->send(iface, pkt);
+}
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = {
@@ -255,7 +282,7 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		}
 
 		net_if_tx_lock(iface);
-		status = net_if_l2(iface)->send(iface, pkt);
+		status = net_if_l2_send(iface, pkt);
 		net_if_tx_unlock(iface);
 
 		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
@@ -1013,7 +1013,11 @@ static size_t pkt_estimate_headers_length(struct net_pkt *pkt,
 
 	/* + protocol header */
 	if (IS_ENABLED(CONFIG_NET_TCP) && proto == IPPROTO_TCP) {
-		hdr_len += NET_TCPH_LEN + NET_TCP_MAX_OPT_SIZE;
+		hdr_len += NET_TCPH_LEN;
+
+		if (net_pkt_context(pkt) != NULL) {
+			hdr_len += net_tcp_data_opts_len(net_pkt_context(pkt));
+		}
 	} else if (IS_ENABLED(CONFIG_NET_UDP) && proto == IPPROTO_UDP) {
 		hdr_len += NET_UDPH_LEN;
 	} else if (proto == IPPROTO_ICMP || proto == IPPROTO_ICMPV6) {
@@ -1866,6 +1870,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_ip_dscp(clone_pkt, net_pkt_ip_dscp(pkt));
 	net_pkt_set_ip_ecn(clone_pkt, net_pkt_ip_ecn(pkt));
 	net_pkt_set_vlan_tag(clone_pkt, net_pkt_vlan_tag(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 	net_pkt_set_timestamp(clone_pkt, net_pkt_timestamp(pkt));
 	net_pkt_set_priority(clone_pkt, net_pkt_priority(pkt));
 	net_pkt_set_orig_iface(clone_pkt, net_pkt_orig_iface(pkt));
@@ -1980,6 +1985,44 @@ struct net_pkt *net_pkt_rx_clone(struct net_pkt *pkt, k_timeout_t timeout)
 	return net_pkt_clone_internal(pkt, &rx_pkts, timeout);
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+struct net_pkt *net_pkt_clone_segment(struct net_pkt *pkt, size_t hdr_len,
+				      size_t offset, size_t len,
+				      k_timeout_t timeout)
+{
+	struct net_pkt *seg;
+
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+	seg = pkt_alloc_with_buffer(pkt->slab, net_pkt_iface(pkt),
+				    hdr_len + len, AF_UNSPEC, 0, timeout,
+				    __func__, __LINE__);
+#else
+	seg = pkt_alloc_with_buffer(pkt->slab, net_pkt_iface(pkt),
+				    hdr_len + len, AF_UNSPEC, 0, timeout);
+#endif
+	if (!seg) {
+		return NULL;
+	}
+
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_copy(seg, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy(seg, pkt, len)) {
+		net_pkt_unref(seg);
+		return NULL;
+	}
+
+	clone_pkt_attributes(pkt, seg);
+	net_pkt_set_gso_size(seg, 0);
+
+	net_pkt_cursor_init(seg);
+
+	return seg;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt, k_timeout_t timeout)
 {
 	struct net_pkt *clone_pkt;
@@ -130,6 +130,20 @@ extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
+/* Index of the RX traffic class whose thread is running, or -1 if the
+ * caller is not an RX traffic class thread.
+ */
+extern int net_tc_rx_current(void);
+
+#if defined(CONFIG_NET_TCP_GSO)
+/* Allocate a packet holding the first hdr_len bytes of pkt followed by len
+ * bytes of pkt starting offset bytes after them.
+ */
+struct net_pkt *net_pkt_clone_segment(struct net_pkt *pkt, size_t hdr_len,
+				      size_t offset, size_t len,
+				      k_timeout_t timeout);
+#endif
+
 char *net_sprint_addr(sa_family_t af, const void *addr);
 
 #define net_sprint_ipv4_addr(_addr) net_sprint_addr(AF_INET, _addr)
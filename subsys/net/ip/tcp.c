@@ -56,12 +56,16 @@ static int tcp_tx_window =
 	CONFIG_NET_BUF_DATA_POOL_SIZE / 3;
 #endif /* CONFIG_NET_BUF_FIXED_DATA_SIZE */
 #endif
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 #define TCP_RTO_MS (conn->rto)
 #else
 #define TCP_RTO_MS (tcp_rto)
 #endif
 
+/* Bounds of the retransmission timeout derived from the round-trip time */
+#define TCP_RTO_MIN_MS 100
+#define TCP_RTO_MAX_MS 60000
+
 /* Define the number of MSS sections the congestion window is initialized at */
 #define TCP_CONGESTION_INITIAL_WIN 1
 #define TCP_CONGESTION_INITIAL_SSTHRESH 3
@@ -374,13 +378,59 @@ out:
 	tcp_pkt_unref(pkt);
 }
 
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+/* Retransmission timeout according to RFC 6298, or tcp_rto until the
+ * round-trip time has been measured.
+ */
+static uint32_t tcp_rtt_rto(struct tcp *conn)
+{
+	uint32_t rto;
+
+	if (conn->srtt == 0U) {
+		return (uint32_t)tcp_rto;
+	}
+
+	rto = (conn->srtt >> 3) + conn->rttvar;
+
+	return CLAMP(rto, TCP_RTO_MIN_MS, TCP_RTO_MAX_MS);
+}
+
+static void tcp_rtt_update(struct tcp *conn, uint32_t rtt)
+{
+	int32_t delta;
+
+	if (conn->srtt == 0U) {
+		conn->srtt = MAX(rtt, 1U) << 3;
+		conn->rttvar = rtt << 1;
+	} else {
+		delta = (int32_t)rtt - (int32_t)(conn->srtt >> 3);
+		conn->srtt += delta;
+
+		if (delta < 0) {
+			delta = -delta;
+		}
+
+		delta -= conn->rttvar >> 2;
+		conn->rttvar += delta;
+	}
+
+	conn->rto = (uint16_t)tcp_rtt_rto(conn);
+
+	NET_DBG("conn: %p rtt=%u srtt=%u rttvar=%u rto=%u", conn, rtt,
+		conn->srtt >> 3, conn->rttvar >> 2, conn->rto);
+}
+#else
+#define tcp_rtt_rto(...) ((uint32_t)tcp_rto)
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
+
 static void tcp_derive_rto(struct tcp *conn)
 {
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t rto = tcp_rtt_rto(conn);
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
-	/* Compute a randomized rto 1 and 1.5 times tcp_rto */
+	/* Compute a randomized rto 1 and 1.5 times the rto */
 	uint32_t gain;
 	uint8_t gain8;
-	uint32_t rto;
 
 	/* Getting random is computational expensive, so only use 8 bits */
 	sys_rand_get(&gain8, sizeof(uint8_t));
@@ -388,9 +438,9 @@ static void tcp_derive_rto(struct tcp *conn)
 	gain = (uint32_t)gain8;
 	gain += 1 << 9;
 
-	rto = (uint32_t)tcp_rto;
 	rto = (gain * rto) >> 9;
-	conn->rto = (uint16_t)rto;
+#endif
+	conn->rto = (uint16_t)MIN(rto, UINT16_MAX);
 #else
 	ARG_UNUSED(conn);
 #endif
@@ -439,7 +489,7 @@ static void tcp_new_reno_dup_ack(struct tcp *conn)
 	int32_t new_win = conn->ca.cwnd;
 
 	new_win += conn_mss(conn);
-	conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+	conn->ca.cwnd = MIN(new_win, NET_TCP_MAX_WIN);
 	tcp_new_reno_log(conn, "dup_ack");
 }
 
@@ -455,7 +505,7 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 			/* Implement a div_ceil	to avoid rounding to 0 */
 			new_win += ((win_inc * win_inc) + conn->ca.cwnd - 1) / conn->ca.cwnd;
 		}
-		conn->ca.cwnd = MIN(new_win, UINT16_MAX);
+		conn->ca.cwnd = MIN(new_win, NET_TCP_MAX_WIN);
 	} else {
 		/* Check if it is still in fast recovery mode */
 		if (conn->ca.pending_fast_retransmit_bytes <= acked_len) {
@@ -469,32 +519,268 @@ static void tcp_new_reno_pkts_acked(struct tcp *conn, uint32_t acked_len)
 	tcp_new_reno_log(conn, "pkts_acked");
 }
 
-static void tcp_ca_init(struct tcp *conn)
+TCP_CA_REGISTER(reno, tcp_new_reno_init, tcp_new_reno_fast_retransmit,
+		tcp_new_reno_timeout, tcp_new_reno_dup_ack,
+		tcp_new_reno_pkts_acked);
+
+#if defined(CONFIG_NET_TCP_CA_CUBIC)
+
+/* Implementation according to RFC 9438, with the windows in bytes and the
+ * time in ms. Slow start, fast recovery and the growth by duplicate ACKs
+ * are the ones of New Reno.
+ */
+
+/* beta_cubic = 0.7 */
+#define TCP_CUBIC_BETA_NUM 7
+#define TCP_CUBIC_BETA_DEN 10
+
+/* Limit of |t - K| in ms, beyond it the window is limited anyway */
+#define TCP_CUBIC_MAX_DELTA_MS 100000
+
+static void tcp_cubic_log(struct tcp *conn, char *step)
+{
+	NET_DBG("conn: %p, ca %s, cwnd=%d, ssthres=%d, w_max=%d, k=%d",
+		conn, step, conn->ca.cwnd, conn->ca.ssthresh,
+		conn->ca.cubic.w_max, conn->ca.cubic.k);
+}
+
+/* Integer cube root, bit by bit */
+static uint32_t tcp_cubic_cbrt(uint64_t x)
+{
+	uint64_t y = 0;
+	uint64_t b;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		y <<= 1;
+		b = 3 * y * (y + 1) + 1;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static void tcp_cubic_init(struct tcp *conn)
 {
+	memset(&conn->ca.cubic, 0, sizeof(conn->ca.cubic));
 	tcp_new_reno_init(conn);
 }
 
+/* Multiplicative decrease, with fast convergence */
+static void tcp_cubic_loss(struct tcp *conn)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint64_t cwnd = conn->ca.cwnd;
+
+	if (cwnd < cubic->w_max) {
+		/* The available bandwidth shrunk, release some for others */
+		cubic->w_max = cwnd * (TCP_CUBIC_BETA_DEN + TCP_CUBIC_BETA_NUM) /
+			       (2 * TCP_CUBIC_BETA_DEN);
+	} else {
+		cubic->w_max = cwnd;
+	}
+
+	cubic->epoch_start = 0U;
+	conn->ca.ssthresh = MAX(conn_mss(conn) * 2,
+				cwnd * TCP_CUBIC_BETA_NUM / TCP_CUBIC_BETA_DEN);
+}
+
+static void tcp_cubic_fast_retransmit(struct tcp *conn)
+{
+	if (conn->ca.pending_fast_retransmit_bytes == 0) {
+		tcp_cubic_loss(conn);
+		/* Account for the lost segments */
+		conn->ca.cwnd = conn_mss(conn) * 3 + conn->ca.ssthresh;
+		conn->ca.pending_fast_retransmit_bytes = conn->unacked_len;
+		tcp_cubic_log(conn, "fast_retransmit");
+	}
+}
+
+static void tcp_cubic_timeout(struct tcp *conn)
+{
+	tcp_cubic_loss(conn);
+	conn->ca.cwnd = conn_mss(conn);
+	tcp_cubic_log(conn, "timeout");
+}
+
+/* Window the cubic function W(t) = C * (t - K)^3 + W_max gives t ms after
+ * the start of the epoch, with C = 0.4 segments per s^3.
+ */
+static uint32_t tcp_cubic_target(struct tcp *conn, uint32_t t)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	int64_t delta = CLAMP((int64_t)t - cubic->k, -TCP_CUBIC_MAX_DELTA_MS,
+			      TCP_CUBIC_MAX_DELTA_MS);
+	int64_t offset;
+
+	/* 0.4 * mss * (delta / 1000)^3, divided in two steps to not overflow */
+	offset = (delta * delta * delta) / 10000;
+	offset = offset * 4 * conn_mss(conn) / 1000000;
+
+	return CLAMP((int64_t)cubic->w_max + offset, conn_mss(conn),
+		     NET_TCP_MAX_WIN);
+}
+
+static void tcp_cubic_pkts_acked(struct tcp *conn, uint32_t acked_len)
+{
+	struct tcp_ca_cubic *cubic = &conn->ca.cubic;
+	uint32_t now = k_uptime_get_32();
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t target;
+	uint32_t t;
+
+	if (conn->ca.pending_fast_retransmit_bytes != 0 ||
+	    cwnd < conn->ca.ssthresh) {
+		tcp_new_reno_pkts_acked(conn, acked_len);
+		return;
+	}
+
+	if (cubic->epoch_start == 0U) {
+		cubic->epoch_start = MAX(now, 1U);
+		cubic->w_est = cwnd;
+
+		if (cwnd < cubic->w_max) {
+			/* K = cbrt((W_max - cwnd) / C) in s, here in ms */
+			cubic->k = tcp_cubic_cbrt((uint64_t)(cubic->w_max - cwnd) *
+						  2500000000ULL / mss);
+		} else {
+			cubic->k = 0U;
+			cubic->w_max = cwnd;
+		}
+	}
+
+	t = now - cubic->epoch_start;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	/* Aim at the window of one round trip later */
+	t += conn->srtt >> 3;
+#endif
+	target = tcp_cubic_target(conn, t);
+
+	/* Window of New Reno with the same beta, alpha = 3 * (1 - beta) /
+	 * (1 + beta) segments per round trip.
+	 */
+	cubic->w_est = MIN(cubic->w_est +
+			   DIV_ROUND_UP((uint64_t)mss * acked_len * 9, 17ULL * cwnd),
+			   NET_TCP_MAX_WIN);
+
+	if (cubic->w_est > target) {
+		/* Reno-friendly region */
+		cwnd = cubic->w_est;
+	} else if (target > cwnd) {
+		/* Do not grow by more than half the window per round trip */
+		target = MIN(target, cwnd + cwnd / 2);
+		cwnd += DIV_ROUND_UP((uint64_t)(target - cwnd) * acked_len, cwnd);
+	}
+
+	conn->ca.cwnd = MIN(cwnd, NET_TCP_MAX_WIN);
+	tcp_cubic_log(conn, "pkts_acked");
+}
+
+TCP_CA_REGISTER(cubic, tcp_cubic_init, tcp_cubic_fast_retransmit,
+		tcp_cubic_timeout, tcp_new_reno_dup_ack, tcp_cubic_pkts_acked);
+
+#endif /* CONFIG_NET_TCP_CA_CUBIC */
+
+static const struct tcp_ca_ops *tcp_ca_find(const char *name, size_t len)
+{
+	STRUCT_SECTION_FOREACH(tcp_ca_ops, ops) {
+		if (strlen(ops->name) == len && strncmp(ops->name, name, len) == 0) {
+			return ops;
+		}
+	}
+
+	return NULL;
+}
+
+static void tcp_ca_set_default(struct tcp *conn)
+{
+	conn->ca_ops = tcp_ca_find(CONFIG_NET_TCP_CA_DEFAULT,
+				   strlen(CONFIG_NET_TCP_CA_DEFAULT));
+	__ASSERT_NO_MSG(conn->ca_ops != NULL);
+}
+
+static void tcp_ca_param_copy(struct tcp *to, struct tcp *from)
+{
+	to->ca_ops = from->ca_ops;
+}
+
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+	const struct tcp_ca_ops *ops;
+
+	if (value == NULL) {
+		return -EINVAL;
+	}
+
+	/* The name may or may not be NUL terminated */
+	len = strnlen(value, len);
+
+	ops = tcp_ca_find(value, len);
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	if (ops != conn->ca_ops) {
+		conn->ca_ops = ops;
+
+		/* A running algorithm is replaced from the initial window on */
+		if (net_context_get_state(conn->context) == NET_CONTEXT_CONNECTED) {
+			ops->init(conn);
+		}
+	}
+
+	return 0;
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+	size_t name_len;
+
+	if (value == NULL || len == NULL) {
+		return -EINVAL;
+	}
+
+	name_len = MIN(strlen(conn->ca_ops->name) + 1, *len);
+	memcpy(value, conn->ca_ops->name, name_len);
+	*len = name_len;
+
+	return 0;
+}
+
+static void tcp_ca_init(struct tcp *conn)
+{
+	conn->ca_ops->init(conn);
+}
+
 static void tcp_ca_fast_retransmit(struct tcp *conn)
 {
-	tcp_new_reno_fast_retransmit(conn);
+	conn->ca_ops->fast_retransmit(conn);
 }
 
 static void tcp_ca_timeout(struct tcp *conn)
 {
-	tcp_new_reno_timeout(conn);
+	conn->ca_ops->timeout(conn);
 }
 
 static void tcp_ca_dup_ack(struct tcp *conn)
 {
-	tcp_new_reno_dup_ack(conn);
+	conn->ca_ops->dup_ack(conn);
 }
 
 static void tcp_ca_pkts_acked(struct tcp *conn, uint32_t acked_len)
 {
-	tcp_new_reno_pkts_acked(conn, acked_len);
+	conn->ca_ops->pkts_acked(conn, acked_len);
 }
 #else
 
+#define tcp_ca_set_default(...)
+#define tcp_ca_param_copy(...)
+#define set_tcp_congestion(...) (-ENOPROTOOPT)
+#define get_tcp_congestion(...) (-ENOPROTOOPT)
+
 static void tcp_ca_init(struct tcp *conn) { }
 
 static void tcp_ca_fast_retransmit(struct tcp *conn) { }
@@ -996,10 +1282,21 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 	return buf;
 }
 
+/* The options of the SYN segment stay valid for the connection, only
+ * the per segment ones are reset before a segment is parsed.
+ */
+static void tcp_options_reset(struct tcp_options *recv_options)
+{
+	recv_options->ts_found = false;
+#if defined(CONFIG_NET_TCP_SACK)
+	recv_options->sack_count = 0U;
+#endif
+}
+
 static bool tcp_options_check(struct tcp_options *recv_options,
 			      struct net_pkt *pkt, ssize_t len)
 {
-	uint8_t options_buf[40]; /* TCP header max options size is 40 */
+	uint8_t options_buf[NET_TCP_MAX_OPT_SIZE];
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
 	uint8_t *options = tcp_options_get(pkt, len, options_buf,
 					   sizeof(options_buf));
@@ -1007,9 +1304,6 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
-
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
 
@@ -1054,9 +1348,48 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			recv_options->window = options[2];
 			recv_options->wnd_found = true;
+			NET_DBG("WS=%hu", recv_options->window);
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->sack_perm_found = true;
+			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_OPT:
+			if ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_count < NET_TCP_SACK_MAX_BLOCKS;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[recv_options->sack_count++];
+
+				block->start = ntohl(UNALIGNED_GET((uint32_t *)(options + i)));
+				block->end = ntohl(UNALIGNED_GET((uint32_t *)(options + i + 4)));
+			}
 			break;
+#endif
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		case NET_TCP_TIMESTAMP_OPT:
+			if (opt_len != NET_TCP_TIMESTAMP_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			recv_options->tsval = ntohl(UNALIGNED_GET((uint32_t *)(options + 2)));
+			recv_options->tsecr = ntohl(UNALIGNED_GET((uint32_t *)(options + 6)));
+			recv_options->ts_found = true;
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -1231,10 +1564,11 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
+	uint32_t win = conn->recv_win;
 
 	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
 	if (!th) {
@@ -1245,14 +1579,15 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
+	th->th_off = 5 + opts_len / 4;
 
-	if (conn->send_options.mss_found) {
-		th->th_off++;
+	/* The window of a SYN segment is never scaled */
+	if (!(flags & SYN)) {
+		win >>= conn->rcv_wscale;
 	}
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(MIN(win, UINT16_MAX)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -1310,23 +1645,124 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+static uint8_t *tcp_opt_put32(uint8_t *opt, uint32_t value)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	UNALIGNED_PUT(htonl(value), (uint32_t *)opt);
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	return opt + sizeof(uint32_t);
+}
+
+/* Out-of-order data to report to the peer in a SACK option. The receive
+ * queue only holds sequential data, so there is at most one block.
+ */
+static bool tcp_sack_recv_block(struct tcp *conn, struct tcp_sack_block *block)
+{
+	if (!IS_ENABLED(CONFIG_NET_TCP_SACK) || !conn->sack_ok ||
+	    !CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return false;
+	}
+
+	block->start = tcp_get_seq(conn->queue_recv_data->buffer);
+	block->end = block->start + net_pkt_get_len(conn->queue_recv_data);
+
+	return net_tcp_seq_greater(block->start, conn->ack);
+}
+
+/* Build the options of a segment in buf, padded to a multiple of 4 bytes.
+ * A SYN carries our MSS and offers the options this stack supports, a
+ * SYN-ACK only accepts the ones the peer offered.
+ */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *buf)
+{
+	bool syn = conn->send_options.mss_found;
+	bool offer = syn && !(flags & ACK);
+	struct tcp_sack_block block;
+	bool sack_perm = false;
+	uint8_t *opt = buf;
+
+	if (syn) {
+		*opt++ = NET_TCP_MSS_OPT;
+		*opt++ = NET_TCP_MSS_SIZE;
+		UNALIGNED_PUT(htons(net_tcp_get_supported_mss(conn)),
+			      (uint16_t *)opt);
+		opt += sizeof(uint16_t);
+
+		if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+		    (offer || conn->wscale_ok)) {
+			*opt++ = NET_TCP_NOP_OPT;
+			*opt++ = NET_TCP_WINDOW_SCALE_OPT;
+			*opt++ = NET_TCP_WINDOW_SCALE_SIZE;
+			*opt++ = conn->rcv_wscale;
+		}
+
+		sack_perm = IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+			    (offer || conn->sack_ok);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) && !(flags & RST) &&
+	    (offer || conn->ts_ok)) {
+		/* SACK permitted takes the place of the padding */
+		if (sack_perm) {
+			*opt++ = NET_TCP_SACK_PERM_OPT;
+			*opt++ = NET_TCP_SACK_PERM_SIZE;
+			sack_perm = false;
+		} else {
+			*opt++ = NET_TCP_NOP_OPT;
+			*opt++ = NET_TCP_NOP_OPT;
+		}
+
+		*opt++ = NET_TCP_TIMESTAMP_OPT;
+		*opt++ = NET_TCP_TIMESTAMP_SIZE;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+		opt = tcp_opt_put32(opt, k_uptime_get_32());
+		opt = tcp_opt_put32(opt, conn->ts_recent);
+#endif
+	}
+
+	if (sack_perm) {
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_SACK_PERM_OPT;
+		*opt++ = NET_TCP_SACK_PERM_SIZE;
+	}
+
+	if (!syn && (flags & ACK) && !(flags & RST) &&
+	    tcp_sack_recv_block(conn, &block)) {
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_SACK_OPT;
+		*opt++ = 2 + NET_TCP_SACK_BLOCK_SIZE;
+		opt = tcp_opt_put32(opt, block.start);
+		opt = tcp_opt_put32(opt, block.end);
+	}
+
+	return opt - buf;
+}
+
+/* Length of the options tcp_options_build() adds to a data segment */
+static size_t tcp_data_opts_len(struct tcp *conn, bool sack_block)
+{
+	size_t len = 0;
+
+	if (IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) && conn->ts_ok) {
+		len += 2 + NET_TCP_TIMESTAMP_SIZE;
 	}
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+	if (sack_block) {
+		len += 2 + 2 + NET_TCP_SACK_BLOCK_SIZE;
+	}
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+	return len;
+}
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+/* Payload that fits in a data segment next to its options */
+static int tcp_send_mss(struct tcp *conn)
+{
+	struct tcp_sack_block block;
+
+	return conn_mss(conn) -
+	       tcp_data_opts_len(conn, tcp_sack_recv_block(conn, &block));
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1431,14 +1867,12 @@ err:
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t opts[NET_TCP_MAX_OPT_SIZE];
+	size_t opts_len = tcp_options_build(conn, flags, opts);
+	size_t alloc_len = sizeof(struct tcphdr) + opts_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1448,6 +1882,7 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	if (data) {
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
 		data->buffer = NULL;
 	}
 
@@ -1457,14 +1892,14 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (opts_len > 0) {
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
@@ -1624,42 +2059,45 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+/* Send len bytes of the send_data from offset on in one segment */
+static int tcp_send_segment(struct tcp *conn, int offset, int len, bool resend)
 {
-	int ret = 0;
-	int len;
+	int mss = tcp_send_mss(conn);
 	struct net_pkt *pkt;
+	int ret;
 
-	len = MIN(tcp_unsent_len(conn), conn_mss(conn));
-	if (len < 0) {
-		ret = len;
-		goto out;
-	}
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
+	if (IS_ENABLED(CONFIG_NET_TCP_GSO) && len > mss) {
+		/* Not limited to the MTU, it is split into segments of
+		 * mss bytes when it is sent.
+		 */
+		pkt = tcp_pkt_alloc(conn, 0);
+		if (pkt && net_pkt_alloc_buffer_raw(pkt, len,
+						    TCP_PKT_ALLOC_TIMEOUT) < 0) {
+			tcp_pkt_unref(pkt);
+			pkt = NULL;
+		}
+
+		if (pkt) {
+			net_pkt_set_gso_size(pkt, mss);
+		}
+	} else {
+		pkt = tcp_pkt_alloc(conn, len);
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
 	if (!pkt) {
 		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
+	ret = tcp_pkt_peek(pkt, conn->send_data, offset, len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+		return -ENOBUFS;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
 	if (ret == 0) {
-		conn->unacked_len += len;
-
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		if (resend) {
 			net_stats_update_tcp_resent(conn->iface, len);
 			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
@@ -1674,12 +2112,269 @@ static int tcp_send_data(struct tcp *conn)
 	 */
 	tcp_pkt_unref(pkt);
 
+	return ret;
+}
+
+#if defined(CONFIG_NET_TCP_GSO)
+/* Largest TCP payload that fits in one IP packet next to the headers */
+#define TCP_GSO_MAX_LEN (UINT16_MAX - NET_IPV6H_LEN - NET_TCPH_LEN - \
+			 NET_TCP_MAX_OPT_SIZE)
+
+/* Length of the next data segment. Several segments are sent as one
+ * packet, which is split at the L2, except on 6lo links which rewrite
+ * the headers of the packet.
+ */
+static int tcp_send_data_len(struct tcp *conn)
+{
+	struct net_linkaddr *ll = net_if_get_link_addr(conn->iface);
+	int len = tcp_unsent_len(conn);
+	int mss = tcp_send_mss(conn);
+	int segs;
+
+	if (ll->type == NET_LINK_BLUETOOTH || ll->type == NET_LINK_IEEE802154) {
+		return MIN(len, mss);
+	}
+
+	segs = MIN(CONFIG_NET_TCP_GSO_MAX_SEGS, TCP_GSO_MAX_LEN / mss);
+
+	return MIN(len, mss * segs);
+}
+#else
+#define tcp_send_data_len(conn) MIN(tcp_unsent_len(conn), tcp_send_mss(conn))
+#endif
+
+static int tcp_send_data(struct tcp *conn)
+{
+	int ret = 0;
+	int len;
+
+	len = tcp_send_data_len(conn);
+	if (len < 0) {
+		ret = len;
+		goto out;
+	}
+	if (len == 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
+		goto out;
+	}
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len,
+			       conn->data_mode == TCP_DATA_MODE_RESEND);
+	if (ret == 0) {
+		conn->unacked_len += len;
+	}
+
 	conn_send_data_dump(conn);
 
  out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+
+/* Implementation of the SACK based loss recovery of RFC 6675, simplified:
+ * every duplicate or partial ACK during the recovery retransmits the next
+ * hole below the highest SACKed sequence.
+ */
+
+static void tcp_sack_remove(struct tcp_sack_scoreboard *sb, int i)
+{
+	sb->count--;
+	memmove(&sb->blocks[i], &sb->blocks[i + 1],
+		(sb->count - i) * sizeof(sb->blocks[0]));
+}
+
+static void tcp_sack_add(struct tcp_sack_scoreboard *sb, uint32_t start,
+			 uint32_t end)
+{
+	int i = 0;
+
+	/* Merge the blocks the new one overlaps or touches */
+	while (i < sb->count) {
+		struct tcp_sack_block *block = &sb->blocks[i];
+
+		if (net_tcp_seq_cmp(end, block->start) < 0 ||
+		    net_tcp_seq_cmp(start, block->end) > 0) {
+			i++;
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(block->start, start) < 0) {
+			start = block->start;
+		}
+
+		if (net_tcp_seq_cmp(block->end, end) > 0) {
+			end = block->end;
+		}
+
+		tcp_sack_remove(sb, i);
+	}
+
+	for (i = 0; i < sb->count; i++) {
+		if (net_tcp_seq_cmp(start, sb->blocks[i].start) < 0) {
+			break;
+		}
+	}
+
+	/* When the scoreboard is full, forget the highest block */
+	if (i == NET_TCP_SACK_MAX_BLOCKS) {
+		return;
+	}
+
+	if (sb->count == NET_TCP_SACK_MAX_BLOCKS) {
+		sb->count--;
+	}
+
+	memmove(&sb->blocks[i + 1], &sb->blocks[i],
+		(sb->count - i) * sizeof(sb->blocks[0]));
+	sb->blocks[i].start = start;
+	sb->blocks[i].end = end;
+	sb->count++;
+}
+
+/* Add the SACK blocks of the received segment to the scoreboard */
+static void tcp_sack_update(struct tcp *conn)
+{
+	uint32_t snd_nxt = conn->seq + conn->unacked_len;
+
+	if (!conn->sack_ok) {
+		return;
+	}
+
+	for (int i = 0; i < conn->recv_options.sack_count; i++) {
+		struct tcp_sack_block *block = &conn->recv_options.sack[i];
+
+		/* Ignore blocks outside of the sent but unacknowledged data */
+		if (net_tcp_seq_cmp(block->start, block->end) >= 0 ||
+		    net_tcp_seq_cmp(block->start, conn->seq) <= 0 ||
+		    net_tcp_seq_cmp(block->end, snd_nxt) > 0) {
+			continue;
+		}
+
+		tcp_sack_add(&conn->sack, block->start, block->end);
+	}
+}
+
+/* Forget what has been acknowledged cumulatively */
+static void tcp_sack_prune(struct tcp *conn)
+{
+	struct tcp_sack_scoreboard *sb = &conn->sack;
+
+	while (sb->count > 0 &&
+	       net_tcp_seq_cmp(sb->blocks[0].end, conn->seq) <= 0) {
+		tcp_sack_remove(sb, 0);
+	}
+
+	if (sb->count > 0 &&
+	    net_tcp_seq_cmp(sb->blocks[0].start, conn->seq) < 0) {
+		sb->blocks[0].start = conn->seq;
+	}
+}
+
+static void tcp_sack_reset(struct tcp *conn)
+{
+	conn->sack.count = 0U;
+	conn->sack.in_recovery = false;
+}
+
+/* Retransmit up to one MSS of the next hole. The first unacknowledged
+ * segment counts as a hole until it has been retransmitted, the other
+ * holes only when the peer has SACKed data above them.
+ */
+static int tcp_sack_retransmit(struct tcp *conn)
+{
+	struct tcp_sack_scoreboard *sb = &conn->sack;
+	uint32_t start = sb->rexmit_next;
+	uint32_t end;
+	int len;
+	int ret;
+	int i;
+
+	if (net_tcp_seq_cmp(start, conn->seq) < 0) {
+		start = conn->seq;
+	}
+
+	for (i = 0; i < sb->count; i++) {
+		if (net_tcp_seq_cmp(start, sb->blocks[i].start) < 0) {
+			break;
+		}
+
+		if (net_tcp_seq_cmp(start, sb->blocks[i].end) < 0) {
+			start = sb->blocks[i].end;
+		}
+	}
+
+	if (i < sb->count) {
+		end = sb->blocks[i].start;
+	} else if (sb->count == 0 && start == conn->seq) {
+		end = conn->seq + conn->unacked_len;
+	} else {
+		return -ENODATA;
+	}
+
+	len = MIN((int)(end - start), tcp_send_mss(conn));
+	if (len <= 0) {
+		return -ENODATA;
+	}
+
+	NET_DBG("conn: %p retransmit hole seq %u len %d", conn, start, len);
+
+	ret = tcp_send_segment(conn, start - conn->seq, len, true);
+	if (ret == 0) {
+		sb->rexmit_next = start + len;
+	}
+
+	return ret;
+}
+
+/* Start the loss recovery instead of the plain fast retransmit */
+static bool tcp_sack_fast_retransmit(struct tcp *conn)
+{
+	if (!conn->sack_ok) {
+		return false;
+	}
+
+	conn->sack.in_recovery = true;
+	conn->sack.recovery_point = conn->seq + conn->unacked_len;
+	conn->sack.rexmit_next = conn->seq;
+
+	(void)tcp_sack_retransmit(conn);
+
+	return true;
+}
+
+static void tcp_sack_dup_ack(struct tcp *conn)
+{
+	if (conn->sack.in_recovery) {
+		(void)tcp_sack_retransmit(conn);
+	}
+}
+
+static void tcp_sack_pkts_acked(struct tcp *conn)
+{
+	tcp_sack_prune(conn);
+
+	if (!conn->sack.in_recovery) {
+		return;
+	}
+
+	if (net_tcp_seq_cmp(conn->seq, conn->sack.recovery_point) >= 0) {
+		conn->sack.in_recovery = false;
+		return;
+	}
+
+	/* Partial ACK, the next hole is lost as well */
+	(void)tcp_sack_retransmit(conn);
+}
+#else
+#define tcp_sack_update(...)
+#define tcp_sack_reset(...)
+#define tcp_sack_fast_retransmit(...) false
+#define tcp_sack_dup_ack(...)
+#define tcp_sack_pkts_acked(...)
+#endif /* CONFIG_NET_TCP_SACK */
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1763,6 +2458,11 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	if (conn->send_data_retries == 0) {
+		/* The peer may have discarded data it has SACKed */
+		tcp_sack_reset(conn);
+	}
+
 	if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE) &&
 	    (conn->send_data_retries == 0)) {
 		tcp_ca_timeout(conn);
@@ -1979,7 +2679,7 @@ static struct tcp *tcp_conn_alloc(void)
 
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
-	conn->recv_win_max = tcp_rx_window;
+	conn->recv_win_max = MIN(tcp_rx_window, NET_TCP_MAX_WIN);
 	conn->recv_win = conn->recv_win_max;
 	conn->send_win_max = MAX(tcp_tx_window, NET_IPV6_MTU);
 	conn->send_win = conn->send_win_max;
@@ -1991,8 +2691,9 @@ static struct tcp *tcp_conn_alloc(void)
 	/* Initially set the congestion window at its max size, since only the MSS
 	 * is available as soon as the connection is established
 	 */
-	conn->ca.cwnd = UINT16_MAX;
+	conn->ca.cwnd = NET_TCP_MAX_WIN;
 #endif
+	tcp_ca_set_default(conn);
 
 	/* The ISN value will be set when we get the connection attempt or
 	 * when trying to create a connection.
@@ -2627,6 +3328,7 @@ static void tcp_check_sock_options(struct tcp *conn)
 
 		k_mutex_lock(&conn->lock, K_FOREVER);
 
+		rcvbuf_opt = MIN(rcvbuf_opt, NET_TCP_MAX_WIN);
 		diff = rcvbuf_opt - conn->recv_win_max;
 		conn->recv_win_max = rcvbuf_opt;
 		tcp_update_recv_wnd(conn, diff);
@@ -2635,6 +3337,79 @@ static void tcp_check_sock_options(struct tcp *conn)
 	}
 }
 
+/* Smallest shift that fits the receive window in the window field */
+static uint8_t tcp_window_scale(struct tcp *conn)
+{
+	uint8_t scale = 0U;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE)) {
+		return 0U;
+	}
+
+	while (scale < NET_TCP_MAX_WIN_SCALE &&
+	       (conn->recv_win_max >> scale) > UINT16_MAX) {
+		scale++;
+	}
+
+	return scale;
+}
+
+/* Use the options both ends have sent in their SYN segments */
+static void tcp_options_negotiate(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) && opts->wnd_found) {
+		conn->wscale_ok = true;
+		conn->snd_wscale = MIN(opts->window, NET_TCP_MAX_WIN_SCALE);
+	} else {
+		conn->wscale_ok = false;
+		conn->snd_wscale = 0U;
+		conn->rcv_wscale = 0U;
+	}
+
+	conn->sack_ok = IS_ENABLED(CONFIG_NET_TCP_SACK) && opts->sack_perm_found;
+	conn->ts_ok = IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) && opts->ts_found;
+
+	NET_DBG("conn: %p wscale %d (%u/%u) sack %d ts %d", conn,
+		conn->wscale_ok, conn->snd_wscale, conn->rcv_wscale,
+		conn->sack_ok, conn->ts_ok);
+}
+
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+/* Remember the timestamp to echo, from segments that are not beyond
+ * what we have acknowledged, as described in RFC 7323 ch 4.3.
+ */
+static void tcp_ts_recv(struct tcp *conn, struct tcphdr *th)
+{
+	if (!conn->recv_options.ts_found) {
+		return;
+	}
+
+	if (conn->state == TCP_LISTEN || conn->state == TCP_SYN_SENT ||
+	    net_tcp_seq_cmp(th_seq(th), conn->ack) <= 0) {
+		conn->ts_recent = conn->recv_options.tsval;
+	}
+}
+
+/* Measure the round-trip time with the timestamp echoed by an ACK of
+ * new data. Retransmitted segments carry a new timestamp, so samples
+ * are valid during retransmissions as well.
+ */
+static void tcp_rtt_sample(struct tcp *conn)
+{
+	if (!conn->ts_ok || !conn->recv_options.ts_found ||
+	    conn->recv_options.tsecr == 0U) {
+		return;
+	}
+
+	tcp_rtt_update(conn, k_uptime_get_32() - conn->recv_options.tsecr);
+}
+#else
+#define tcp_ts_recv(...)
+#define tcp_rtt_sample(...)
+#endif /* CONFIG_NET_TCP_TIMESTAMPS */
+
 /* TCP state machine, everything happens here */
 static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 {
@@ -2706,6 +3481,8 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	tcp_options_reset(&conn->recv_options);
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
 						  tcp_options_len)) {
 		NET_DBG("DROP: Invalid TCP option list");
@@ -2715,6 +3492,10 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto out;
 	}
 
+	if (th) {
+		tcp_ts_recv(conn, th);
+	}
+
 	if (th && (conn->state != TCP_LISTEN) && (conn->state != TCP_SYN_SENT) &&
 	    tcp_validate_seq(conn, th) && FL(&fl, &, SYN)) {
 		/* According to RFC 793, ch 3.9 Event Processing, receiving SYN
@@ -2732,6 +3513,12 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 	if (th) {
 		conn->send_win = ntohs(th_win(th));
+
+		/* The window of a SYN segment is never scaled */
+		if (!(th_flags(th) & SYN)) {
+			conn->send_win <<= conn->snd_wscale;
+		}
+
 		if (conn->send_win > conn->send_win_max) {
 			NET_DBG("Lowering send window from %u to %u",
 				conn->send_win, conn->send_win_max);
@@ -2762,7 +3549,11 @@ next_state:
 
 	switch (conn->state) {
 	case TCP_LISTEN:
+		conn->rcv_wscale = tcp_window_scale(conn);
+
 		if (FL(&fl, ==, SYN)) {
+			tcp_options_negotiate(conn);
+
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
@@ -2796,6 +3587,7 @@ next_state:
 				accept_cb = conn->accepted_conn->accept_cb;
 				context = conn->accepted_conn->context;
 				keep_alive_param_copy(conn, conn->accepted_conn);
+				tcp_ca_param_copy(conn, conn->accepted_conn);
 			}
 
 			k_work_cancel_delayable(&conn->establish_timer);
@@ -2880,6 +3672,8 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_options_negotiate(conn);
+			tcp_rtt_sample(conn);
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -2958,6 +3752,10 @@ next_state:
 		 */
 		keep_alive_timer_restart(conn);
 
+		if (th) {
+			tcp_sack_update(conn);
+		}
+
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
 			/* Only if there is pending data, increment the duplicate ack count */
@@ -2979,19 +3777,23 @@ next_state:
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
 				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
+				if (!tcp_sack_fast_retransmit(conn)) {
+					int temp_unacked_len = conn->unacked_len;
 
-				conn->unacked_len = 0;
+					conn->unacked_len = 0;
 
-				(void)tcp_send_data(conn);
+					(void)tcp_send_data(conn);
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+					/* Restore the current transmission */
+					conn->unacked_len = temp_unacked_len;
+				}
 
 				tcp_ca_fast_retransmit(conn);
 				if (tcp_window_full(conn)) {
 					(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 				}
+			} else if (len == 0 && conn->send_data_total > 0) {
+				tcp_sack_dup_ack(conn);
 			}
 		}
 #endif
@@ -3023,6 +3825,7 @@ next_state:
 			conn->dup_ack_cnt = 0;
 #endif
 			tcp_ca_pkts_acked(conn, len_acked);
+			tcp_rtt_sample(conn);
 
 			conn->send_data_total -= len_acked;
 			if (conn->unacked_len < len_acked) {
@@ -3038,6 +3841,10 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+			if (conn->data_mode == TCP_DATA_MODE_SEND) {
+				tcp_sack_pkts_acked(conn);
+			}
+
 			conn_send_data_dump(conn);
 
 			conn->send_data_retries = 0;
@@ -3874,6 +4681,11 @@ int net_tcp_finalize(struct net_pkt *pkt, bool force_chksum)
 
 	tcp_hdr->chksum = 0U;
 
+	/* The segments of a large packet get their own checksum */
+	if (net_pkt_gso_size(pkt) > 0) {
+		return net_pkt_set_data(pkt, &tcp_access);
+	}
+
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) || force_chksum) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 		net_pkt_set_chksum_done(pkt, true);
@@ -4173,6 +4985,19 @@ void net_tcp_foreach(net_tcp_cb_t cb, void *user_data)
 	k_mutex_unlock(&tcp_lock);
 }
 
+size_t net_tcp_data_opts_len(struct net_context *context)
+{
+	struct tcp *conn = context->tcp;
+
+	if (conn == NULL) {
+		return 0;
+	}
+
+	/* A SACK block may be pending by the time the data is sent */
+	return tcp_data_opts_len(conn, IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+					conn->sack_ok);
+}
+
 uint16_t net_tcp_get_supported_mss(const struct tcp *conn)
 {
 	sa_family_t family = net_context_get_family(conn->context);
@@ -4251,6 +5076,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = set_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -4288,6 +5116,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_KEEPCNT:
 		ret = get_tcp_keep_cnt(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
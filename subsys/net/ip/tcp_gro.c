@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Generic receive offload: in-order TCP segments of a connection received
+ * by an RX traffic class thread are coalesced into one packet, so that the
+ * connection lookup and the TCP state machine run once for all of them.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <string.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "net_private.h"
+#include "connection.h"
+#include "tcp_internal.h"
+#include "net_stats.h"
+
+struct tcp_gro_flow {
+	/* Coalesced segments, NULL if the entry is free */
+	struct net_pkt *pkt;
+	/* Sequence number the next segment has to start with */
+	uint32_t next_seq;
+	/* Length of the IP and TCP headers */
+	uint16_t hdr_len;
+};
+
+struct tcp_gro_table {
+	struct tcp_gro_flow flows[CONFIG_NET_TCP_GRO_FLOWS];
+	/* Entry delivered when a new flow needs room */
+	uint8_t next_evict;
+};
+
+/* Only used by the thread of the traffic class, so no locking needed */
+static struct tcp_gro_table gro_tables[NET_TC_RX_COUNT];
+
+/* The headers of the segments GRO handles are in the first buffer */
+static inline struct net_tcp_hdr *gro_tcp_hdr(struct net_pkt *pkt)
+{
+	return (struct net_tcp_hdr *)(net_pkt_ip_data(pkt) +
+				      net_pkt_ip_hdr_len(pkt));
+}
+
+/* Segments with IP options or extension headers, or with headers split
+ * over several buffers are passed on as is.
+ */
+static bool gro_hdr_in_place(struct net_pkt *pkt)
+{
+	uint8_t version = net_pkt_family(pkt) == AF_INET ? 4U : 6U;
+	struct net_buf *buf = pkt->buffer;
+
+	return net_pkt_ip_opts_len(pkt) == 0U &&
+	       buf->len >= net_pkt_ip_hdr_len(pkt) + sizeof(struct net_tcp_hdr) &&
+	       (buf->data[0] >> 4) == version;
+}
+
+/* Length of the IP and TCP headers of a segment that can be coalesced,
+ * 0 if it has to be passed on as is.
+ */
+static size_t gro_hdr_len(struct net_pkt *pkt)
+{
+	struct net_tcp_hdr *tcp_hdr = gro_tcp_hdr(pkt);
+	size_t hdr_len;
+
+	hdr_len = net_pkt_ip_hdr_len(pkt) + (tcp_hdr->offset >> 4) * 4U;
+
+	/* Only data segments without flags other than PSH. The PSH flag
+	 * does not change how the data is delivered, and the RX queue
+	 * running empty bounds the latency anyway.
+	 */
+	if ((tcp_hdr->flags & ~PSH) != ACK || net_pkt_is_ip_reassembled(pkt) ||
+	    hdr_len > pkt->buffer->len || net_pkt_get_len(pkt) <= hdr_len) {
+		return 0;
+	}
+
+	return hdr_len;
+}
+
+static bool gro_same_flow(struct net_pkt *held, struct net_pkt *pkt)
+{
+	struct net_tcp_hdr *held_hdr = gro_tcp_hdr(held);
+	struct net_tcp_hdr *tcp_hdr = gro_tcp_hdr(pkt);
+
+	if (net_pkt_iface(held) != net_pkt_iface(pkt) ||
+	    net_pkt_family(held) != net_pkt_family(pkt) ||
+	    held_hdr->src_port != tcp_hdr->src_port ||
+	    held_hdr->dst_port != tcp_hdr->dst_port) {
+		return false;
+	}
+
+	/* The source and destination addresses follow each other */
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		return memcmp(NET_IPV4_HDR(held)->src, NET_IPV4_HDR(pkt)->src,
+			      2 * NET_IPV4_ADDR_SIZE) == 0;
+	}
+
+	return memcmp(NET_IPV6_HDR(held)->src, NET_IPV6_HDR(pkt)->src,
+		      2 * NET_IPV6_ADDR_SIZE) == 0;
+}
+
+static bool gro_can_merge(struct tcp_gro_flow *flow, struct net_pkt *pkt,
+			  size_t hdr_len)
+{
+	struct net_tcp_hdr *held_hdr = gro_tcp_hdr(flow->pkt);
+	struct net_tcp_hdr *tcp_hdr = gro_tcp_hdr(pkt);
+	size_t len = net_pkt_get_len(pkt) - hdr_len;
+
+	if (hdr_len != flow->hdr_len ||
+	    sys_get_be32(tcp_hdr->seq) != flow->next_seq ||
+	    net_pkt_get_len(flow->pkt) + len > CONFIG_NET_TCP_GRO_MAX_SIZE) {
+		return false;
+	}
+
+	/* Same acknowledgment and options, e.g. timestamps */
+	if (memcmp(held_hdr->ack, tcp_hdr->ack, sizeof(tcp_hdr->ack)) ||
+	    memcmp(held_hdr->optdata, tcp_hdr->optdata,
+		   hdr_len - net_pkt_ip_hdr_len(pkt) -
+		   sizeof(struct net_tcp_hdr))) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		struct net_ipv4_hdr *held_ip = NET_IPV4_HDR(flow->pkt);
+		struct net_ipv4_hdr *ip = NET_IPV4_HDR(pkt);
+
+		return held_ip->tos == ip->tos && held_ip->ttl == ip->ttl &&
+		       !memcmp(held_ip->offset, ip->offset, sizeof(ip->offset));
+	}
+
+	return !memcmp(NET_IPV6_HDR(flow->pkt), NET_IPV6_HDR(pkt),
+		       offsetof(struct net_ipv6_hdr, len)) &&
+	       NET_IPV6_HDR(flow->pkt)->hop_limit == NET_IPV6_HDR(pkt)->hop_limit;
+}
+
+/* Append the payload of pkt to the coalesced packet and free pkt */
+static void gro_merge(struct tcp_gro_flow *flow, struct net_pkt *pkt,
+		      size_t hdr_len)
+{
+	struct net_tcp_hdr *held_hdr = gro_tcp_hdr(flow->pkt);
+	struct net_tcp_hdr *tcp_hdr = gro_tcp_hdr(pkt);
+	struct net_buf *buf = pkt->buffer;
+
+	/* The latest window and the push flag apply to all the data */
+	memcpy(held_hdr->wnd, tcp_hdr->wnd, sizeof(held_hdr->wnd));
+	held_hdr->flags |= tcp_hdr->flags;
+
+	flow->next_seq += net_pkt_get_len(pkt) - hdr_len;
+
+	net_buf_pull(buf, hdr_len);
+	if (buf->len == 0U) {
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	net_pkt_append_buffer(flow->pkt, buf);
+}
+
+/* Pass the coalesced packet on to the connection it belongs to */
+static void gro_flow_flush(struct tcp_gro_flow *flow)
+{
+	struct net_pkt *pkt = flow->pkt;
+	union net_proto_header proto_hdr;
+	union net_ip_header ip_hdr;
+	size_t len;
+
+	flow->pkt = NULL;
+
+	len = net_pkt_get_len(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		ip_hdr.ipv4 = NET_IPV4_HDR(pkt);
+		ip_hdr.ipv4->len = htons(len);
+#if defined(CONFIG_NET_IPV4)
+		ip_hdr.ipv4->chksum = 0U;
+		ip_hdr.ipv4->chksum = net_calc_chksum_ipv4(pkt);
+#endif
+	} else {
+		ip_hdr.ipv6 = NET_IPV6_HDR(pkt);
+		ip_hdr.ipv6->len = htons(len - sizeof(struct net_ipv6_hdr));
+	}
+
+	proto_hdr.tcp = gro_tcp_hdr(pkt);
+
+	/* Where net_tcp_input() left the cursor */
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	(void)net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			    sizeof(struct net_tcp_hdr));
+
+	NET_DBG("pkt %p len %zu", pkt, len);
+
+	if (net_conn_input(pkt, &ip_hdr, IPPROTO_TCP, &proto_hdr) == NET_DROP) {
+		if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+			net_stats_update_ipv4_drop(net_pkt_iface(pkt));
+		} else {
+			net_stats_update_ipv6_drop(net_pkt_iface(pkt));
+		}
+
+		net_pkt_unref(pkt);
+	}
+}
+
+static struct tcp_gro_flow *gro_flow_get(struct tcp_gro_table *table)
+{
+	struct tcp_gro_flow *flow;
+	int i;
+
+	for (i = 0; i < CONFIG_NET_TCP_GRO_FLOWS; i++) {
+		if (table->flows[i].pkt == NULL) {
+			return &table->flows[i];
+		}
+	}
+
+	flow = &table->flows[table->next_evict];
+	table->next_evict = (table->next_evict + 1U) % CONFIG_NET_TCP_GRO_FLOWS;
+
+	gro_flow_flush(flow);
+
+	return flow;
+}
+
+enum net_verdict net_tcp_gro_receive(struct net_pkt *pkt)
+{
+	struct tcp_gro_flow *flow = NULL;
+	struct tcp_gro_table *table;
+	size_t hdr_len;
+	int tc;
+	int i;
+
+	tc = net_tc_rx_current();
+	if (tc < 0) {
+		return NET_CONTINUE;
+	}
+
+	table = &gro_tables[tc];
+
+	if (!gro_hdr_in_place(pkt)) {
+		/* The flow is unknown, keep the order of all of them */
+		net_tcp_gro_flush(tc);
+		return NET_CONTINUE;
+	}
+
+	for (i = 0; i < CONFIG_NET_TCP_GRO_FLOWS; i++) {
+		if (table->flows[i].pkt &&
+		    gro_same_flow(table->flows[i].pkt, pkt)) {
+			flow = &table->flows[i];
+			break;
+		}
+	}
+
+	hdr_len = gro_hdr_len(pkt);
+	if (hdr_len == 0U) {
+		/* Keep the order of the segments of the connection */
+		if (flow) {
+			gro_flow_flush(flow);
+		}
+
+		return NET_CONTINUE;
+	}
+
+	if (flow) {
+		if (gro_can_merge(flow, pkt, hdr_len)) {
+			gro_merge(flow, pkt, hdr_len);
+			return NET_OK;
+		}
+
+		gro_flow_flush(flow);
+	} else {
+		flow = gro_flow_get(table);
+	}
+
+	flow->pkt = pkt;
+	flow->hdr_len = hdr_len;
+	flow->next_seq = sys_get_be32(gro_tcp_hdr(pkt)->seq) +
+			 net_pkt_get_len(pkt) - hdr_len;
+
+	return NET_OK;
+}
+
+void net_tcp_gro_flush(uint8_t tc)
+{
+	struct tcp_gro_table *table = &gro_tables[tc];
+	int i;
+
+	for (i = 0; i < CONFIG_NET_TCP_GRO_FLOWS; i++) {
+		if (table->flows[i].pkt) {
+			gro_flow_flush(&table->flows[i]);
+		}
+	}
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Generic segmentation offload: TCP sends up to CONFIG_NET_TCP_GSO_MAX_SEGS
+ * segments as one packet, which is split into segments here just before it
+ * is handed to the L2.
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <errno.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+/* Fill in the lengths and checksums of the IP and TCP headers */
+static int tcp_gso_ip_finalize(struct net_pkt *pkt)
+{
+	net_pkt_cursor_init(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		NET_IPV4_HDR(pkt)->chksum = 0U;
+
+		return net_ipv4_finalize(pkt, IPPROTO_TCP);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		return net_ipv6_finalize(pkt, IPPROTO_TCP);
+	}
+
+	return -EINVAL;
+}
+
+/* Set the sequence number and flags of a segment and finalize its
+ * IP and TCP headers.
+ */
+static int tcp_gso_finalize(struct net_pkt *seg, size_t ip_len,
+			    uint32_t seq, uint8_t flags)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (net_pkt_skip(seg, ip_len)) {
+		return -ENOBUFS;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	sys_put_be32(seq, tcp_hdr->seq);
+	tcp_hdr->flags = flags;
+
+	if (net_pkt_set_data(seg, &tcp_access)) {
+		return -ENOBUFS;
+	}
+
+	return tcp_gso_ip_finalize(seg);
+}
+
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	size_t mss = net_pkt_gso_size(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	size_t hdr_len, data_len;
+	size_t offset;
+	uint32_t seq;
+	uint8_t flags;
+	int sent = 0;
+	int ret;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		return -EINVAL;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	hdr_len = ip_len + (tcp_hdr->offset >> 4) * 4U;
+	seq = sys_get_be32(tcp_hdr->seq);
+	flags = tcp_hdr->flags;
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	NET_DBG("pkt %p len %zu split into %zu byte segments", pkt, data_len,
+		mss);
+
+	for (offset = 0; offset < data_len; offset += mss) {
+		size_t len = MIN(mss, data_len - offset);
+		bool last = offset + len == data_len;
+		struct net_pkt *seg;
+
+		seg = net_pkt_clone_segment(pkt, hdr_len, offset, len,
+					    TCP_PKT_ALLOC_TIMEOUT);
+		if (!seg) {
+			ret = -ENOBUFS;
+			goto fail;
+		}
+
+		/* Only the last segment pushes the data */
+		ret = tcp_gso_finalize(seg, ip_len, seq + offset,
+				       last ? flags : (flags & ~(PSH | FIN)));
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			goto fail;
+		}
+
+		ret = net_if_l2(iface)->send(iface, seg);
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			goto fail;
+		}
+
+		sent += ret;
+	}
+
+	net_pkt_unref(pkt);
+
+	return sent;
+
+fail:
+	/* The segments not sent are retransmitted by TCP */
+	NET_DBG("pkt %p sent %zu of %zu bytes (%d)", pkt, offset, data_len,
+		ret);
+
+	return ret;
+}
+
+int net_tcp_gso_finalize(struct net_pkt *pkt)
+{
+	net_pkt_set_gso_size(pkt, 0);
+
+	return tcp_gso_ip_finalize(pkt);
+}
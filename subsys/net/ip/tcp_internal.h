@@ -36,6 +36,7 @@ enum tcp_conn_option {
 	TCP_OPT_KEEPIDLE = 3,
 	TCP_OPT_KEEPINTVL = 4,
 	TCP_OPT_KEEPCNT = 5,
+	TCP_OPT_CONGESTION = 6,
 };
 
 /**
@@ -55,6 +56,24 @@ static inline uint16_t net_tcp_get_supported_mss(const struct tcp *conn)
 }
 #endif
 
+/**
+ * @brief Length of the TCP options carried by the data segments of a
+ *        connection, as negotiated with the peer
+ *
+ * @param context Network context
+ *
+ * @return Length of the options in bytes, 0 if there is no connection
+ */
+#if defined(CONFIG_NET_NATIVE_TCP)
+size_t net_tcp_data_opts_len(struct net_context *context);
+#else
+static inline size_t net_tcp_data_opts_len(struct net_context *context)
+{
+	ARG_UNUSED(context);
+	return 0;
+}
+#endif
+
 const char *net_tcp_state_str(enum tcp_state state);
 
 /**
@@ -286,6 +305,86 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 }
 #endif
 
+/**
+ * @brief Split a large TCP packet into segments and send them
+ *
+ * The packet is split into segments of net_pkt_gso_size() bytes of
+ * payload, which are passed to the L2 of the interface one by one.
+ *
+ * @param iface Network interface the packet is sent to
+ * @param pkt Network packet
+ *
+ * @return Number of bytes sent on success, negative errno otherwise.
+ *	   The packet is consumed on success.
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt);
+#else
+static inline int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Turn a large TCP packet into a single segment
+ *
+ * Used when the packet is received by this host without being sent, so
+ * it is not split into segments.
+ *
+ * @param pkt Network packet
+ *
+ * @return 0 on success, negative errno otherwise.
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_finalize(struct net_pkt *pkt);
+#else
+static inline int net_tcp_gso_finalize(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+#endif
+
+/**
+ * @brief Coalesce a received TCP segment with the previous ones of its flow
+ *
+ * Must be called after net_tcp_input() has verified the packet.
+ *
+ * @param pkt Network packet
+ *
+ * @return NET_OK if the packet was taken over, NET_CONTINUE if the caller
+ *	   has to pass it to net_conn_input().
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+enum net_verdict net_tcp_gro_receive(struct net_pkt *pkt);
+#else
+static inline enum net_verdict net_tcp_gro_receive(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return NET_CONTINUE;
+}
+#endif
+
+/**
+ * @brief Deliver the segments coalesced by an RX traffic class
+ *
+ * @param tc RX traffic class
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+void net_tcp_gro_flush(uint8_t tc);
+#else
+static inline void net_tcp_gro_flush(uint8_t tc)
+{
+	ARG_UNUSED(tc);
+}
+#endif
+
 /**
  * @brief Enqueue data for transmission
  *
@@ -356,7 +455,7 @@ static inline int net_tcp_put(struct net_context *context)
 }
 #endif
 
-#define NET_TCP_MAX_OPT_SIZE  8
+#define NET_TCP_MAX_OPT_SIZE  40
 
 #if defined(CONFIG_NET_NATIVE_TCP)
 void net_tcp_init(void);
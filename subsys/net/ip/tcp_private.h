@@ -5,6 +5,8 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <zephyr/sys/iterable_sections.h>
+
 #include "tp.h"
 
 #define is(_a, _b) (strcmp((_a), (_b)) == 0)
@@ -146,7 +148,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -227,26 +229,113 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
+#define NET_TCP_TIMESTAMP_OPT    8
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+#define NET_TCP_TIMESTAMP_SIZE    10
+
+/* Largest window scale shift allowed by RFC 7323 */
+#define NET_TCP_MAX_WIN_SCALE     14
+
+#if defined(CONFIG_NET_TCP_WINDOW_SCALE)
+#define NET_TCP_MAX_WIN ((uint32_t)UINT16_MAX << NET_TCP_MAX_WIN_SCALE)
+#else
+#define NET_TCP_MAX_WIN UINT16_MAX
+#endif
+
+/* Number of SACK blocks kept from a received segment and in the
+ * scoreboard of the sender.
+ */
+#define NET_TCP_SACK_MAX_BLOCKS   4
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t tsval;
+	uint32_t tsecr;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_SACK_MAX_BLOCKS];
+	uint8_t sack_count;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
+	bool ts_found : 1;
 };
 
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 
+#if defined(CONFIG_NET_TCP_CA_CUBIC)
+struct tcp_ca_cubic {
+	uint32_t w_max; /* Congestion window before the last reduction */
+	uint32_t w_est; /* Congestion window New Reno would have */
+	uint32_t k; /* Time to grow back to w_max, in ms */
+	uint32_t epoch_start; /* Start of congestion avoidance in ms, 0 = none */
+};
+#endif
+
 struct tcp_collision_avoidance_reno {
-	uint16_t cwnd;
-	uint16_t ssthresh;
-	uint16_t pending_fast_retransmit_bytes;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t pending_fast_retransmit_bytes;
+#if defined(CONFIG_NET_TCP_CA_CUBIC)
+	struct tcp_ca_cubic cubic;
+#endif
+};
+
+struct tcp;
+
+/* Congestion control algorithm, selected per connection by its name with
+ * the TCP_CONGESTION socket option.
+ */
+struct tcp_ca_ops {
+	const char *name;
+	void (*init)(struct tcp *conn);
+	void (*fast_retransmit)(struct tcp *conn);
+	void (*timeout)(struct tcp *conn);
+	void (*dup_ack)(struct tcp *conn);
+	void (*pkts_acked)(struct tcp *conn, uint32_t acked_len);
+};
+
+#define TCP_CA_REGISTER(ca_name, init_func, fast_retransmit_func,	\
+			timeout_func, dup_ack_func, pkts_acked_func)	\
+	static const STRUCT_SECTION_ITERABLE(tcp_ca_ops,		\
+					     tcp_ca_##ca_name) = {	\
+		.name = STRINGIFY(ca_name),				\
+		.init = init_func,					\
+		.fast_retransmit = fast_retransmit_func,		\
+		.timeout = timeout_func,				\
+		.dup_ack = dup_ack_func,				\
+		.pkts_acked = pkts_acked_func,				\
+	}
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* Data the peer has selectively acknowledged, above conn->seq */
+struct tcp_sack_scoreboard {
+	/* SACKed ranges, sorted and not overlapping */
+	struct tcp_sack_block blocks[NET_TCP_SACK_MAX_BLOCKS];
+	/* Highest sequence sent when the loss recovery started */
+	uint32_t recovery_point;
+	/* Where to look for the next hole to retransmit */
+	uint32_t rexmit_next;
+	uint8_t count;
+	bool in_recovery : 1;
 };
 #endif
 
@@ -304,16 +393,27 @@ struct tcp { /* TCP connection */
 	uint32_t keep_cnt;
 	uint32_t keep_cur;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
-#ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
+#if defined(CONFIG_NET_TCP_TIMESTAMPS)
+	uint32_t ts_recent; /* Last timestamp of the peer, echoed back */
+	uint32_t srtt; /* Smoothed round-trip time in ms, scaled by 8 */
+	uint32_t rttvar; /* Round-trip time variation in ms, scaled by 4 */
+#endif
+#if defined(CONFIG_NET_TCP_RANDOMIZED_RTO) || defined(CONFIG_NET_TCP_TIMESTAMPS)
 	uint16_t rto;
 #endif
 #ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
 	struct tcp_collision_avoidance_reno ca;
+	const struct tcp_ca_ops *ca_ops;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_scoreboard sack;
 #endif
+	uint8_t snd_wscale; /* Shift of the windows the peer advertises */
+	uint8_t rcv_wscale; /* Shift of the windows we advertise */
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 	uint8_t dup_ack_cnt;
@@ -326,6 +426,9 @@ struct tcp { /* TCP connection */
 	bool keep_alive : 1;
 #endif /* CONFIG_NET_TCP_KEEPALIVE */
 	bool tcp_nodelay : 1;
+	bool wscale_ok : 1;
+	bool sack_ok : 1;
+	bool ts_ok : 1;
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -1951,6 +1951,219 @@ fail:
 #include <syscalls/zsock_recvmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_NET_SOCKETS_ZERO_COPY_RX)
+/* The buffers of a packet can be shared with a shallow clone of it, in which
+ * case they are not handed out but a copy of the packet is.
+ */
+static struct net_pkt *sock_pkt_unshare(struct net_pkt *pkt)
+{
+	struct net_buf *buf;
+
+	for (buf = pkt->buffer; buf != NULL; buf = buf->frags) {
+		if (buf->ref > 1) {
+			return net_pkt_clone(pkt, K_NO_WAIT);
+		}
+	}
+
+	return pkt;
+}
+
+/* Take the buffers holding the unread data away from the packet and free
+ * the packet together with the buffers of the headers.
+ */
+static struct net_buf *sock_pkt_detach_data(struct net_pkt *pkt)
+{
+	struct net_buf *frags = pkt->cursor.buf;
+	struct net_buf *buf = pkt->buffer;
+
+	while (buf != frags) {
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	net_buf_pull(frags, pkt->cursor.pos - frags->data);
+
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	while (frags != NULL && frags->len == 0U) {
+		frags = net_buf_frag_del(NULL, frags);
+	}
+
+	return frags;
+}
+
+static ssize_t zsock_recv_zc_ctx(struct net_context *ctx,
+				 struct net_buf **frags, int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt, *data_pkt;
+	k_timepoint_t end;
+	size_t len;
+	int res;
+
+	*frags = NULL;
+
+	if (flags & ZSOCK_MSG_PEEK) {
+		/* Lent data cannot stay queued */
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		if (!net_context_is_used(ctx)) {
+			errno = EBADF;
+			return -1;
+		}
+
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			errno = ENOTCONN;
+			return -1;
+		}
+	} else if (sock_type != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else if (!sock_is_eof(ctx) && !sock_is_error(ctx)) {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	}
+
+	for (end = sys_timepoint_calc(timeout); ; timeout = sys_timepoint_timeout(end)) {
+		if (sock_is_error(ctx)) {
+			errno = POINTER_TO_INT(ctx->user_data);
+			return -1;
+		}
+
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			res = zsock_wait_data(ctx, &timeout);
+			if (res < 0) {
+				errno = -res;
+				return -1;
+			}
+		}
+
+		/* Only dequeued once the data can be handed out */
+		pkt = k_fifo_peek_head(&ctx->recv_q);
+		if (pkt == NULL) {
+			if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+				errno = EAGAIN;
+				return -1;
+			}
+
+			continue;
+		}
+
+		data_pkt = pkt;
+
+		len = net_pkt_remaining_data(pkt);
+		if (len > 0) {
+			data_pkt = sock_pkt_unshare(pkt);
+			if (data_pkt == NULL) {
+				errno = ENOBUFS;
+				return -1;
+			}
+		}
+
+		(void)k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+
+		if (sock_type == SOCK_STREAM && net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+			net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+		}
+
+		if (len == 0) {
+			net_pkt_unref(pkt);
+
+			if (sock_type == SOCK_STREAM) {
+				continue;
+			}
+
+			/* Empty datagram */
+			return 0;
+		}
+
+		if (data_pkt != pkt) {
+			net_pkt_unref(pkt);
+		}
+
+		*frags = sock_pkt_detach_data(data_pkt);
+
+		return len;
+	}
+}
+
+ssize_t zsock_recv_zc(int sock, struct net_buf **frags, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	ssize_t ret;
+
+	if (frags == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* Only the native sockets queue net_pkt's */
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_recv_zc_ctx(obj, frags, flags);
+
+	k_mutex_unlock(lock);
+
+	sock_obj_core_update_recv_stats(sock, ret);
+
+	return ret;
+}
+
+void zsock_recv_zc_release(int sock, struct net_buf *frags, size_t len)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+
+	if (frags == NULL) {
+		return;
+	}
+
+	ctx = get_sock_vtable(sock, &vtable, NULL);
+
+	/* The receive window opens only once the data is consumed, by
+	 * what was lent rather than what is left in the buffers
+	 */
+	__ASSERT(net_buf_frags_len(frags) == len,
+		 "Chain changed while lent (%zu of %zu bytes)",
+		 net_buf_frags_len(frags), len);
+
+	if (ctx != NULL && vtable == &sock_fd_op_vtable &&
+	    net_context_get_type(ctx) == SOCK_STREAM) {
+		net_context_update_recv_wnd(ctx, len);
+	}
+
+	net_buf_unref(frags);
+}
+#endif /* CONFIG_NET_SOCKETS_ZERO_COPY_RX */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -2547,6 +2760,20 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 
@@ -3084,6 +3311,20 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 				return 0;
 			}
 
+			break;
+
+		case TCP_CONGESTION:
+			if (IS_ENABLED(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)) {
+				ret = net_tcp_set_option(ctx, TCP_OPT_CONGESTION,
+							 optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
 			break;
 		}
 		break;
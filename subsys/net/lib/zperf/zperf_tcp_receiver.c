@@ -99,6 +99,29 @@ static void tcp_received(const struct sockaddr *addr, size_t datalen)
 	}
 }
 
+#if defined(CONFIG_NET_ZPERF_ZERO_COPY_RX)
+static ssize_t tcp_recv_data(int sock)
+{
+	struct net_buf *frags;
+	ssize_t ret;
+
+	/* The data is only counted, so it is given back right away */
+	ret = zsock_recv_zc(sock, &frags, 0);
+	if (ret > 0) {
+		zsock_recv_zc_release(sock, frags, ret);
+	}
+
+	return ret;
+}
+#else
+static ssize_t tcp_recv_data(int sock)
+{
+	static uint8_t buf[TCP_RECEIVER_BUF_SIZE];
+
+	return zsock_recv(sock, buf, sizeof(buf), 0);
+}
+#endif /* CONFIG_NET_ZPERF_ZERO_COPY_RX */
+
 static int tcp_bind_listen_connection(struct zsock_pollfd *pollfd,
 				      struct sockaddr *address)
 {
@@ -140,7 +163,6 @@ static void tcp_session_error_report(void)
 
 static void tcp_server_session(void)
 {
-	static uint8_t buf[TCP_RECEIVER_BUF_SIZE];
 	static struct zsock_pollfd fds[SOCK_ID_MAX];
 	static struct sockaddr sock_addr[SOCK_ID_MAX];
 	int ret;
@@ -304,7 +326,7 @@ use_any_ipv6:
 					       addrlen);
 				}
 			} else if ((i > SOCK_ID_IPV6_LISTEN) && (i < SOCK_ID_MAX)) {
-				ret = zsock_recv(fds[i].fd, buf, sizeof(buf), 0);
+				ret = tcp_recv_data(fds[i].fd);
 				if (ret < 0) {
 					NET_ERR("recv failed on IPv%d socket (%d)",
 						(sock_addr[i].sa_family == AF_INET
@@ -364,8 +386,9 @@ void zperf_tcp_receiver_init(void)
 			tcp_receiver_thread,
 			NULL, NULL, NULL,
 			TCP_RECEIVER_THREAD_PRIORITY,
-			IS_ENABLED(CONFIG_USERSPACE) ? K_USER |
-						       K_INHERIT_PERMS : 0,
+			IS_ENABLED(CONFIG_USERSPACE) &&
+			!IS_ENABLED(CONFIG_NET_ZPERF_ZERO_COPY_RX) ?
+				K_USER | K_INHERIT_PERMS : 0,
 			K_NO_WAIT);
 }
 
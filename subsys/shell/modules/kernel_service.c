@@ -276,6 +276,84 @@ static int cmd_kernel_stacks(const struct shell *sh,
 }
 #endif
 
+#if defined(CONFIG_SCHED_THREAD_LATENCY) && defined(CONFIG_THREAD_MONITOR)
+static void shell_latency_print(const struct shell *sh,
+				const k_thread_runtime_stats_t *stats)
+{
+	shell_print(sh, "\tmax latency: %u cycles", stats->latency_max);
+
+	for (int i = 0; i < CONFIG_SCHED_THREAD_LATENCY_BUCKETS; i++) {
+		uint32_t low = (i == 0) ? 0U : BIT(i);
+
+		if (stats->latency[i] == 0U) {
+			continue;
+		}
+
+		if (i == CONFIG_SCHED_THREAD_LATENCY_BUCKETS - 1) {
+			shell_print(sh, "\t%10u -            cycles: %u",
+				    low, stats->latency[i]);
+		} else {
+			shell_print(sh, "\t%10u - %10u cycles: %u",
+				    low, (uint32_t)BIT(i + 1) - 1U,
+				    stats->latency[i]);
+		}
+	}
+}
+
+static void shell_latency_dump(const struct k_thread *cthread,
+			       void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const struct shell *sh = (const struct shell *)user_data;
+	k_thread_runtime_stats_t stats;
+	const char *tname;
+
+	if (k_thread_runtime_stats_get(thread, &stats) != 0) {
+		return;
+	}
+
+	tname = k_thread_name_get(thread);
+
+	shell_print(sh, "%p %-10s", thread, tname ? tname : "NA");
+	shell_latency_print(sh, &stats);
+}
+
+static int cmd_kernel_latency(const struct shell *sh,
+			      size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+	k_thread_runtime_stats_t stats;
+
+	shell_print(sh, "Scheduling latency, from ready to switched in:");
+
+#ifdef CONFIG_SMP
+	k_thread_foreach_unlocked(shell_latency_dump, (void *)sh);
+#else
+	k_thread_foreach(shell_latency_dump, (void *)sh);
+#endif
+
+#ifdef CONFIG_OBJ_CORE_STATS_SYSTEM
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (int i = 0; i < num_cpus; i++) {
+		if (k_obj_core_stats_query(K_OBJ_CORE(&_kernel.cpus[i]),
+					   &stats, sizeof(stats)) == 0) {
+			shell_print(sh, "CPU %d", i);
+			shell_latency_print(sh, &stats);
+		}
+	}
+#endif
+
+	if (k_thread_runtime_stats_all_get(&stats) == 0) {
+		shell_print(sh, "All CPUs");
+		shell_latency_print(sh, &stats);
+	}
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 extern struct sys_heap _system_heap;
 
@@ -402,6 +480,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 #endif
 #if defined(CONFIG_SYS_HEAP_RUNTIME_STATS) && (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 	SHELL_CMD(heap, NULL, "System heap usage statistics.", cmd_kernel_heap),
+#endif
+#if defined(CONFIG_SCHED_THREAD_LATENCY) && defined(CONFIG_THREAD_MONITOR)
+	SHELL_CMD(latency, NULL, "Threads scheduling latency histograms.",
+		  cmd_kernel_latency),
 #endif
 	SHELL_CMD_ARG(uptime, NULL, "Kernel uptime. Can be called with the -p or --pretty options",
 		      cmd_kernel_uptime, 1, 1),
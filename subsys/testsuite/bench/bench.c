@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <zephyr/sys/printk.h>
+
+#include <zephyr/bench.h>
+
+static uint32_t samples[CONFIG_TEST_BENCH_ITERATIONS];
+static uint32_t stamp_overhead;
+static uint32_t bench_count;
+
+static int sample_cmp(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static uint32_t overhead_sample(void)
+{
+	timing_t start, end;
+
+	start = bench_stamp();
+	end = bench_stamp();
+
+	return bench_cycles(&start, &end);
+}
+
+void bench_begin(void)
+{
+	timing_init();
+	timing_start();
+
+	stamp_overhead = UINT32_MAX;
+	for (int i = 0; i < CONFIG_TEST_BENCH_ITERATIONS; i++) {
+		stamp_overhead = MIN(stamp_overhead, overhead_sample());
+	}
+
+	printk("{\"suite\":\"%s\",\"board\":\"%s\","
+	       "\"clock\":\"%s\",\"unit\":\"%s\",",
+	       CONFIG_TEST_BENCH_SUITE, CONFIG_BOARD, BENCH_CLOCK, BENCH_UNIT);
+	if (bench_freq_hz() != 0U) {
+		printk("\"freq_hz\":%llu,", bench_freq_hz());
+	} else {
+		printk("\"freq_hz\":null,");
+	}
+	printk("\"overhead\":%u,\"warmup\":%u,\"iterations\":%u}\n",
+	       stamp_overhead, CONFIG_TEST_BENCH_WARMUP,
+	       CONFIG_TEST_BENCH_ITERATIONS);
+}
+
+void bench_run(const char *name, bench_sample_t sample, uint32_t ops)
+{
+	const uint32_t n = CONFIG_TEST_BENCH_ITERATIONS;
+
+	for (int i = 0; i < CONFIG_TEST_BENCH_WARMUP; i++) {
+		(void)sample();
+	}
+
+	for (uint32_t i = 0; i < n; i++) {
+		uint32_t cycles = sample();
+
+		cycles = (cycles > stamp_overhead) ? cycles - stamp_overhead : 0U;
+		samples[i] = cycles / ops;
+	}
+
+	qsort(samples, n, sizeof(samples[0]), sample_cmp);
+
+	/* Nearest-rank percentiles */
+	printk("{\"benchmark\":\"%s\",\"unit\":\"cycles\",\"iterations\":%u,"
+	       "\"min\":%u,\"median\":%u,\"p99\":%u,\"max\":%u}\n",
+	       name, n, samples[0], samples[(n + 1) / 2 - 1],
+	       samples[(n * 99 + 99) / 100 - 1], samples[n - 1]);
+
+	bench_count++;
+}
+
+void bench_end(void)
+{
+	timing_stop();
+
+	printk("{\"suite\":\"%s\",\"benchmarks\":%u}\n", CONFIG_TEST_BENCH_SUITE,
+	       bench_count);
+	printk("PROJECT EXECUTION SUCCESSFUL\n");
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_TESTSUITE_INCLUDE_BENCH_H_
+#define ZEPHYR_TESTSUITE_INCLUDE_BENCH_H_
+
+#include <zephyr/bench_clock.h>
+
+/**
+ * @brief Take one sample of a benchmark
+ *
+ * Performs one iteration of the measured operation and returns the
+ * number of cycles it took, as measured with bench_stamp() and
+ * bench_cycles(). Setup and cleanup the sample needs are done outside
+ * of the measured window.
+ */
+typedef uint32_t (*bench_sample_t)(void);
+
+/**
+ * @brief Start a benchmark run
+ *
+ * Starts the timing subsystem and prints the JSON header line, naming
+ * the suite CONFIG_TEST_BENCH_SUITE.  The header gives the clock, the unit
+ * of the samples and their rate in freq_hz, which is null when it is not
+ * known (the raw host TSC cycles of native_sim).
+ */
+void bench_begin(void);
+
+/**
+ * @brief Run one benchmark and print its results
+ *
+ * Discards CONFIG_TEST_BENCH_WARMUP samples, then takes
+ * CONFIG_TEST_BENCH_ITERATIONS samples and prints their minimum, median,
+ * 99th percentile and maximum as one line of JSON. The cost of a pair of
+ * back-to-back timestamps is subtracted from every sample.
+ *
+ * @param name Name of the benchmark.
+ * @param sample Function taking one sample.
+ * @param ops Number of measured operations per sample; the sample is
+ *            divided by it.
+ */
+void bench_run(const char *name, bench_sample_t sample, uint32_t ops);
+
+/**
+ * @brief End a benchmark run
+ *
+ * Stops the timing subsystem and prints the JSON trailer line.
+ */
+void bench_end(void);
+
+#endif /* ZEPHYR_TESTSUITE_INCLUDE_BENCH_H_ */
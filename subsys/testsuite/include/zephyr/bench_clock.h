@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_TESTSUITE_INCLUDE_BENCH_CLOCK_H_
+#define ZEPHYR_TESTSUITE_INCLUDE_BENCH_CLOCK_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+
+/* Timestamps for benchmarks and for the throughput checks of tests.
+ * The timing subsystem must have been started with timing_init() and
+ * timing_start().
+ *
+ * BENCH_UNIT names the unit of bench_cycles(), and bench_freq_hz() gives
+ * its rate, or 0 if that is not known.
+ */
+
+#if defined(CONFIG_ARCH_POSIX) && (defined(__x86_64__) || defined(__i386__))
+/* Simulated time stands still while code runs on native_sim, so read
+ * the host TSC there instead
+ */
+#define BENCH_CLOCK "host_tsc"
+#define BENCH_UNIT "raw_host_tsc_cycles"
+
+static inline timing_t bench_stamp(void)
+{
+	uint32_t lo, hi;
+
+	__asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+	return ((uint64_t)hi << 32) | lo;
+}
+
+static inline uint64_t bench_cycles(timing_t *start, timing_t *end)
+{
+	return *end - *start;
+}
+
+/* The rate of the host TSC is not known to the simulated CPU */
+static inline uint64_t bench_freq_hz(void)
+{
+	return 0;
+}
+
+/* Not known either, reported as 0 */
+static inline uint64_t bench_ns(uint64_t cycles)
+{
+	ARG_UNUSED(cycles);
+
+	return 0;
+}
+#else
+#define BENCH_CLOCK "timing"
+#define BENCH_UNIT "cycles"
+
+static inline timing_t bench_stamp(void)
+{
+	return timing_counter_get();
+}
+
+static inline uint64_t bench_cycles(timing_t *start, timing_t *end)
+{
+	return timing_cycles_get(start, end);
+}
+
+static inline uint64_t bench_freq_hz(void)
+{
+	return timing_freq_get();
+}
+
+static inline uint64_t bench_ns(uint64_t cycles)
+{
+	return timing_cycles_to_ns(cycles);
+}
+#endif
+
+#endif /* ZEPHYR_TESTSUITE_INCLUDE_BENCH_CLOCK_H_ */
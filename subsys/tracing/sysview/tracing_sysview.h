@@ -141,6 +141,9 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_work_submit_exit(work, ret)                                               \
 	SEGGER_SYSVIEW_RecordEndCallU32(TID_WORK_SUBMIT, (uint32_t)ret)
 
+#define sys_port_trace_k_work_submit_batch_to_queue_enter(queue, count)
+#define sys_port_trace_k_work_submit_batch_to_queue_exit(queue, count, ret)
+
 #define sys_port_trace_k_work_flush_enter(work)                                                    \
 	SEGGER_SYSVIEW_RecordU32(TID_WORK_FLUSH, (uint32_t)(uintptr_t)work)
 
@@ -230,6 +233,9 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_work_cancel_delayable_exit(dwork, ret)                                    \
 	SEGGER_SYSVIEW_RecordEndCallU32(TID_WORK_CANCEL_DELAYABLE, (uint32_t)ret)
 
+#define sys_port_trace_k_work_cancel_delayable_batch_enter(count)
+#define sys_port_trace_k_work_cancel_delayable_batch_exit(count, ret)
+
 #define sys_port_trace_k_work_cancel_delayable_sync_enter(dwork, sync)                             \
 	SEGGER_SYSVIEW_RecordU32x2(TID_WORK_CANCEL_DELAYABLE_SYNC, (uint32_t)(uintptr_t)dwork,     \
 				   (uint32_t)(uintptr_t)sync)
@@ -69,6 +69,8 @@
 #define sys_port_trace_k_work_submit_to_queue_exit(queue, work, ret)
 #define sys_port_trace_k_work_submit_enter(work)
 #define sys_port_trace_k_work_submit_exit(work, ret)
+#define sys_port_trace_k_work_submit_batch_to_queue_enter(queue, count)
+#define sys_port_trace_k_work_submit_batch_to_queue_exit(queue, count, ret)
 #define sys_port_trace_k_work_flush_enter(work)
 #define sys_port_trace_k_work_flush_blocking(work, timeout)
 #define sys_port_trace_k_work_flush_exit(work, ret)
@@ -99,6 +101,8 @@
 #define sys_port_trace_k_work_flush_delayable_exit(dwork, sync, ret)
 #define sys_port_trace_k_work_cancel_delayable_enter(dwork)
 #define sys_port_trace_k_work_cancel_delayable_exit(dwork, ret)
+#define sys_port_trace_k_work_cancel_delayable_batch_enter(count)
+#define sys_port_trace_k_work_cancel_delayable_batch_exit(count, ret)
 #define sys_port_trace_k_work_cancel_delayable_sync_enter(dwork, sync)
 #define sys_port_trace_k_work_cancel_delayable_sync_exit(dwork, sync, ret)
 
@@ -153,6 +153,12 @@ static void test_thread_entry(void *p1, void *p2, void *p3)
 	}
 
 	pipe_test();
+
+	/* Vectored pipe calls and work queues are kernel-only */
+	if (!skip_mem_and_mbox) {
+		pipe_vec_test();
+		work_queue_test();
+	}
 }
 
 /**
@@ -0,0 +1,107 @@
+/* pipe_vec_b.c */
+
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "master.h"
+
+#define NR_OF_PIPE_VEC_RUNS 64
+#define MAX_PIPE_VEC_SEGS (MESSAGE_SIZE_PIPE / 8)
+
+static struct k_pipe_iovec pipe_vec[MAX_PIPE_VEC_SEGS];
+
+#define PRINT_PIPE_VEC_HEADER()                                          \
+	do {                                                             \
+		PRINT_STRING("|  frag  |  time/message (nsec)         |" \
+			     "           KB/sec             |      |\n"); \
+		PRINT_STRING(dashline);                                  \
+		PRINT_STRING("|   (B)  |   put   |   putv  |   getv   |" \
+			     "   put   |   putv  |   getv   |      |\n"); \
+		PRINT_STRING(dashline);                                  \
+	} while (0)
+
+#define PRINT_PIPE_VEC()                                                  \
+	PRINT_F("|%8u|%9u|%9u|%10u|%9u|%9u|%10u|      |\n",                   \
+		fragsize, puttime, putvtime, gettime,                     \
+		(uint32_t)(((uint64_t)MESSAGE_SIZE_PIPE * 1000000U) /     \
+			   SAFE_DIVISOR(puttime)),                        \
+		(uint32_t)(((uint64_t)MESSAGE_SIZE_PIPE * 1000000U) /     \
+			   SAFE_DIVISOR(putvtime)),                       \
+		(uint32_t)(((uint64_t)MESSAGE_SIZE_PIPE * 1000000U) /     \
+			   SAFE_DIVISOR(gettime)))
+
+/**
+ * @brief Vectored pipe transfer test
+ *
+ * Writes a MESSAGE_SIZE_PIPE message made of equally sized fragments into
+ * a buffered pipe, once with one k_pipe_put() per fragment and once with a
+ * single k_pipe_putv(), and reads it back into fragments with k_pipe_getv().
+ */
+void pipe_vec_test(void)
+{
+	struct k_pipe *pipe = &PIPE_BIGBUFF;
+	uint32_t fragsize;
+	uint32_t puttime;
+	uint32_t putvtime;
+	uint32_t gettime;
+	uint32_t et_put;
+	uint32_t et_putv;
+	uint32_t et_get;
+	timing_t  start;
+	timing_t  end;
+	size_t xferd;
+
+	PRINT_STRING("|                "
+		     "V E C T O R E D   P I P E   T R A N S F E R S"
+		     "                |\n");
+	PRINT_STRING(dashline);
+	PRINT_PIPE_VEC_HEADER();
+
+	for (fragsize = 8U; fragsize <= 256U; fragsize <<= 1) {
+		size_t nsegs = MESSAGE_SIZE_PIPE / fragsize;
+
+		for (size_t i = 0; i < nsegs; i++) {
+			pipe_vec[i].iov_base = &data_bench[i * fragsize];
+			pipe_vec[i].iov_len = fragsize;
+		}
+
+		et_put = 0;
+		et_putv = 0;
+		et_get = 0;
+		for (int run = 0; run < NR_OF_PIPE_VEC_RUNS; run++) {
+			start = timing_timestamp_get();
+			for (size_t i = 0; i < nsegs; i++) {
+				k_pipe_put(pipe, pipe_vec[i].iov_base, fragsize,
+					   &xferd, fragsize, K_NO_WAIT);
+			}
+			end = timing_timestamp_get();
+			et_put += (uint32_t)timing_cycles_get(&start, &end);
+			k_pipe_flush(pipe);
+
+			start = timing_timestamp_get();
+			k_pipe_putv(pipe, pipe_vec, nsegs, &xferd,
+				    MESSAGE_SIZE_PIPE, K_NO_WAIT);
+			end = timing_timestamp_get();
+			et_putv += (uint32_t)timing_cycles_get(&start, &end);
+
+			/* Read the message back in place, fragment by fragment */
+			start = timing_timestamp_get();
+			k_pipe_getv(pipe, pipe_vec, nsegs, &xferd,
+				    MESSAGE_SIZE_PIPE, K_NO_WAIT);
+			end = timing_timestamp_get();
+			et_get += (uint32_t)timing_cycles_get(&start, &end);
+		}
+
+		puttime = SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et_put,
+							NR_OF_PIPE_VEC_RUNS);
+		putvtime = SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et_putv,
+							 NR_OF_PIPE_VEC_RUNS);
+		gettime = SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et_get,
+							NR_OF_PIPE_VEC_RUNS);
+		PRINT_PIPE_VEC();
+	}
+	PRINT_STRING(dashline);
+}
@@ -0,0 +1,122 @@
+/* workq_b.c */
+
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "master.h"
+
+#define WORKQ_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_DEFINE(workq_stack, WORKQ_STACK_SIZE);
+static struct k_work_q workq;
+
+static struct k_work work_items[NR_OF_WORK_ITEMS];
+static struct k_work *work_batch[NR_OF_WORK_ITEMS];
+static struct k_work_delayable dwork_items[NR_OF_WORK_ITEMS];
+static struct k_work_delayable *dwork_batch[NR_OF_WORK_ITEMS];
+
+static K_SEM_DEFINE(work_done, 0, 1);
+static atomic_t work_left;
+
+static void work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	if (atomic_dec(&work_left) == 1) {
+		k_sem_give(&work_done);
+	}
+}
+
+/* Let the lower priority queue thread run the submitted items */
+static void work_wait(void)
+{
+	k_sem_take(&work_done, K_FOREVER);
+	atomic_set(&work_left, NR_OF_WORK_ITEMS);
+}
+
+static void dwork_schedule(void)
+{
+	for (int i = 0; i < NR_OF_WORK_ITEMS; i++) {
+		k_work_schedule_for_queue(&workq, &dwork_items[i],
+					  K_SECONDS(10));
+	}
+}
+
+/**
+ * @brief Work item submit and cancel test
+ *
+ * Compares submitting and cancelling NR_OF_WORK_ITEMS items one at a
+ * time against doing so with a single batch call.
+ */
+void work_queue_test(void)
+{
+	uint32_t et_single = 0;
+	uint32_t et_batch = 0;
+	uint32_t ec_single = 0;
+	uint32_t ec_batch = 0;
+	timing_t  start;
+	timing_t  end;
+
+	k_work_queue_start(&workq, workq_stack,
+			   K_THREAD_STACK_SIZEOF(workq_stack),
+			   k_thread_priority_get(k_current_get()) + 1, NULL);
+
+	for (int i = 0; i < NR_OF_WORK_ITEMS; i++) {
+		k_work_init(&work_items[i], work_handler);
+		work_batch[i] = &work_items[i];
+		k_work_init_delayable(&dwork_items[i], work_handler);
+		dwork_batch[i] = &dwork_items[i];
+	}
+	atomic_set(&work_left, NR_OF_WORK_ITEMS);
+
+	for (int run = 0; run < NR_OF_WORK_RUNS; run++) {
+		start = timing_timestamp_get();
+		for (int i = 0; i < NR_OF_WORK_ITEMS; i++) {
+			k_work_submit_to_queue(&workq, &work_items[i]);
+		}
+		end = timing_timestamp_get();
+		et_single += (uint32_t)timing_cycles_get(&start, &end);
+		work_wait();
+
+		start = timing_timestamp_get();
+		k_work_submit_batch_to_queue(&workq, work_batch,
+					     NR_OF_WORK_ITEMS);
+		end = timing_timestamp_get();
+		et_batch += (uint32_t)timing_cycles_get(&start, &end);
+		work_wait();
+
+		dwork_schedule();
+		start = timing_timestamp_get();
+		for (int i = 0; i < NR_OF_WORK_ITEMS; i++) {
+			k_work_cancel_delayable(&dwork_items[i]);
+		}
+		end = timing_timestamp_get();
+		ec_single += (uint32_t)timing_cycles_get(&start, &end);
+
+		dwork_schedule();
+		start = timing_timestamp_get();
+		k_work_cancel_delayable_batch(dwork_batch, NR_OF_WORK_ITEMS);
+		end = timing_timestamp_get();
+		ec_batch += (uint32_t)timing_cycles_get(&start, &end);
+	}
+
+	k_work_queue_drain(&workq, true);
+	k_thread_abort(k_work_queue_thread_get(&workq));
+
+	PRINT_F(FORMAT, "average submit work item, one by one",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et_single,
+			(NR_OF_WORK_RUNS * NR_OF_WORK_ITEMS)));
+	PRINT_F(FORMAT, "average submit work item, in batches",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et_batch,
+			(NR_OF_WORK_RUNS * NR_OF_WORK_ITEMS)));
+	PRINT_F(FORMAT, "average cancel delayable work item, one by one",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(ec_single,
+			(NR_OF_WORK_RUNS * NR_OF_WORK_ITEMS)));
+	PRINT_F(FORMAT, "average cancel delayable work item, in batches",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(ec_batch,
+			(NR_OF_WORK_RUNS * NR_OF_WORK_ITEMS)));
+	PRINT_STRING(dashline);
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+#include <zephyr/bench_clock.h>
+
+/* This is a k_heap throughput benchmark.  A number of equal priority
+ * threads each keep LIVE_BLOCKS blocks allocated from one shared heap,
+ * and for OPS_PER_THREAD rounds free a random one of them and allocate
+ * a new block of random size between MIN_SIZE and MAX_SIZE bytes in
+ * its place.  The main thread measures the time from starting the
+ * workers until the last one has finished.
+ */
+
+#define MAX_THREADS    16
+#define LIVE_BLOCKS    8
+#define OPS_PER_THREAD 20000
+#define MIN_SIZE       16
+#define MAX_SIZE       256
+#define STACK_SIZE     (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static const int n_threads[] = { 1, 4, MAX_THREADS };
+
+K_HEAP_DEFINE(bench_heap, MAX_THREADS * LIVE_BLOCKS * (MAX_SIZE + 16) * 2);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+static K_SEM_DEFINE(done_sem, 0, MAX_THREADS);
+static atomic_t failures;
+
+static inline uint32_t bench_rand(uint32_t *state)
+{
+	/* Deterministic LCG so every configuration sees the same sizes */
+	*state = *state * 1103515245U + 12345U;
+	return *state >> 8;
+}
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	uint32_t state = (uint32_t)(uintptr_t)p1;
+	void *live[LIVE_BLOCKS] = { NULL };
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < OPS_PER_THREAD; i++) {
+		uint32_t r = bench_rand(&state);
+		int slot = r % LIVE_BLOCKS;
+		size_t size = MIN_SIZE + (r >> 4) % (MAX_SIZE - MIN_SIZE + 1);
+
+		k_heap_free(&bench_heap, live[slot]);
+		live[slot] = k_heap_alloc(&bench_heap, size, K_NO_WAIT);
+		if (live[slot] == NULL) {
+			atomic_inc(&failures);
+		}
+	}
+
+	for (int i = 0; i < LIVE_BLOCKS; i++) {
+		k_heap_free(&bench_heap, live[i]);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void run(int n)
+{
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+	uint32_t ops = n * OPS_PER_THREAD;
+	uint64_t cycles, ns;
+	timing_t start, end;
+
+	atomic_clear(&failures);
+
+	/* The workers are of lower priority, so none of them runs until
+	 * we block on the semaphore.
+	 */
+	for (int i = 0; i < n; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, worker,
+				(void *)(uintptr_t)(0x2545f491 + i), NULL, NULL,
+				prio, 0, K_FOREVER);
+	}
+
+	start = bench_stamp();
+	for (int i = 0; i < n; i++) {
+		k_thread_start(&threads[i]);
+	}
+	for (int i = 0; i < n; i++) {
+		k_sem_take(&done_sem, K_FOREVER);
+	}
+	end = bench_stamp();
+
+	for (int i = 0; i < n; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	cycles = bench_cycles(&start, &end);
+	ns = bench_ns(cycles);
+
+	printk("threads %2d ops %7u cycles/op %5u allocs/s %9u\n", n, ops,
+	       (uint32_t)(cycles / ops),
+	       (ns != 0) ? (uint32_t)((uint64_t)ops * NSEC_PER_SEC / ns) : 0U);
+
+	if (atomic_get(&failures) != 0) {
+		printk("%d allocations failed, results invalid\n",
+		       (int)atomic_get(&failures));
+	}
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	printk("heap cache: %s\n",
+	       IS_ENABLED(CONFIG_HEAP_CACHE) ? "enabled" : "disabled");
+
+	for (int i = 0; i < ARRAY_SIZE(n_threads); i++) {
+		run(n_threads[i]);
+	}
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/bench.h>
+
+/* Kernel micro-benchmarks.  Each benchmark measures one short kernel
+ * operation (or a pair that undoes itself, such as a give and a take)
+ * from the main thread, without contention unless stated otherwise.
+ * The switch and wake benchmarks use a helper thread; the others run
+ * entirely in the main thread.
+ */
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MSG_SIZE   16
+
+static K_THREAD_STACK_DEFINE(helper_stack, STACK_SIZE);
+static struct k_thread helper_thread;
+static volatile bool helper_stop;
+static timing_t helper_stamp;
+
+static K_SEM_DEFINE(bench_sem, 0, 1);
+static K_MUTEX_DEFINE(bench_mutex);
+K_MSGQ_DEFINE(bench_msgq, MSG_SIZE, 4, 4);
+static K_FIFO_DEFINE(bench_fifo);
+K_PIPE_DEFINE(bench_pipe, 64, 4);
+static K_EVENT_DEFINE(bench_event);
+static K_HEAP_DEFINE(bench_heap, 1024);
+
+static struct k_timer bench_timer;
+static uint8_t msg[MSG_SIZE];
+static struct {
+	void *fifo_reserved;
+} fifo_item;
+
+static void helper_start(k_thread_entry_t entry, int prio)
+{
+	helper_stop = false;
+	k_thread_create(&helper_thread, helper_stack, STACK_SIZE, entry,
+			NULL, NULL, NULL, prio, 0, K_NO_WAIT);
+}
+
+static void yield_loop(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!helper_stop) {
+		k_yield();
+	}
+}
+
+static uint32_t thread_create(void)
+{
+	timing_t start, end;
+
+	start = bench_stamp();
+	k_thread_create(&helper_thread, helper_stack, STACK_SIZE,
+			yield_loop, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_FOREVER);
+	end = bench_stamp();
+
+	k_thread_abort(&helper_thread);
+
+	return bench_cycles(&start, &end);
+}
+
+static void empty_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+}
+
+/* The lifecycle samples below create a thread that runs to completion
+ * and join it
+ */
+static uint32_t thread_create_join(void)
+{
+	timing_t start, end;
+
+	start = bench_stamp();
+	k_thread_create(&helper_thread, helper_stack, STACK_SIZE, empty_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	k_thread_join(&helper_thread, K_FOREVER);
+	end = bench_stamp();
+
+	return bench_cycles(&start, &end);
+}
+
+#ifdef CONFIG_DYNAMIC_THREAD
+static uint32_t thread_dynamic_create_join(void)
+{
+	k_thread_stack_t *stack;
+	timing_t start, end;
+
+	start = bench_stamp();
+	stack = k_thread_stack_alloc(STACK_SIZE, 0);
+	k_thread_create(&helper_thread, stack, STACK_SIZE, empty_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	k_thread_join(&helper_thread, K_FOREVER);
+	k_thread_stack_free(stack);
+	end = bench_stamp();
+
+	return bench_cycles(&start, &end);
+}
+#endif
+
+#ifdef CONFIG_THREAD_POOL
+K_THREAD_POOL_DEFINE(bench_pool, 1, STACK_SIZE, 0);
+
+static void done_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_give(p1);
+}
+
+/* Pool threads do not exit, so completion is signaled instead */
+static uint32_t thread_pool_spawn_wait(void)
+{
+	timing_t start, end;
+
+	start = bench_stamp();
+	k_thread_pool_spawn(&bench_pool, done_entry, &bench_sem, NULL, NULL,
+			    K_PRIO_PREEMPT(1), K_FOREVER);
+	k_sem_take(&bench_sem, K_FOREVER);
+	end = bench_stamp();
+
+	return bench_cycles(&start, &end);
+}
+#endif
+
+/* The helper yields straight back, so one sample is two switches */
+static uint32_t thread_switch(void)
+{
+	timing_t start, end;
+
+	start = bench_stamp();
+	k_yield();
+	end = bench_stamp();
+
+	return bench_cycles(&start, &end);
+}
+
+static void sem_waiter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!helper_stop) {
+		k_sem_take(&bench_sem, K_FOREVER);
+		helper_stamp = bench_stamp();
+	}
+}
+
+/* Time from giving the semaphore until the higher priority waiter runs */
+static uint32_t sem_wake(void)
+{
+	timing_t start;
+
+	start = bench_stamp();
+	k_sem_give(&bench_sem);
+
+	return bench_cycles(&start, &helper_stamp);
+}
+
+static uint32_t sem_give_take(void)
+{
+	timing_t start, end;
+
+	start = bench_stamp();
+	k_sem_give(&bench_sem);
+	k_sem_take(&bench_sem, K_NO_WAIT);
+	end = bench_stamp();
+
+	return bench_cycles(&start, &end);
+}
+
+static uint32_t mutex_lock_unlock(void)
+{
+	timing_t start, end;
+
+	start = bench_stamp();
+	k_mutex_lock(&bench_mutex, K_NO_WAIT);
+	k_mutex_unlock(&bench_mutex);
+	end = bench_stamp();
+
+	return bench_cycles(&start, &end);
+}
+
+static uint32_t msgq_put_get(void)
+{
+	timing_t start, end;
+
+	start = bench_stamp();
+	k_msgq_put(&bench_msgq, msg, K_NO_WAIT);
+	k_msgq_get(&bench_msgq, msg, K_NO_WAIT);
+	end = bench_stamp();
+
+	return bench_cycles(&start, &end);
+}
+
+static uint32_t fifo_put_get(void)
+{
+	timing_t start, end;
+
+	start = bench_stamp();
+	k_fifo_put(&bench_fifo, &fifo_item);
+	(void)k_fifo_get(&bench_fifo, K_NO_WAIT);
+	end = bench_stamp();
+
+	return bench_cycles(&start, &end);
+}
+
+static uint32_t pipe_put_get(void)
+{
+	timing_t start, end;
+	size_t bytes;
+
+	start = bench_stamp();
+	k_pipe_put(&bench_pipe, msg, MSG_SIZE, &bytes, MSG_SIZE, K_NO_WAIT);
+	k_pipe_get(&bench_pipe, msg, MSG_SIZE, &bytes, MSG_SIZE, K_NO_WAIT);
+	end = bench_stamp();
+
+	return bench_cycles(&start, &end);
+}
+
+static uint32_t event_post_wait(void)
+{
+	timing_t start, end;
+
+	start = bench_stamp();
+	k_event_post(&bench_event, BIT(0));
+	(void)k_event_wait(&bench_event, BIT(0), false, K_NO_WAIT);
+	k_event_clear(&bench_event, BIT(0));
+	end = bench_stamp();
+
+	return bench_cycles(&start, &end);
+}
+
+static uint32_t timer_start_stop(void)
+{
+	timing_t start, end;
+
+	start = bench_stamp();
+	k_timer_start(&bench_timer, K_MSEC(100), K_NO_WAIT);
+	k_timer_stop(&bench_timer);
+	end = bench_stamp();
+
+	return bench_cycles(&start, &end);
+}
+
+static uint32_t heap_alloc_free(void)
+{
+	timing_t start, end;
+	void *block;
+
+	start = bench_stamp();
+	block = k_heap_alloc(&bench_heap, 64, K_NO_WAIT);
+	k_heap_free(&bench_heap, block);
+	end = bench_stamp();
+
+	return bench_cycles(&start, &end);
+}
+
+int main(void)
+{
+	int prio = k_thread_priority_get(k_current_get());
+
+	k_timer_init(&bench_timer, NULL, NULL);
+
+	bench_begin();
+
+	bench_run("thread.create", thread_create, 1);
+	bench_run("thread.create_join", thread_create_join, 1);
+#ifdef CONFIG_DYNAMIC_THREAD
+	bench_run("thread.dynamic_create_join", thread_dynamic_create_join, 1);
+#endif
+#ifdef CONFIG_THREAD_POOL
+	bench_run("thread.pool_spawn_wait", thread_pool_spawn_wait, 1);
+#endif
+
+	helper_start(yield_loop, prio);
+	bench_run("thread.switch", thread_switch, 2);
+	helper_stop = true;
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	helper_start(sem_waiter, prio - 1);
+	bench_run("sem.wake", sem_wake, 1);
+	helper_stop = true;
+	k_sem_give(&bench_sem);
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	bench_run("sem.give_take", sem_give_take, 1);
+	bench_run("mutex.lock_unlock", mutex_lock_unlock, 1);
+	bench_run("msgq.put_get", msgq_put_get, 1);
+	bench_run("fifo.put_get", fifo_put_get, 1);
+	bench_run("pipe.put_get", pipe_put_get, 1);
+	bench_run("event.post_wait", event_post_wait, 1);
+	bench_run("timer.start_stop", timer_start_stop, 1);
+	bench_run("heap.alloc_free", heap_alloc_free, 1);
+
+	bench_end();
+
+	return 0;
+}
@@ -45,6 +45,7 @@ extern void sema_test_signal(uint32_t num_iterations, uint32_t options);
 extern void mutex_lock_unlock(uint32_t num_iterations, uint32_t options);
 extern void sema_context_switch(uint32_t num_iterations,
 				uint32_t start_options, uint32_t alt_options);
+extern void sema_waitq(uint32_t num_iterations);
 extern int thread_ops(uint32_t num_iterations, uint32_t start_options,
 		      uint32_t alt_options);
 extern void heap_malloc_free(void);
@@ -102,6 +103,8 @@ static void test_thread(void *arg1, void *arg2, void *arg3)
 	sema_context_switch(NUM_ITERATIONS, K_USER, K_USER);
 #endif
 
+	sema_waitq(NUM_ITERATIONS);
+
 	mutex_lock_unlock(NUM_ITERATIONS, 0);
 #ifdef CONFIG_USERSPACE
 	mutex_lock_unlock(NUM_ITERATIONS, K_USER);
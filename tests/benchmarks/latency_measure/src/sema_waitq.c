@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file measure semaphore pend and wake times with many waiters
+ *
+ * This file contains the test that measures how the wait queue backend
+ * (CONFIG_WAITQ_DUMB, CONFIG_WAITQ_SCALABLE or CONFIG_WAITQ_MULTIQ)
+ * scales when many threads at a handful of priorities are blocked on
+ * the same semaphore.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include "utils.h"
+#include "timing_sc.h"
+
+#define NUM_WAITERS    32
+#define NUM_PRIORITIES 4
+
+#if defined(CONFIG_WAITQ_SCALABLE)
+#define WAITQ_NAME "scalable"
+#elif defined(CONFIG_WAITQ_MULTIQ)
+#define WAITQ_NAME "multiq"
+#else
+#define WAITQ_NAME "dumb"
+#endif
+
+static K_THREAD_STACK_ARRAY_DEFINE(waiter_stacks, NUM_WAITERS,
+				   ALT_STACK_SIZE);
+static struct k_thread waiter_threads[NUM_WAITERS];
+
+static struct k_sem  sem;
+
+/* Timestamp taken by the last waiter right before it pended, or 0 */
+static timing_t pend_start;
+static uint64_t pend_sum;
+static uint32_t pend_count;
+
+static void pend_finished(void)
+{
+	timing_t finish = timing_timestamp_get();
+
+	if (pend_start != 0) {
+		pend_sum += timing_cycles_get(&pend_start, &finish);
+		pend_count++;
+	}
+}
+
+static void waiter_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		pend_start = timing_timestamp_get();
+		k_sem_take(&sem, K_FOREVER);
+
+		/*
+		 * Woken waiters only run once the main thread has dropped
+		 * below them again, so this marks the end of the pend of
+		 * whichever thread ran before us.
+		 */
+
+		pend_finished();
+	}
+}
+
+void sema_waitq(uint32_t num_iterations)
+{
+	timing_t  start;
+	timing_t  finish;
+	uint64_t  give_sum = 0ull;
+	uint32_t  give_count = 0U;
+	uint32_t  rounds = num_iterations / NUM_WAITERS;
+	char description[80];
+	int  priority;
+	int  high_priority;
+
+	timing_start();
+
+	k_sem_init(&sem, 0, NUM_WAITERS);
+
+	priority = k_thread_priority_get(k_current_get());
+	high_priority = priority - NUM_PRIORITIES - 1;
+
+	/*
+	 * The waiters are of higher priority than this thread, so each
+	 * one runs and blocks on <sem> as soon as it is started.
+	 */
+
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		k_thread_create(&waiter_threads[i], waiter_stacks[i],
+				K_THREAD_STACK_SIZEOF(waiter_stacks[i]),
+				waiter_entry, NULL, NULL, NULL,
+				priority - 1 - (i % NUM_PRIORITIES), 0,
+				K_NO_WAIT);
+	}
+
+	pend_sum = 0ull;
+	pend_count = 0U;
+
+	for (uint32_t r = 0; r < rounds; r++) {
+
+		/*
+		 * 1. Rise above the waiters and wake them one by one. None
+		 * of them runs yet, so only the wake is measured.
+		 */
+
+		k_thread_priority_set(k_current_get(), high_priority);
+
+		for (int i = 0; i < NUM_WAITERS; i++) {
+			start = timing_timestamp_get();
+			k_sem_give(&sem);
+			finish = timing_timestamp_get();
+
+			give_sum += timing_cycles_get(&start, &finish);
+			give_count++;
+		}
+
+		/*
+		 * 2. Drop back below the waiters.  They run in priority
+		 * order and each pends on <sem> again, switching to the
+		 * next one, and the last one switches back to us.
+		 */
+
+		pend_start = 0;
+		k_thread_priority_set(k_current_get(), priority);
+		pend_finished();
+	}
+
+	for (int i = 0; i < NUM_WAITERS; i++) {
+		k_thread_abort(&waiter_threads[i]);
+	}
+
+	/* Both sums hold about <num_iterations> samples */
+
+	give_sum -= timestamp_overhead_adjustment(0, 0);
+	pend_sum -= timestamp_overhead_adjustment(0, 0);
+
+	snprintf(description, sizeof(description),
+		 "Give a semaphore (%d waiters, %s wait_q)",
+		 NUM_WAITERS, WAITQ_NAME);
+	PRINT_STATS_AVG(description, (uint32_t)give_sum, give_count,
+			false, "");
+
+	snprintf(description, sizeof(description),
+		 "Pend and switch (%d waiters, %s wait_q)",
+		 NUM_WAITERS, WAITQ_NAME);
+	PRINT_STATS_AVG(description, (uint32_t)pend_sum, pend_count,
+			false, "");
+
+	timing_stop();
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+
+#include <zephyr/bench_clock.h>
+
+/* This is a k_msgq throughput benchmark.  N_MSGS messages of MSG_SIZE
+ * bytes go through a queue of QUEUE_LEN slots, once copied in and out
+ * of the queue with k_msgq_put()/k_msgq_get(), and once built and read
+ * in place with the zero-copy calls.
+ *
+ * With one thread, the main thread alternately fills and drains the
+ * queue, which measures the cost of the calls themselves.  With two
+ * threads, a producer and a consumer thread of the same priority run
+ * until the consumer has checked the last message, which includes the
+ * context switches each time the queue fills up or runs empty.
+ */
+
+#define N_MSGS     20000 /* multiple of QUEUE_LEN */
+#define MSG_SIZE   256
+#define MSG_WORDS  (MSG_SIZE / sizeof(uint32_t))
+#define QUEUE_LEN  16
+#define STACK_SIZE (1024 + MSG_SIZE + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_MSGQ_DEFINE(bench_msgq, MSG_SIZE, QUEUE_LEN, sizeof(uint32_t));
+
+static K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
+static struct k_thread producer_thread;
+static struct k_thread consumer_thread;
+static K_SEM_DEFINE(done_sem, 0, 1);
+static uint32_t errors;
+
+static inline void msg_fill(uint32_t *msg, uint32_t seq)
+{
+	for (int i = 0; i < MSG_WORDS; i++) {
+		msg[i] = seq + i;
+	}
+}
+
+static inline void msg_check(const uint32_t *msg, uint32_t seq)
+{
+	uint32_t sum = 0U;
+
+	for (int i = 0; i < MSG_WORDS; i++) {
+		sum += msg[i] - i;
+	}
+	if (sum != seq * MSG_WORDS) {
+		errors++;
+	}
+}
+
+static void copy_producer(void *p1, void *p2, void *p3)
+{
+	uint32_t msg[MSG_WORDS];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t seq = 0; seq < N_MSGS; seq++) {
+		msg_fill(msg, seq);
+		k_msgq_put(&bench_msgq, msg, K_FOREVER);
+	}
+}
+
+static void copy_consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t msg[MSG_WORDS];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t seq = 0; seq < N_MSGS; seq++) {
+		k_msgq_get(&bench_msgq, msg, K_FOREVER);
+		msg_check(msg, seq);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void zc_producer(void *p1, void *p2, void *p3)
+{
+	void *slot;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t seq = 0; seq < N_MSGS; seq++) {
+		k_msgq_reserve(&bench_msgq, &slot, K_FOREVER);
+		msg_fill(slot, seq);
+		k_msgq_commit(&bench_msgq);
+	}
+}
+
+static void zc_consumer(void *p1, void *p2, void *p3)
+{
+	void *msg;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t seq = 0; seq < N_MSGS; seq++) {
+		k_msgq_claim(&bench_msgq, &msg, K_FOREVER);
+		msg_check(msg, seq);
+		k_msgq_release(&bench_msgq);
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void report(const char *name, int threads, uint64_t cycles)
+{
+	uint64_t ns = bench_ns(cycles);
+
+	printk("%-9s threads %d msgs %6u cycles/msg %6u MB/s %5u\n", name,
+	       threads, N_MSGS, (uint32_t)(cycles / N_MSGS),
+	       (ns != 0) ? (uint32_t)((uint64_t)N_MSGS * MSG_SIZE * 1000U / ns)
+			 : 0U);
+
+	if (errors != 0U) {
+		printk("%u messages corrupted, results invalid\n", errors);
+	}
+}
+
+static void run_local(const char *name, bool zero_copy)
+{
+	uint32_t msg[MSG_WORDS];
+	uint64_t cycles = 0U;
+	timing_t start, end;
+	void *ptr;
+
+	errors = 0U;
+	k_msgq_purge(&bench_msgq);
+
+	for (uint32_t seq = 0; seq < N_MSGS; seq += QUEUE_LEN) {
+		start = bench_stamp();
+		for (uint32_t i = seq; i < seq + QUEUE_LEN; i++) {
+			if (zero_copy) {
+				k_msgq_reserve(&bench_msgq, &ptr, K_NO_WAIT);
+				msg_fill(ptr, i);
+				k_msgq_commit(&bench_msgq);
+			} else {
+				msg_fill(msg, i);
+				k_msgq_put(&bench_msgq, msg, K_NO_WAIT);
+			}
+		}
+		for (uint32_t i = seq; i < seq + QUEUE_LEN; i++) {
+			if (zero_copy) {
+				k_msgq_claim(&bench_msgq, &ptr, K_NO_WAIT);
+				msg_check(ptr, i);
+				k_msgq_release(&bench_msgq);
+			} else {
+				k_msgq_get(&bench_msgq, msg, K_NO_WAIT);
+				msg_check(msg, i);
+			}
+		}
+		end = bench_stamp();
+		cycles += bench_cycles(&start, &end);
+	}
+
+	report(name, 1, cycles);
+}
+
+static void run(const char *name, k_thread_entry_t producer,
+		k_thread_entry_t consumer)
+{
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+	timing_t start, end;
+
+	errors = 0U;
+	k_msgq_purge(&bench_msgq);
+
+	/* Both threads are of lower priority, so neither runs until we
+	 * block on the semaphore.
+	 */
+	k_thread_create(&producer_thread, producer_stack, STACK_SIZE,
+			producer, NULL, NULL, NULL, prio, 0, K_FOREVER);
+	k_thread_create(&consumer_thread, consumer_stack, STACK_SIZE,
+			consumer, NULL, NULL, NULL, prio, 0, K_FOREVER);
+
+	start = bench_stamp();
+	k_thread_start(&producer_thread);
+	k_thread_start(&consumer_thread);
+	k_sem_take(&done_sem, K_FOREVER);
+	end = bench_stamp();
+
+	k_thread_join(&producer_thread, K_FOREVER);
+	k_thread_join(&consumer_thread, K_FOREVER);
+
+	report(name, 2, bench_cycles(&start, &end));
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	run_local("copy", false);
+	run_local("zero-copy", true);
+	run("copy", copy_producer, copy_consumer);
+	run("zero-copy", zc_producer, zc_consumer);
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "connection.h"
+#include <zephyr/bench.h>
+
+/* Connection lookup benchmark.  A number of UDP connections is registered
+ * and net_conn_input() is fed a packet for the connection registered
+ * first, which is the last one a scan of all connections would find.  The
+ * connections are either connected, sharing the local port and differing
+ * in the remote port, or bound to different local ports.
+ */
+
+#define LOCAL_PORT  5000
+#define REMOTE_PORT 10000
+
+static const int conn_counts[] = { 1, 8, 32, CONFIG_NET_MAX_CONN };
+
+static const struct in6_addr local_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+						0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static const struct in6_addr remote_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+						 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static struct net_conn_handle *handles[CONFIG_NET_MAX_CONN];
+static struct net_pkt *pkt;
+static struct net_ipv6_hdr ipv6_hdr;
+static struct net_udp_hdr udp_hdr;
+static union net_ip_header ip_hdr = { .ipv6 = &ipv6_hdr };
+static union net_proto_header proto_hdr = { .udp = &udp_hdr };
+static uint32_t delivered;
+
+static enum net_verdict conn_cb(struct net_conn *conn, struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	/* Keep the packet for the next sample */
+	delivered++;
+
+	return NET_OK;
+}
+
+static uint32_t conn_input(void)
+{
+	timing_t start, end;
+
+	start = bench_stamp();
+	(void)net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	end = bench_stamp();
+
+	return bench_cycles(&start, &end);
+}
+
+static int conns_register(int count, bool connected)
+{
+	struct sockaddr_in6 local = {
+		.sin6_family = AF_INET6,
+		.sin6_addr = local_addr,
+	};
+	struct sockaddr_in6 remote = {
+		.sin6_family = AF_INET6,
+		.sin6_addr = remote_addr,
+	};
+	int ret;
+
+	for (int i = 0; i < count; i++) {
+		ret = net_conn_register(IPPROTO_UDP, AF_INET6,
+					connected ? (struct sockaddr *)&remote : NULL,
+					(struct sockaddr *)&local,
+					connected ? REMOTE_PORT + i : 0,
+					connected ? LOCAL_PORT : LOCAL_PORT + i,
+					NULL, conn_cb, NULL, &handles[i]);
+		if (ret < 0) {
+			printk("Cannot register connection %d (%d)\n", i, ret);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+static void conns_unregister(int count)
+{
+	for (int i = 0; i < count; i++) {
+		(void)net_conn_unregister(handles[i]);
+	}
+}
+
+static int bench_conns(const char *kind, bool connected)
+{
+	char name[32];
+	uint32_t expected;
+
+	for (int i = 0; i < ARRAY_SIZE(conn_counts); i++) {
+		if (conns_register(conn_counts[i], connected) < 0) {
+			return -ENOMEM;
+		}
+
+		delivered = 0U;
+		snprintk(name, sizeof(name), "conn.udp6_%s.%d", kind,
+			 conn_counts[i]);
+		bench_run(name, conn_input, 1);
+		expected = CONFIG_TEST_BENCH_WARMUP + CONFIG_TEST_BENCH_ITERATIONS;
+
+		conns_unregister(conn_counts[i]);
+
+		if (delivered != expected) {
+			printk("%s: %u of %u packets delivered\n", name,
+			       delivered, expected);
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+int main(void)
+{
+	pkt = net_pkt_rx_alloc(K_FOREVER);
+	net_pkt_set_iface(pkt, net_if_get_default());
+	net_pkt_set_family(pkt, AF_INET6);
+
+	memcpy(ipv6_hdr.src, &remote_addr, sizeof(remote_addr));
+	memcpy(ipv6_hdr.dst, &local_addr, sizeof(local_addr));
+	ipv6_hdr.nexthdr = IPPROTO_UDP;
+	udp_hdr.src_port = htons(REMOTE_PORT);
+	udp_hdr.dst_port = htons(LOCAL_PORT);
+
+	bench_begin();
+
+	if (bench_conns("connected", true) < 0 ||
+	    bench_conns("bound", false) < 0) {
+		return 0;
+	}
+
+	bench_end();
+
+	net_pkt_unref(pkt);
+
+	return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* SMP part of the scheduler benchmark.  For 1..N CPUs it pins a
+ * "waker" thread and a higher priority "wakee" thread to each CPU in
+ * use.  Every waker then repeatedly gives a semaphore the wakee is
+ * blocked on, so all CPUs hammer the scheduler at the same time, and
+ * measures per round trip:
+ *
+ * - wakeup: from k_sem_give() until the wakee runs
+ * - switch: from the wakee blocking again until the waker resumes
+ *
+ * Both threads of a pair live on the same CPU, so the timestamps
+ * never compare counters of different CPUs.
+ */
+
+BUILD_ASSERT(IS_ENABLED(CONFIG_SCHED_CPU_MASK),
+	     "SMP scheduler benchmark pins threads to CPUs");
+
+#define N_RUNS   1000
+#define N_SETTLE 10
+#define STACK_SIZE 1024
+
+struct pair {
+	struct k_sem sem;
+	volatile uint32_t t_give;
+	volatile uint32_t t_wake;
+	uint64_t wakeup;
+	uint64_t swtch;
+};
+
+static struct pair pairs[CONFIG_MP_MAX_NUM_CPUS];
+static struct k_thread wakers[CONFIG_MP_MAX_NUM_CPUS];
+static struct k_thread wakees[CONFIG_MP_MAX_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(waker_stacks, CONFIG_MP_MAX_NUM_CPUS,
+				   STACK_SIZE);
+static K_THREAD_STACK_ARRAY_DEFINE(wakee_stacks, CONFIG_MP_MAX_NUM_CPUS,
+				   STACK_SIZE);
+
+static inline uint32_t smp_stamp(void)
+{
+	uint32_t t;
+
+	/* Same clock as the uniprocessor part, see _stamp() */
+#ifdef CONFIG_X86
+	__asm__ volatile("rdtsc" : "=a"(t) : : "edx");
+#else
+	t = k_cycle_get_32();
+#endif
+	return t;
+}
+
+static void wakee_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct pair *p = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_take(&p->sem, K_FOREVER);
+		p->t_wake = smp_stamp();
+	}
+}
+
+static void waker_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct pair *p = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < N_RUNS + N_SETTLE; i++) {
+		/* The wakee has higher priority and shares our CPU, so
+		 * it runs (and blocks again) before k_sem_give() returns
+		 */
+		p->t_give = smp_stamp();
+		k_sem_give(&p->sem);
+		uint32_t t_back = smp_stamp();
+
+		if (i >= N_SETTLE) {
+			p->wakeup += p->t_wake - p->t_give;
+			p->swtch += t_back - p->t_wake;
+		}
+	}
+}
+
+static void run(int ncpus)
+{
+	/* Preemptible, or the wakee could not preempt its waker */
+	int prio = k_thread_priority_get(k_current_get()) + 2;
+	uint64_t wakeup = 0U, swtch = 0U;
+
+	for (int cpu = 0; cpu < ncpus; cpu++) {
+		struct pair *p = &pairs[cpu];
+
+		k_sem_init(&p->sem, 0, 1);
+		p->wakeup = 0U;
+		p->swtch = 0U;
+
+		k_thread_create(&wakees[cpu], wakee_stacks[cpu], STACK_SIZE,
+				wakee_fn, p, NULL, NULL, prio - 1, 0,
+				K_FOREVER);
+		k_thread_cpu_pin(&wakees[cpu], cpu);
+		k_thread_create(&wakers[cpu], waker_stacks[cpu], STACK_SIZE,
+				waker_fn, p, NULL, NULL, prio, 0, K_FOREVER);
+		k_thread_cpu_pin(&wakers[cpu], cpu);
+	}
+
+	/* Wakees first, so they are blocked on their semaphores (modulo
+	 * the settle rounds) by the time the wakers start
+	 */
+	for (int cpu = 0; cpu < ncpus; cpu++) {
+		k_thread_start(&wakees[cpu]);
+	}
+	for (int cpu = 0; cpu < ncpus; cpu++) {
+		k_thread_start(&wakers[cpu]);
+	}
+
+	for (int cpu = 0; cpu < ncpus; cpu++) {
+		k_thread_join(&wakers[cpu], K_FOREVER);
+		k_thread_abort(&wakees[cpu]);
+		wakeup += pairs[cpu].wakeup;
+		swtch += pairs[cpu].swtch;
+	}
+
+	printk("cpus %d wakeup %5u switch %5u\n", ncpus,
+	       (uint32_t)(wakeup / ((uint64_t)N_RUNS * ncpus)),
+	       (uint32_t)(swtch / ((uint64_t)N_RUNS * ncpus)));
+}
+
+void run_smp_bench(void)
+{
+	printk("ready queue: %s\n",
+	       IS_ENABLED(CONFIG_SCHED_WORK_STEALING) ? "work stealing" :
+							"global");
+
+	for (int ncpus = 1; ncpus <= arch_num_cpus(); ncpus++) {
+		run(ncpus);
+	}
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/drivers/timer/system_timer.h>
+#include <timeout_q.h>
+
+#include <zephyr/bench_clock.h>
+
+/* This is a timeout queue microbenchmark.  It fills the kernel
+ * timeout queue with a number of "background" timeouts spread far
+ * enough into the future never to expire during the run, then
+ * measures, with interrupts locked:
+ *
+ * 1. z_add_timeout() of a probe timeout at a random position among
+ *    the background ones
+ * 2. z_abort_timeout() of the probe
+ * 3. sys_clock_announce() of the tick on which a re-armed probe
+ *    expires
+ *
+ * The announcements are injected directly, so uptime runs ahead of
+ * the wall clock while the benchmark executes.
+ */
+
+#define N_RUNS 100
+#define BACKGROUND_MIN_TICKS 100000
+#define BACKGROUND_SPAN_TICKS 1000000
+
+static const int n_pending[] = { 10, 1000, 10000 };
+
+#ifdef CONFIG_SMP
+void run_smp_contention(void);
+#endif
+
+static struct _timeout background[10000];
+static struct _timeout probe;
+static volatile int probe_fired;
+
+static uint32_t rand_state = 0x2545f491;
+
+static uint32_t bench_rand(void)
+{
+	/* Deterministic LCG so every backend sees the same sequence */
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static void background_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	printk("background timeout expired, results invalid\n");
+}
+
+static void probe_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	probe_fired++;
+}
+
+static void run(int n)
+{
+	uint64_t insert = 0U, abort = 0U, announce = 0U;
+	timing_t t0, t1, t2;
+
+	for (int i = 0; i < n; i++) {
+		k_ticks_t dt = BACKGROUND_MIN_TICKS +
+			       bench_rand() % BACKGROUND_SPAN_TICKS;
+
+		z_add_timeout(&background[i], background_fn, K_TICKS(dt));
+	}
+
+	for (int i = 0; i < N_RUNS; i++) {
+		k_ticks_t dt = BACKGROUND_MIN_TICKS +
+			       bench_rand() % BACKGROUND_SPAN_TICKS;
+		unsigned int key = irq_lock();
+
+		t0 = bench_stamp();
+		z_add_timeout(&probe, probe_fn, K_TICKS(dt));
+		t1 = bench_stamp();
+		z_abort_timeout(&probe);
+		t2 = bench_stamp();
+
+		insert += bench_cycles(&t0, &t1);
+		abort += bench_cycles(&t1, &t2);
+
+		/* A K_TICKS(0) timeout expires on the tick after the
+		 * ones already elapsed
+		 */
+		int32_t ticks = 1 + sys_clock_elapsed();
+		int fired = probe_fired;
+
+		z_add_timeout(&probe, probe_fn, K_TICKS(0));
+		t0 = bench_stamp();
+		sys_clock_announce(ticks);
+		t1 = bench_stamp();
+
+		announce += bench_cycles(&t0, &t1);
+
+		if (probe_fired != fired + 1) {
+			printk("probe did not expire\n");
+		}
+
+		irq_unlock(key);
+	}
+
+	for (int i = 0; i < n; i++) {
+		z_abort_timeout(&background[i]);
+	}
+
+	printk("pending %5d insert %5u abort %5u announce %5u\n", n,
+	       (uint32_t)(insert / N_RUNS), (uint32_t)(abort / N_RUNS),
+	       (uint32_t)(announce / N_RUNS));
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	printk("timeout queue: %s\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "wheel" : "dlist");
+
+	for (int i = 0; i < ARRAY_SIZE(n_pending); i++) {
+		run(n_pending[i]);
+	}
+
+#ifdef CONFIG_SMP
+	run_smp_contention();
+#endif
+
+	timing_stop();
+	printk("fin\n");
+	return 0;
+}
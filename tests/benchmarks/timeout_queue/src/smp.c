@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <timeout_q.h>
+
+/* SMP contention scenario: one thread pinned to each of the first
+ * N CPUs arms and cancels its own timeout in a tight loop, all
+ * starting at the same time.  With a single global timeout queue the
+ * per-operation cost grows with N as every CPU bounces the same lock;
+ * with CONFIG_TIMEOUT_QUEUE_PER_CPU it should stay roughly flat.
+ */
+
+#define SMP_ITERS 10000
+#define SMP_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(smp_stacks, CONFIG_MP_MAX_NUM_CPUS,
+				   SMP_STACK_SIZE);
+static struct k_thread smp_threads[CONFIG_MP_MAX_NUM_CPUS];
+static struct _timeout smp_timeouts[CONFIG_MP_MAX_NUM_CPUS];
+static uint64_t smp_cycles[CONFIG_MP_MAX_NUM_CPUS];
+static atomic_t smp_go;
+
+static void smp_timeout_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void smp_worker(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	timing_t start, end;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!atomic_get(&smp_go)) {
+	}
+
+	start = timing_counter_get();
+	for (int i = 0; i < SMP_ITERS; i++) {
+		z_add_timeout(&smp_timeouts[id], smp_timeout_fn,
+			      K_TICKS(1000000));
+		z_abort_timeout(&smp_timeouts[id]);
+	}
+	end = timing_counter_get();
+
+	smp_cycles[id] = timing_cycles_get(&start, &end);
+}
+
+static void run_smp(int ncpus)
+{
+	uint64_t total = 0U;
+
+	atomic_clear(&smp_go);
+
+	for (int i = 0; i < ncpus; i++) {
+		k_thread_create(&smp_threads[i], smp_stacks[i],
+				K_THREAD_STACK_SIZEOF(smp_stacks[i]),
+				smp_worker, INT_TO_POINTER(i), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_FOREVER);
+		k_thread_cpu_pin(&smp_threads[i], i);
+		k_thread_start(&smp_threads[i]);
+	}
+
+	atomic_set(&smp_go, 1);
+
+	for (int i = 0; i < ncpus; i++) {
+		k_thread_join(&smp_threads[i], K_FOREVER);
+		total += smp_cycles[i];
+	}
+
+	printk("cpus %d arm+cancel %5u\n", ncpus,
+	       (uint32_t)(total / ((uint64_t)ncpus * SMP_ITERS)));
+}
+
+void run_smp_contention(void)
+{
+	printk("per-CPU timeout queues: %s\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_PER_CPU) ? "yes" : "no");
+
+	for (int n = 1; n <= arch_num_cpus(); n++) {
+		run_smp(n);
+	}
+}
@@ -296,3 +296,60 @@ ZTEST(mheap_api, test_multi_heap)
 		zassert_not_null(blocks[i], "final re-allocation failed");
 	}
 }
+
+/**
+ * @brief Test k_malloc() slab size classes
+ *
+ * @ingroup kernel_heap_tests
+ *
+ * @details Allocate every block of the smallest slab size class,
+ * check that the class statistics account for them and that one more
+ * request falls back to the heap, then free everything.
+ *
+ * @see k_malloc_slab_stats_get()
+ */
+ZTEST(mheap_api, test_malloc_slab_classes)
+{
+#ifdef CONFIG_HEAP_MEM_POOL_SLABS
+	void *block[CONFIG_HEAP_MEM_POOL_SLAB_BLOCKS], *extra;
+	struct k_malloc_slab_stats stats;
+	size_t size;
+
+	zassert_equal(k_malloc_slab_stats_get(CONFIG_HEAP_MEM_POOL_SLAB_CLASSES,
+					      &stats), -EINVAL);
+	zassert_equal(k_malloc_slab_stats_reset_max(0), 0);
+	zassert_equal(k_malloc_slab_stats_get(0, &stats), 0);
+	zassert_equal(stats.fallbacks, 0);
+	zassert_equal(stats.slab.allocated_bytes, 0);
+
+	/* Largest request still fitting the smallest class */
+	size = stats.block_size - sizeof(void *);
+
+	for (int i = 0; i < ARRAY_SIZE(block); i++) {
+		block[i] = k_malloc(size);
+		zassert_not_null(block[i], "slab allocation failed");
+	}
+
+	zassert_equal(k_malloc_slab_stats_get(0, &stats), 0);
+	zassert_equal(stats.slab.allocated_bytes,
+		      ARRAY_SIZE(block) * stats.block_size);
+	zassert_equal(stats.slab.free_bytes, 0);
+
+	extra = k_malloc(size);
+	zassert_not_null(extra, "heap fallback failed");
+	zassert_equal(k_malloc_slab_stats_get(0, &stats), 0);
+	zassert_equal(stats.fallbacks, 1);
+
+	k_free(extra);
+	for (int i = 0; i < ARRAY_SIZE(block); i++) {
+		k_free(block[i]);
+	}
+
+	zassert_equal(k_malloc_slab_stats_get(0, &stats), 0);
+	zassert_equal(stats.slab.allocated_bytes, 0);
+	zassert_equal(stats.slab.max_allocated_bytes,
+		      ARRAY_SIZE(block) * stats.block_size);
+#else
+	ztest_test_skip();
+#endif
+}
@@ -113,6 +113,12 @@ static void print_paging_stats(struct k_mem_paging_stats_t *stats, const char *s
 	       stats->eviction.clean);
 	printk("    - Dirty pages evicted: %lu\n",
 	       stats->eviction.dirty);
+	printk("    - Recently accessed pages evicted: %lu\n",
+	       stats->eviction.accessed);
+	printk("    - Refaults: %lu\n", stats->eviction.refaults);
+
+	printk("* Read-ahead (%s):\n", scope);
+	printk("    - Pages read ahead: %lu\n", stats->readahead.pages);
 }
 
 ZTEST(demand_paging, test_touch_anon_pages)
@@ -155,10 +161,21 @@ ZTEST(demand_paging, test_touch_anon_pages)
 	print_paging_stats(&stats, "kernel");
 	zassert_not_equal(stats.eviction.dirty, 0UL,
 			  "there should be dirty pages being evicted.");
+#ifdef CONFIG_EVICTION_CLOCK
+	/* Sweeping an arena larger than RAM, the hand finds every page frame
+	 * used since it last came by, and has to take a second turn
+	 */
+	zassert_not_equal(stats.eviction.accessed, 0UL,
+			  "there should be recently accessed pages evicted.");
+#endif
 
-#ifdef CONFIG_EVICTION_NRU
+#if defined(CONFIG_EVICTION_NRU)
 	k_msleep(CONFIG_EVICTION_NRU_PERIOD * 2);
-#endif /* CONFIG_EVICTION_NRU */
+#elif defined(CONFIG_EVICTION_AGING)
+	k_msleep(CONFIG_EVICTION_AGING_PERIOD * 2);
+#elif defined(CONFIG_EVICTION_WORKING_SET)
+	k_msleep(CONFIG_EVICTION_WORKING_SET_WINDOW * 2);
+#endif
 
 	/* There should be some clean pages to be evicted now,
 	 * since the arena is not modified.
@@ -194,13 +211,16 @@ ZTEST(demand_paging, test_touch_anon_pages)
 
 static void test_k_mem_page_out(void)
 {
-	unsigned long faults;
+	struct k_mem_paging_stats_t stats;
+	unsigned long faults, read_ahead;
 	int key, ret;
 
 	/* Lock IRQs to prevent other pagefaults from happening while we
 	 * are measuring stuff
 	 */
 	key = irq_lock();
+	k_mem_paging_stats_get(&stats);
+	read_ahead = stats.readahead.pages;
 	faults = z_num_pagefaults_get();
 	ret = k_mem_page_out(arena, HALF_BYTES);
 	zassert_equal(ret, 0, "k_mem_page_out failed with %d", ret);
@@ -210,11 +230,16 @@ static void test_k_mem_page_out(void)
 		arena[i] = nums[i % 10];
 	}
 	faults = z_num_pagefaults_get() - faults;
+	k_mem_paging_stats_get(&stats);
+	read_ahead = stats.readahead.pages - read_ahead;
 	irq_unlock(key);
 
-	zassert_equal(faults, HALF_PAGES,
-		      "unexpected num pagefaults expected %lu got %d",
-		      HALF_PAGES, faults);
+	/* Every page either faulted or was read ahead, and read-ahead may
+	 * go past the end of the region
+	 */
+	zassert_true(faults <= HALF_PAGES && faults + read_ahead >= HALF_PAGES,
+		     "unexpected num pagefaults expected %lu got %d",
+		     HALF_PAGES, faults);
 
 	ret = k_mem_page_out(arena, arena_size);
 	zassert_equal(ret, -ENOMEM, "k_mem_page_out should have failed");
@@ -288,6 +313,47 @@ ZTEST(demand_paging_api, test_k_mem_unpin)
 	test_k_mem_page_out();
 }
 
+ZTEST(demand_paging_api, test_read_ahead)
+{
+	struct k_mem_paging_stats_t stats;
+	unsigned long faults, read_ahead;
+	int key, ret;
+
+	if (CONFIG_DEMAND_PAGING_READ_AHEAD == 0) {
+		ztest_test_skip();
+	}
+
+	key = irq_lock();
+
+	ret = k_mem_page_out(arena, HALF_BYTES);
+	zassert_equal(ret, 0, "k_mem_page_out failed with %d", ret);
+
+	k_mem_paging_stats_get(&stats);
+	read_ahead = stats.readahead.pages;
+	faults = z_num_pagefaults_get();
+	/* Read the evicted region front to back */
+	for (size_t i = 0; i < HALF_BYTES; i++) {
+		zassert_equal(arena[i], nums[i % 10],
+			      "arena corrupted at index %d (%p): got 0x%hhx expected 0x%hhx",
+			      i, &arena[i], arena[i], nums[i % 10]);
+	}
+	faults = z_num_pagefaults_get() - faults;
+	k_mem_paging_stats_get(&stats);
+	read_ahead = stats.readahead.pages - read_ahead;
+	irq_unlock(key);
+
+	printk("%lu page faults, %lu pages read ahead\n", faults, read_ahead);
+
+	/* The first two faults establish the run, then each fault brings
+	 * in up to CONFIG_DEMAND_PAGING_READ_AHEAD more pages
+	 */
+	zassert_true(faults + read_ahead >= HALF_PAGES,
+		     "pages neither faulted nor read ahead");
+	zassert_true(faults <= 2 + DIV_ROUND_UP(HALF_PAGES - 2,
+						CONFIG_DEMAND_PAGING_READ_AHEAD + 1),
+		     "%lu page faults, read-ahead ineffective", faults);
+}
+
 /* Show that even if we map enough anonymous memory to fill the backing
  * store, we can still handle pagefaults.
  * This eats up memory so should be last in the suite.
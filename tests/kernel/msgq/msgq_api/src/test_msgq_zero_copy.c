@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#ifdef CONFIG_MSGQ_ZERO_COPY
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+static char __aligned(4) zc_buffer[MSG_SIZE * MSGQ_LEN];
+static struct k_msgq zc_msgq;
+
+static void put_zc(struct k_msgq *q, uint32_t data)
+{
+	void *slot;
+
+	zassert_equal(k_msgq_reserve(q, &slot, K_NO_WAIT), 0);
+	*(uint32_t *)slot = data;
+	zassert_equal(k_msgq_commit(q), 0);
+}
+
+static void claim_entry(void *p1, void *p2, void *p3)
+{
+	void *msg;
+
+	zassert_equal(k_msgq_claim(p1, &msg, K_FOREVER), 0);
+	zassert_equal(*(uint32_t *)msg, MSG1);
+	zassert_equal(k_msgq_release(p1), 0);
+}
+
+static void reserve_entry(void *p1, void *p2, void *p3)
+{
+	void *slot;
+
+	zassert_equal(k_msgq_reserve(p1, &slot, K_FOREVER), 0);
+	*(uint32_t *)slot = MSG1;
+	zassert_equal(k_msgq_commit(p1), 0);
+}
+
+static void get_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t data;
+
+	zassert_equal(k_msgq_get(p1, &data, K_FOREVER), 0);
+	zassert_equal(data, MSG0);
+}
+
+static void put_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t data = MSG1;
+
+	zassert_equal(k_msgq_put(p1, &data, K_FOREVER), 0);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test writing and reading messages in place
+ * @see k_msgq_reserve(), k_msgq_commit(), k_msgq_claim(), k_msgq_release()
+ */
+ZTEST(msgq_api, test_msgq_zero_copy)
+{
+	uint32_t data = MSG0;
+	void *slot;
+	void *msg;
+
+	k_msgq_init(&zc_msgq, zc_buffer, MSG_SIZE, MSGQ_LEN);
+
+	/* A reserved slot isn't visible until committed */
+	zassert_equal(k_msgq_reserve(&zc_msgq, &slot, K_NO_WAIT), 0);
+	zassert_equal(k_msgq_reserve(&zc_msgq, &msg, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_msgq_put(&zc_msgq, &data, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_msgq_put(&zc_msgq, &data, TIMEOUT), -EAGAIN);
+	zassert_equal(k_msgq_num_free_get(&zc_msgq), MSGQ_LEN - 1);
+	zassert_equal(k_msgq_claim(&zc_msgq, &msg, K_NO_WAIT), -ENOMSG);
+	*(uint32_t *)slot = MSG0;
+	zassert_equal(k_msgq_commit(&zc_msgq), 0);
+	zassert_equal(k_msgq_commit(&zc_msgq), -EINVAL);
+	put_zc(&zc_msgq, MSG1);
+	zassert_equal(k_msgq_reserve(&zc_msgq, &slot, TIMEOUT), -EAGAIN);
+
+	/* Claimed messages are read in place and in order */
+	zassert_equal(k_msgq_claim(&zc_msgq, &msg, K_NO_WAIT), 0);
+	zassert_equal(msg, (void *)zc_buffer);
+	zassert_equal(*(uint32_t *)msg, MSG0);
+	zassert_equal(k_msgq_claim(&zc_msgq, &slot, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_msgq_get(&zc_msgq, &data, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_msgq_get(&zc_msgq, &data, TIMEOUT), -EAGAIN);
+	zassert_equal(k_msgq_num_used_get(&zc_msgq), MSGQ_LEN);
+	zassert_equal(k_msgq_release(&zc_msgq), 0);
+	zassert_equal(k_msgq_release(&zc_msgq), -EINVAL);
+
+	/* Copying and zero-copy calls can be mixed */
+	zassert_equal(k_msgq_get(&zc_msgq, &data, K_NO_WAIT), 0);
+	zassert_equal(data, MSG1);
+	zassert_equal(k_msgq_claim(&zc_msgq, &msg, TIMEOUT), -EAGAIN);
+
+	/* Purging keeps a claimed message until it is released */
+	put_zc(&zc_msgq, MSG0);
+	zassert_equal(k_msgq_claim(&zc_msgq, &msg, K_NO_WAIT), 0);
+	k_msgq_purge(&zc_msgq);
+	data = MSG1;
+	zassert_equal(k_msgq_put(&zc_msgq, &data, K_NO_WAIT), 0);
+	zassert_equal(*(uint32_t *)msg, MSG0);
+	zassert_equal(k_msgq_release(&zc_msgq), 0);
+	zassert_equal(k_msgq_num_used_get(&zc_msgq), 1);
+	zassert_equal(k_msgq_get(&zc_msgq, &data, K_NO_WAIT), 0);
+	zassert_equal(data, MSG1);
+}
+
+/**
+ * @brief Test blocking in zero-copy calls
+ * @see k_msgq_reserve(), k_msgq_commit(), k_msgq_claim(), k_msgq_release()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_zero_copy_blocking)
+{
+	uint32_t data = MSG1;
+	void *msg;
+
+	k_msgq_init(&zc_msgq, zc_buffer, MSG_SIZE, MSGQ_LEN);
+
+	/* A put wakes a thread waiting to claim */
+	k_thread_create(&tdata, tstack, STACK_SIZE, claim_entry,
+			&zc_msgq, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	zassert_equal(k_msgq_put(&zc_msgq, &data, K_NO_WAIT), 0);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(&zc_msgq), 0);
+
+	/* A release wakes a thread waiting to reserve */
+	put_zc(&zc_msgq, MSG0);
+	put_zc(&zc_msgq, MSG0);
+	k_thread_create(&tdata, tstack, STACK_SIZE, reserve_entry,
+			&zc_msgq, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	zassert_equal(k_msgq_claim(&zc_msgq, &msg, K_NO_WAIT), 0);
+	zassert_equal(k_msgq_release(&zc_msgq), 0);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_msgq_get(&zc_msgq, &data, K_NO_WAIT), 0);
+	zassert_equal(data, MSG0);
+	zassert_equal(k_msgq_get(&zc_msgq, &data, K_NO_WAIT), 0);
+	zassert_equal(data, MSG1);
+
+	/* A commit hands the message to a thread waiting to get */
+	k_thread_create(&tdata, tstack, STACK_SIZE, get_entry,
+			&zc_msgq, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	put_zc(&zc_msgq, MSG0);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(&zc_msgq), 0);
+
+	/* A commit wakes a thread waiting to put, in order */
+	zassert_equal(k_msgq_reserve(&zc_msgq, &msg, K_NO_WAIT), 0);
+	k_thread_create(&tdata, tstack, STACK_SIZE, put_entry,
+			&zc_msgq, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	*(uint32_t *)msg = MSG0;
+	zassert_equal(k_msgq_commit(&zc_msgq), 0);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_msgq_get(&zc_msgq, &data, K_NO_WAIT), 0);
+	zassert_equal(data, MSG0);
+	zassert_equal(k_msgq_get(&zc_msgq, &data, K_NO_WAIT), 0);
+	zassert_equal(data, MSG1);
+
+	/* A release wakes a thread waiting to get */
+	put_zc(&zc_msgq, MSG1);
+	put_zc(&zc_msgq, MSG0);
+	zassert_equal(k_msgq_claim(&zc_msgq, &msg, K_NO_WAIT), 0);
+	k_thread_create(&tdata, tstack, STACK_SIZE, get_entry,
+			&zc_msgq, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	zassert_equal(*(uint32_t *)msg, MSG1);
+	zassert_equal(k_msgq_release(&zc_msgq), 0);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(&zc_msgq), 0);
+}
+
+/**
+ * @}
+ */
+
+#endif /* CONFIG_MSGQ_ZERO_COPY */
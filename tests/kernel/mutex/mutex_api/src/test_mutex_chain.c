@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define LOW_PRIO K_PRIO_PREEMPT(10)
+#define MID_PRIO K_PRIO_PREEMPT(8)
+#define HIGH_PRIO K_PRIO_PREEMPT(5)
+#define HIGH_WAIT_MS 100
+
+static struct k_mutex chain_mutex1;
+static struct k_mutex chain_mutex2;
+
+static K_THREAD_STACK_DEFINE(mid_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(high_stack, STACK_SIZE);
+static struct k_thread mid_thread;
+static struct k_thread high_thread;
+
+static int high_ret;
+
+static void chain_stats_get(struct k_mutex *mutex, struct k_mutex_stats *stats)
+{
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	zassert_ok(k_obj_core_stats_raw(K_OBJ_CORE(mutex), stats,
+					sizeof(*stats)));
+#else
+	ARG_UNUSED(mutex);
+	*stats = (struct k_mutex_stats){};
+#endif
+}
+
+static void mid_entry(void *p1, void *p2, void *p3)
+{
+	zassert_ok(k_mutex_lock(&chain_mutex2, K_FOREVER));
+	zassert_ok(k_mutex_lock(&chain_mutex1, K_FOREVER));
+	zassert_ok(k_mutex_unlock(&chain_mutex1));
+	zassert_ok(k_mutex_unlock(&chain_mutex2));
+}
+
+static void high_entry(void *p1, void *p2, void *p3)
+{
+	high_ret = k_mutex_lock(&chain_mutex2, K_MSEC(HIGH_WAIT_MS));
+}
+
+/**
+ * @brief Test priority inheritance along a chain of mutexes
+ *
+ * @details The test thread (low) holds mutex 1. A mid priority thread
+ * holds mutex 2 and waits for mutex 1, and a high priority thread then
+ * waits for mutex 2. The boost of the high priority thread must reach the
+ * low priority thread through the mid priority one, and be taken back
+ * from both when the high priority thread gives up waiting.
+ *
+ * @ingroup kernel_mutex_tests
+ *
+ * @see k_mutex_lock(), k_mutex_unlock()
+ */
+ZTEST(mutex_api_1cpu, test_mutex_priority_inheritance_chain)
+{
+	int chain_prio = (CONFIG_PRIORITY_INHERITANCE_DEPTH > 1) ?
+			 HIGH_PRIO : MID_PRIO;
+	k_tid_t self = k_current_get();
+	int prio = k_thread_priority_get(self);
+	struct k_mutex_stats stats;
+
+	k_mutex_init(&chain_mutex1);
+	k_mutex_init(&chain_mutex2);
+	k_thread_priority_set(self, LOW_PRIO);
+
+	zassert_ok(k_mutex_lock(&chain_mutex1, K_FOREVER));
+
+	/* The mid priority thread preempts us, takes mutex 2 and waits */
+	k_thread_create(&mid_thread, mid_stack, STACK_SIZE, mid_entry,
+			NULL, NULL, NULL, MID_PRIO, 0, K_NO_WAIT);
+	zassert_equal(k_thread_priority_get(self), MID_PRIO);
+
+	k_thread_create(&high_thread, high_stack, STACK_SIZE, high_entry,
+			NULL, NULL, NULL, HIGH_PRIO, 0, K_NO_WAIT);
+	zassert_equal(k_thread_priority_get(&mid_thread), HIGH_PRIO);
+	zassert_equal(k_thread_priority_get(self), chain_prio,
+		      "boost did not pass along the chain");
+
+	/* Once the high priority thread times out, both drop back */
+	k_thread_join(&high_thread, K_FOREVER);
+	zassert_equal(high_ret, -EAGAIN);
+	zassert_equal(k_thread_priority_get(&mid_thread), MID_PRIO);
+	zassert_equal(k_thread_priority_get(self), MID_PRIO);
+
+	zassert_ok(k_mutex_unlock(&chain_mutex1));
+	zassert_equal(k_thread_priority_get(self), LOW_PRIO);
+	k_thread_join(&mid_thread, K_FOREVER);
+
+	k_thread_priority_set(self, prio);
+
+	if (!IS_ENABLED(CONFIG_OBJ_CORE_STATS_MUTEX)) {
+		return;
+	}
+
+	chain_stats_get(&chain_mutex1, &stats);
+	zassert_equal(stats.locks, 2);
+	zassert_equal(stats.contended, 1);
+	zassert_equal(stats.timeouts, 0);
+	zassert_equal(stats.contended_owner, self);
+	zassert_true(stats.wait_max >= k_ms_to_cyc_floor32(HIGH_WAIT_MS),
+		     "wait of %u cycles too short", stats.wait_max);
+	zassert_true(stats.hold_total >= stats.hold_max);
+
+	chain_stats_get(&chain_mutex2, &stats);
+	zassert_equal(stats.locks, 1);
+	zassert_equal(stats.contended, 1);
+	zassert_equal(stats.timeouts, 1);
+	zassert_equal(stats.contended_owner, &mid_thread);
+	zassert_true(stats.wait_max >= k_ms_to_cyc_floor32(HIGH_WAIT_MS),
+		     "wait of %u cycles too short", stats.wait_max);
+	zassert_true(stats.hold_max >= stats.wait_max,
+		     "mutex held for %u cycles, shorter than the wait",
+		     stats.hold_max);
+
+#ifdef CONFIG_OBJ_CORE_STATS_MUTEX
+	zassert_ok(k_obj_core_stats_reset(K_OBJ_CORE(&chain_mutex2)));
+#endif
+	chain_stats_get(&chain_mutex2, &stats);
+	zassert_equal(stats.locks, 0);
+	zassert_equal(stats.contended_owner, NULL);
+}
+
+#define TOP_PRIO K_PRIO_PREEMPT(3)
+#define TIMED_WAIT_MS 20
+
+static int low_ret;
+static int mid_ret;
+
+static void timed_low_entry(void *p1, void *p2, void *p3)
+{
+	zassert_ok(k_mutex_lock(&chain_mutex1, K_FOREVER));
+	low_ret = k_mutex_lock(&chain_mutex2, K_MSEC(TIMED_WAIT_MS));
+	zassert_ok(k_mutex_unlock(&chain_mutex1));
+	zassert_equal(k_thread_priority_get(k_current_get()), LOW_PRIO);
+}
+
+static void timed_mid_entry(void *p1, void *p2, void *p3)
+{
+	mid_ret = k_mutex_lock(&chain_mutex1, K_FOREVER);
+	zassert_ok(k_mutex_unlock(&chain_mutex1));
+}
+
+/**
+ * @brief Test priority inheritance through a thread whose wait timed out
+ *
+ * @details A low priority thread holds mutex 1 and waits for mutex 2 with
+ * a timeout. The wait times out, but the low priority thread does not get
+ * to run before mutex 2 is released and a mid priority thread waits for
+ * mutex 1. The boost must stop at the low priority thread, which no longer
+ * waits for mutex 2, and mutex 2 no longer has an owner.
+ *
+ * @ingroup kernel_mutex_tests
+ *
+ * @see k_mutex_lock(), k_mutex_unlock()
+ */
+ZTEST(mutex_api_1cpu, test_mutex_priority_inheritance_timed_out_chain)
+{
+	k_tid_t self = k_current_get();
+	int prio = k_thread_priority_get(self);
+
+	k_mutex_init(&chain_mutex1);
+	k_mutex_init(&chain_mutex2);
+	k_thread_priority_set(self, TOP_PRIO);
+
+	zassert_ok(k_mutex_lock(&chain_mutex2, K_FOREVER));
+
+	/* The low priority thread takes mutex 1 and waits for mutex 2 */
+	k_thread_create(&mid_thread, mid_stack, STACK_SIZE, timed_low_entry,
+			NULL, NULL, NULL, LOW_PRIO, 0, K_NO_WAIT);
+	k_msleep(1);
+
+	/* Its wait times out while we keep the CPU */
+	k_busy_wait(2 * TIMED_WAIT_MS * USEC_PER_MSEC);
+	zassert_ok(k_mutex_unlock(&chain_mutex2));
+	zassert_is_null(chain_mutex2.owner);
+
+	/* The mid priority thread runs first and boosts the owner of mutex 1 */
+	k_thread_create(&high_thread, high_stack, STACK_SIZE, timed_mid_entry,
+			NULL, NULL, NULL, MID_PRIO, 0, K_NO_WAIT);
+
+	k_thread_join(&high_thread, K_FOREVER);
+	k_thread_join(&mid_thread, K_FOREVER);
+
+	zassert_equal(low_ret, -EAGAIN);
+	zassert_equal(mid_ret, 0);
+
+	k_thread_priority_set(self, prio);
+}
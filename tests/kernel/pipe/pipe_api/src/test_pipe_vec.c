@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define VEC_PIPE_LEN	32
+
+static const unsigned char vec_data[] = "0123456789abcdefghijklmnopqrstuv";
+BUILD_ASSERT(sizeof(vec_data) > VEC_PIPE_LEN);
+
+K_PIPE_DEFINE(vec_pipe, VEC_PIPE_LEN, 4);
+static struct k_pipe vec_direct_pipe;
+
+static K_THREAD_STACK_DEFINE(vec_stack, STACK_SIZE);
+static struct k_thread vec_thread;
+
+static unsigned char rx[VEC_PIPE_LEN];
+static size_t rx_bytes;
+static int rx_rc;
+
+static void vec_stats_get(struct k_pipe *pipe, struct k_pipe_stats *stats)
+{
+#ifdef CONFIG_OBJ_CORE_STATS_PIPE
+	zassert_ok(k_obj_core_stats_raw(K_OBJ_CORE(pipe), stats,
+					sizeof(*stats)));
+#else
+	ARG_UNUSED(pipe);
+	*stats = (struct k_pipe_stats){};
+#endif
+}
+
+/**
+ * @brief Test vectored writes and reads through the pipe buffer
+ *
+ * @details Write data in segments of odd sizes (including empty ones) and
+ * read it back with a different segmentation.
+ *
+ * @ingroup kernel_pipe_tests
+ *
+ * @see k_pipe_putv(), k_pipe_getv()
+ */
+ZTEST(pipe_api, test_pipe_putv_getv_buffered)
+{
+	const struct k_pipe_iovec tx_iov[] = {
+		{ (void *)&vec_data[0], 3 },
+		{ NULL, 0 },
+		{ (void *)&vec_data[3], 13 },
+		{ (void *)&vec_data[16], 16 },
+	};
+	unsigned char out[VEC_PIPE_LEN];
+	const struct k_pipe_iovec rx_iov[] = {
+		{ &out[0], 10 },
+		{ &out[10], 0 },
+		{ &out[10], 22 },
+	};
+	const struct k_pipe_iovec wrap_iov[] = {
+		{ &out[0], 16 },
+		{ &out[0], SIZE_MAX - 8 },
+	};
+	struct k_pipe_stats stats;
+	size_t bytes;
+
+	k_pipe_flush(&vec_pipe);
+	vec_stats_get(&vec_pipe, &stats);
+	size_t buffered = stats.buffered_bytes;
+
+	/* Nothing to transfer */
+	zassert_ok(k_pipe_putv(&vec_pipe, tx_iov, 0, &bytes, 0, K_NO_WAIT));
+	zassert_equal(bytes, 0);
+	zassert_ok(k_pipe_putv(&vec_pipe, &tx_iov[1], 1, &bytes, 0, K_NO_WAIT));
+	zassert_equal(bytes, 0);
+
+	/* Segment lengths adding up past SIZE_MAX */
+	zassert_equal(k_pipe_putv(&vec_pipe, wrap_iov, ARRAY_SIZE(wrap_iov),
+				  &bytes, 1, K_NO_WAIT), -EINVAL);
+	zassert_equal(k_pipe_getv(&vec_pipe, wrap_iov, ARRAY_SIZE(wrap_iov),
+				  &bytes, 1, K_NO_WAIT), -EINVAL);
+	zassert_equal(k_pipe_read_avail(&vec_pipe), 0);
+
+	zassert_ok(k_pipe_putv(&vec_pipe, tx_iov, ARRAY_SIZE(tx_iov), &bytes,
+			       VEC_PIPE_LEN, K_NO_WAIT));
+	zassert_equal(bytes, VEC_PIPE_LEN);
+	zassert_equal(k_pipe_read_avail(&vec_pipe), VEC_PIPE_LEN);
+
+	/* Pipe is full: nothing more fits */
+	zassert_equal(k_pipe_putv(&vec_pipe, tx_iov, ARRAY_SIZE(tx_iov), &bytes,
+				  1, K_NO_WAIT), -EIO);
+
+	memset(out, 0, sizeof(out));
+	zassert_ok(k_pipe_getv(&vec_pipe, rx_iov, ARRAY_SIZE(rx_iov), &bytes,
+			       VEC_PIPE_LEN, K_NO_WAIT));
+	zassert_equal(bytes, VEC_PIPE_LEN);
+	zassert_mem_equal(out, vec_data, VEC_PIPE_LEN);
+
+	/* Partial transfers stop part-way into a segment */
+	zassert_ok(k_pipe_putv(&vec_pipe, tx_iov, ARRAY_SIZE(tx_iov), &bytes,
+			       1, K_NO_WAIT));
+	zassert_ok(k_pipe_putv(&vec_pipe, tx_iov, ARRAY_SIZE(tx_iov), &bytes,
+			       0, K_NO_WAIT));
+	zassert_equal(bytes, 0);
+	memset(out, 0, sizeof(out));
+	zassert_ok(k_pipe_getv(&vec_pipe, &rx_iov[0], 1, &bytes, 10,
+			       K_NO_WAIT));
+	zassert_ok(k_pipe_putv(&vec_pipe, tx_iov, ARRAY_SIZE(tx_iov), &bytes,
+			       10, K_NO_WAIT));
+	zassert_equal(bytes, 10);
+	zassert_ok(k_pipe_getv(&vec_pipe, &rx_iov[2], 1, &bytes, 22,
+			       K_NO_WAIT));
+	zassert_mem_equal(&out[10], vec_data + 10, 22);
+	zassert_ok(k_pipe_getv(&vec_pipe, rx_iov, ARRAY_SIZE(rx_iov), &bytes,
+			       10, K_NO_WAIT));
+	zassert_equal(bytes, 10);
+	zassert_mem_equal(out, vec_data, 10);
+
+	vec_stats_get(&vec_pipe, &stats);
+	if (IS_ENABLED(CONFIG_OBJ_CORE_STATS_PIPE)) {
+		zassert_equal(stats.buffered_bytes - buffered,
+			      2 * VEC_PIPE_LEN + 10);
+	}
+}
+
+static void vec_reader(void *p1, void *p2, void *p3)
+{
+	const struct k_pipe_iovec rx_iov[] = {
+		{ &rx[0], 7 },
+		{ &rx[7], 0 },
+		{ &rx[7], 1 },
+		{ &rx[8], VEC_PIPE_LEN - 8 },
+	};
+
+	rx_rc = k_pipe_getv(&vec_direct_pipe, rx_iov, ARRAY_SIZE(rx_iov),
+			    &rx_bytes, VEC_PIPE_LEN, K_FOREVER);
+}
+
+/**
+ * @brief Test vectored transfers from a writer straight to a waiting reader
+ *
+ * @details A reader blocks on an unbuffered pipe with a segmented request;
+ * a differently segmented write must then be copied directly into the
+ * reader's segments without going through a pipe buffer.
+ *
+ * @ingroup kernel_pipe_tests
+ *
+ * @see k_pipe_putv(), k_pipe_getv()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_putv_getv_direct)
+{
+	const struct k_pipe_iovec tx_iov[] = {
+		{ (void *)&vec_data[0], 5 },
+		{ (void *)&vec_data[5], 20 },
+		{ NULL, 0 },
+		{ (void *)&vec_data[25], VEC_PIPE_LEN - 25 },
+	};
+	struct k_pipe_stats stats;
+	size_t bytes;
+
+	k_pipe_init(&vec_direct_pipe, NULL, 0);
+	memset(rx, 0, sizeof(rx));
+
+	/* No reader and no buffer: nothing can be written */
+	zassert_equal(k_pipe_putv(&vec_direct_pipe, tx_iov, ARRAY_SIZE(tx_iov),
+				  &bytes, 1, K_NO_WAIT), -EIO);
+
+	k_thread_create(&vec_thread, vec_stack, STACK_SIZE, vec_reader,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+
+	zassert_ok(k_pipe_putv(&vec_direct_pipe, tx_iov, ARRAY_SIZE(tx_iov),
+			       &bytes, VEC_PIPE_LEN, K_NO_WAIT));
+	zassert_equal(bytes, VEC_PIPE_LEN);
+	k_thread_join(&vec_thread, K_FOREVER);
+
+	zassert_ok(rx_rc);
+	zassert_equal(rx_bytes, VEC_PIPE_LEN);
+	zassert_mem_equal(rx, vec_data, VEC_PIPE_LEN);
+
+	vec_stats_get(&vec_direct_pipe, &stats);
+	if (IS_ENABLED(CONFIG_OBJ_CORE_STATS_PIPE)) {
+		zassert_equal(stats.direct_bytes, VEC_PIPE_LEN);
+		zassert_equal(stats.buffered_bytes, 0);
+	}
+}
+
+static void vec_writer(void *p1, void *p2, void *p3)
+{
+	const struct k_pipe_iovec tx_iov[] = {
+		{ (void *)&vec_data[0], 1 },
+		{ (void *)&vec_data[1], 30 },
+		{ (void *)&vec_data[31], 1 },
+	};
+
+	rx_rc = k_pipe_putv(&vec_direct_pipe, tx_iov, ARRAY_SIZE(tx_iov),
+			    &rx_bytes, VEC_PIPE_LEN, K_FOREVER);
+}
+
+/**
+ * @brief Test vectored transfers from a waiting writer to a reader
+ *
+ * @ingroup kernel_pipe_tests
+ *
+ * @see k_pipe_putv(), k_pipe_getv()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_getv_from_writer)
+{
+	const struct k_pipe_iovec rx_iov[] = {
+		{ &rx[0], 16 },
+		{ &rx[16], 16 },
+	};
+	size_t bytes;
+
+	k_pipe_init(&vec_direct_pipe, NULL, 0);
+	memset(rx, 0, sizeof(rx));
+
+	k_thread_create(&vec_thread, vec_stack, STACK_SIZE, vec_writer,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(10));
+
+	zassert_ok(k_pipe_getv(&vec_direct_pipe, rx_iov, ARRAY_SIZE(rx_iov),
+			       &bytes, VEC_PIPE_LEN, K_NO_WAIT));
+	zassert_equal(bytes, VEC_PIPE_LEN);
+	k_thread_join(&vec_thread, K_FOREVER);
+
+	zassert_ok(rx_rc);
+	zassert_equal(rx_bytes, VEC_PIPE_LEN);
+	zassert_mem_equal(rx, vec_data, VEC_PIPE_LEN);
+}
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+
+#include <zephyr/bench_clock.h>
+
+#define SET_SEMS 64
+#define SET_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_POLL_SET_DEFINE(static_set);
+static struct k_poll_set other_set;
+
+static struct k_sem set_sems[SET_SEMS];
+static struct k_poll_event set_events[SET_SEMS];
+static struct k_fifo set_fifo;
+static struct k_poll_event fifo_event;
+
+static struct k_thread set_thread;
+static K_THREAD_STACK_DEFINE(set_stack, SET_STACK_SIZE);
+
+static struct k_poll_event *waiter_ready[4];
+static int waiter_rc;
+
+static void set_events_init(int num)
+{
+	for (int i = 0; i < num; i++) {
+		k_sem_init(&set_sems[i], 0, 1);
+		k_poll_event_init(&set_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &set_sems[i]);
+		set_events[i].tag = i;
+	}
+}
+
+static void set_events_remove(struct k_poll_set *set, int num)
+{
+	for (int i = 0; i < num; i++) {
+		zassert_ok(k_poll_set_remove(set, &set_events[i]));
+	}
+}
+
+/**
+ * @brief Test adding, removing and waiting for events of a poll set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll_set_remove(), k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_api)
+{
+	struct k_poll_event *ready[2];
+	struct k_poll_event ignore;
+
+	set_events_init(4);
+	k_poll_set_init(&other_set);
+
+	for (int i = 0; i < 4; i++) {
+		zassert_ok(k_poll_set_add(&static_set, &set_events[i]));
+	}
+	zassert_equal(k_poll_set_add(&static_set, &set_events[0]), -EBUSY);
+	zassert_equal(k_poll_set_add(&other_set, &set_events[0]), -EBUSY);
+	zassert_equal(k_poll_set_remove(&other_set, &set_events[0]), -EINVAL);
+	k_poll_event_init(&ignore, K_POLL_TYPE_IGNORE, K_POLL_MODE_NOTIFY_ONLY,
+			  &set_sems[0]);
+	zassert_equal(k_poll_set_add(&static_set, &ignore), -EINVAL);
+	zassert_equal(k_poll_set_wait(&static_set, ready, 0, K_NO_WAIT),
+		      -EINVAL);
+
+	zassert_equal(k_poll_set_wait(&static_set, ready, 2, K_NO_WAIT),
+		      -EAGAIN);
+
+	/* Ready events are reported for as long as they stay ready */
+	k_sem_give(&set_sems[2]);
+	for (int i = 0; i < 2; i++) {
+		zassert_equal(k_poll_set_wait(&static_set, ready, 2, K_NO_WAIT),
+			      1);
+		zassert_equal(ready[0], &set_events[2]);
+		zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE);
+	}
+	zassert_ok(k_sem_take(&set_sems[2], K_NO_WAIT));
+	zassert_equal(k_poll_set_wait(&static_set, ready, 2, K_NO_WAIT),
+		      -EAGAIN);
+
+	/* The events that do not fit are returned by the next wait */
+	k_sem_give(&set_sems[0]);
+	k_sem_give(&set_sems[1]);
+	k_sem_give(&set_sems[3]);
+	zassert_equal(k_poll_set_wait(&static_set, ready, 2, K_NO_WAIT), 2);
+	zassert_equal(ready[0]->tag, 0);
+	zassert_equal(ready[1]->tag, 1);
+	zassert_ok(k_sem_take(&set_sems[0], K_NO_WAIT));
+	zassert_ok(k_sem_take(&set_sems[1], K_NO_WAIT));
+	zassert_equal(k_poll_set_wait(&static_set, ready, 2, K_NO_WAIT), 1);
+	zassert_equal(ready[0]->tag, 3);
+
+	/* An event whose object is already available is ready right away,
+	 * also in another set
+	 */
+	zassert_ok(k_poll_set_remove(&static_set, &set_events[3]));
+	zassert_equal(k_poll_set_wait(&static_set, ready, 2, K_NO_WAIT),
+		      -EAGAIN);
+	zassert_ok(k_poll_set_add(&other_set, &set_events[3]));
+	zassert_equal(k_poll_set_wait(&other_set, ready, 2, K_NO_WAIT), 1);
+	zassert_equal(ready[0], &set_events[3]);
+	zassert_ok(k_sem_take(&set_sems[3], K_NO_WAIT));
+	zassert_ok(k_poll_set_remove(&other_set, &set_events[3]));
+
+	/* Removed events are not signaled anymore */
+	zassert_ok(k_poll_set_remove(&static_set, &set_events[0]));
+	k_sem_give(&set_sems[0]);
+	zassert_equal(k_poll_set_wait(&static_set, ready, 2, K_NO_WAIT),
+		      -EAGAIN);
+	zassert_equal(k_poll_set_remove(&static_set, &set_events[0]), -EINVAL);
+
+	zassert_ok(k_poll_set_remove(&static_set, &set_events[1]));
+	zassert_ok(k_poll_set_remove(&static_set, &set_events[2]));
+}
+
+static void set_waiter(void *p1, void *p2, void *p3)
+{
+	struct k_poll_set *set = p1;
+
+	waiter_rc = k_poll_set_wait(set, waiter_ready,
+				    ARRAY_SIZE(waiter_ready), K_FOREVER);
+}
+
+/**
+ * @brief Test waking up a thread waiting on a large poll set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_wait)
+{
+	struct k_poll_set set;
+	struct k_poll_event *ready[1];
+
+	k_poll_set_init(&set);
+	set_events_init(SET_SEMS);
+	for (int i = 0; i < SET_SEMS; i++) {
+		zassert_ok(k_poll_set_add(&set, &set_events[i]));
+	}
+
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_MSEC(10)), -EAGAIN);
+
+	for (int round = 0; round < 2; round++) {
+		int idx = (round == 0) ? (SET_SEMS - 1) : (SET_SEMS / 2);
+
+		waiter_rc = 0;
+		k_thread_create(&set_thread, set_stack, SET_STACK_SIZE,
+				set_waiter, &set, NULL, NULL,
+				K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+		k_sleep(K_MSEC(10));
+		zassert_equal(waiter_rc, 0, "waiter returned early");
+
+		k_sem_give(&set_sems[idx]);
+		k_thread_join(&set_thread, K_FOREVER);
+
+		zassert_equal(waiter_rc, 1);
+		zassert_equal(waiter_ready[0], &set_events[idx]);
+		zassert_ok(k_sem_take(&set_sems[idx], K_NO_WAIT));
+	}
+
+	set_events_remove(&set, SET_SEMS);
+}
+
+/**
+ * @brief Test cancelling a FIFO wait on a poll set
+ *
+ * @details The cancellation is reported once, after which the event waits
+ * for data again.
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait(), k_fifo_cancel_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_cancel)
+{
+	struct k_poll_set set;
+	struct k_poll_event *ready[1];
+	static struct {
+		void *fifo_reserved;
+	} item;
+
+	k_poll_set_init(&set);
+	k_fifo_init(&set_fifo);
+	k_poll_event_init(&fifo_event, K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_fifo);
+	zassert_ok(k_poll_set_add(&set, &fifo_event));
+
+	k_fifo_cancel_wait(&set_fifo);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1);
+	zassert_equal(ready[0]->state, K_POLL_STATE_CANCELLED);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), -EAGAIN);
+
+	k_fifo_put(&set_fifo, &item);
+	zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1);
+	zassert_equal(ready[0]->state, K_POLL_STATE_FIFO_DATA_AVAILABLE);
+	zassert_equal(k_fifo_get(&set_fifo, K_NO_WAIT), &item);
+
+	zassert_ok(k_poll_set_remove(&set, &fifo_event));
+}
+
+#define BENCH_WAITS 1000
+
+/**
+ * @brief Compare the cost of waiting with k_poll() and with a poll set
+ *
+ * @details For growing numbers of semaphores, one of which is available,
+ * measure k_poll() over all of them against k_poll_set_wait() on a set
+ * holding all of them. The poll set cost should not depend on the number
+ * of events.
+ *
+ * @ingroup kernel_poll_tests
+ */
+ZTEST(poll_api_1cpu, test_poll_set_throughput)
+{
+	struct k_poll_set set;
+	struct k_poll_event *ready[1];
+	uint64_t poll_cycles, set_cycles;
+	timing_t start, end;
+
+	timing_init();
+	timing_start();
+
+	for (int num = 4; num <= SET_SEMS; num <<= 2) {
+		struct k_sem *sem = &set_sems[num - 1];
+
+		set_events_init(num);
+
+		start = bench_stamp();
+		for (int i = 0; i < BENCH_WAITS; i++) {
+			k_sem_give(sem);
+			zassert_ok(k_poll(set_events, num, K_NO_WAIT));
+			set_events[num - 1].state = K_POLL_STATE_NOT_READY;
+			k_sem_take(sem, K_NO_WAIT);
+		}
+		end = bench_stamp();
+		poll_cycles = bench_cycles(&start, &end);
+
+		k_poll_set_init(&set);
+		for (int i = 0; i < num; i++) {
+			zassert_ok(k_poll_set_add(&set, &set_events[i]));
+		}
+
+		start = bench_stamp();
+		for (int i = 0; i < BENCH_WAITS; i++) {
+			k_sem_give(sem);
+			zassert_equal(k_poll_set_wait(&set, ready, 1, K_NO_WAIT), 1);
+			k_sem_take(sem, K_NO_WAIT);
+		}
+		end = bench_stamp();
+		set_cycles = bench_cycles(&start, &end);
+
+		set_events_remove(&set, num);
+
+		PRINT("%2d events: k_poll %u cycles/wait, "
+		      "k_poll_set_wait %u cycles/wait\n", num,
+		      (uint32_t)(poll_cycles / BENCH_WAITS),
+		      (uint32_t)(set_cycles / BENCH_WAITS));
+	}
+
+	timing_stop();
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define CBS_THREADS 3
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define CBS_PRIO K_LOWEST_APPLICATION_THREAD_PRIO
+
+/* Work is done in units of busy waiting */
+#define WORK_US 100
+#define PERIOD_MS 50
+#define PERIODS 10
+
+static struct k_thread cbs_threads[CBS_THREADS];
+static K_THREAD_STACK_ARRAY_DEFINE(cbs_stacks, CBS_THREADS, STACK_SIZE);
+
+static volatile uint32_t work_done[CBS_THREADS];
+static volatile uint32_t jobs_done;
+static volatile uint32_t jobs_late;
+
+static void idle_entry(void *p1, void *p2, void *p3)
+{
+}
+
+static k_tid_t cbs_thread_create(int idx, k_thread_entry_t entry,
+				 k_timeout_t delay)
+{
+	return k_thread_create(&cbs_threads[idx], cbs_stacks[idx], STACK_SIZE,
+			       entry, INT_TO_POINTER(idx), NULL, NULL,
+			       CBS_PRIO, 0, delay);
+}
+
+/**
+ * @brief Test the admission test of budget reservations
+ *
+ * @ingroup kernel_sched_tests
+ *
+ * @see k_thread_cbs_set()
+ */
+ZTEST(suite_deadline_cbs, test_cbs_admission)
+{
+	k_tid_t tid[CBS_THREADS];
+
+	for (int i = 0; i < CBS_THREADS; i++) {
+		tid[i] = cbs_thread_create(i, idle_entry, K_FOREVER);
+	}
+
+	zassert_equal(k_thread_cbs_set(tid[0], 10, 0), -EINVAL);
+	zassert_equal(k_thread_cbs_set(tid[0], 0, 10), -EINVAL);
+	zassert_equal(k_thread_cbs_set(tid[0], 20, 10), -EINVAL);
+
+	zassert_ok(k_thread_cbs_set(tid[0], 50000, 100000));
+	zassert_ok(k_thread_cbs_set(tid[1], 40000, 100000));
+	zassert_equal(k_thread_cbs_set(tid[2], 20000, 100000), -EBUSY);
+	zassert_ok(k_thread_cbs_set(tid[2], 5000, 100000));
+
+	/* Changing a reservation only accounts for the difference */
+	zassert_ok(k_thread_cbs_set(tid[1], 44000, 100000));
+	zassert_equal(k_thread_cbs_set(tid[2], 10000, 100000), -EBUSY);
+
+	/* Bandwidth is given back by dropping a reservation... */
+	zassert_ok(k_thread_cbs_set(tid[0], 0, 0));
+	zassert_ok(k_thread_cbs_set(tid[2], 50000, 100000));
+	zassert_equal(k_thread_cbs_set(tid[0], 10000, 100000), -EBUSY);
+
+	/* ...and by aborting the thread */
+	k_thread_abort(tid[1]);
+	zassert_ok(k_thread_cbs_set(tid[0], 40000, 100000));
+
+	k_thread_abort(tid[0]);
+	k_thread_abort(tid[2]);
+}
+
+static void hog_entry(void *p1, void *p2, void *p3)
+{
+	int idx = POINTER_TO_INT(p1);
+
+	while (true) {
+		k_busy_wait(WORK_US);
+		work_done[idx]++;
+	}
+}
+
+static void periodic_entry(void *p1, void *p2, void *p3)
+{
+	int idx = POINTER_TO_INT(p1);
+	int64_t release = k_uptime_get();
+	uint32_t work = (PERIOD_MS * USEC_PER_MSEC / 5U) / WORK_US;
+
+	while (true) {
+		for (uint32_t i = 0; i < work; i++) {
+			k_busy_wait(WORK_US);
+			work_done[idx]++;
+		}
+
+		if (k_uptime_get() > release + PERIOD_MS) {
+			jobs_late++;
+		}
+		jobs_done++;
+
+		release += PERIOD_MS;
+		k_sleep(K_TIMEOUT_ABS_MS(release));
+	}
+}
+
+static void zassert_work(int idx, uint32_t budget_us)
+{
+	uint32_t expected = PERIODS * budget_us / WORK_US;
+
+	/* Allow for the tick resolution of budgets and the partial
+	 * periods at start and end
+	 */
+	zassert_within(work_done[idx], expected, expected / 4U,
+		       "thread %d did %u units of work, expected %u", idx,
+		       work_done[idx], expected);
+}
+
+/**
+ * @brief Test that budgets isolate threads from overrunning ones
+ *
+ * @details Two threads at the same priority try to use all of the CPU,
+ * next to a periodic thread that needs a fifth of it.  Each of them has
+ * a budget reservation.  The overrunning threads must be throttled to
+ * their budgets, and the periodic thread must finish every job within
+ * its period.
+ *
+ * @ingroup kernel_sched_tests
+ *
+ * @see k_thread_cbs_set()
+ */
+ZTEST(suite_deadline_cbs, test_cbs_isolation)
+{
+	const uint32_t period_us = PERIOD_MS * USEC_PER_MSEC;
+	k_tid_t tid[CBS_THREADS];
+
+	memset((void *)work_done, 0, sizeof(work_done));
+	jobs_done = 0;
+	jobs_late = 0;
+
+	tid[0] = cbs_thread_create(0, hog_entry, K_FOREVER);
+	tid[1] = cbs_thread_create(1, hog_entry, K_FOREVER);
+	tid[2] = cbs_thread_create(2, periodic_entry, K_FOREVER);
+
+	zassert_ok(k_thread_cbs_set(tid[0], period_us / 5U, period_us));
+	zassert_ok(k_thread_cbs_set(tid[1], 2U * period_us / 5U, period_us));
+	zassert_ok(k_thread_cbs_set(tid[2], 2U * period_us / 5U, period_us));
+
+	for (int i = 0; i < CBS_THREADS; i++) {
+		k_thread_start(tid[i]);
+	}
+
+	k_sleep(K_MSEC(PERIODS * PERIOD_MS));
+
+	for (int i = 0; i < CBS_THREADS; i++) {
+		k_thread_abort(tid[i]);
+	}
+
+	TC_PRINT("work: %u %u %u, jobs %u, late %u\n", work_done[0],
+		 work_done[1], work_done[2], jobs_done, jobs_late);
+
+	zassert_work(0, period_us / 5U);
+	zassert_work(1, 2U * period_us / 5U);
+	zassert_work(2, period_us / 5U);
+	zassert_true(jobs_done >= PERIODS - 1U, "only %u jobs done", jobs_done);
+	zassert_equal(jobs_late, 0, "%u jobs missed their deadline", jobs_late);
+}
+
+ZTEST_SUITE(suite_deadline_cbs, NULL, NULL, NULL, NULL, NULL);
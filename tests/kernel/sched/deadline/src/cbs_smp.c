@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define CBS_PRIO K_LOWEST_APPLICATION_THREAD_PRIO
+#define CBS_CPU 1
+
+#define WORK_US 100
+#define PERIOD_MS 50
+#define PERIODS 10
+
+static struct k_thread hog_thread;
+static K_THREAD_STACK_DEFINE(hog_stack, STACK_SIZE);
+
+static volatile uint32_t work_done;
+static volatile uint32_t work_throttled;
+static volatile bool hog_cpu_ok = true;
+
+static void hog_entry(void *p1, void *p2, void *p3)
+{
+	while (true) {
+		k_busy_wait(WORK_US);
+		work_done++;
+
+		if (hog_thread.base.cpu != CBS_CPU) {
+			hog_cpu_ok = false;
+		}
+		if (hog_thread.base.cbs.throttled) {
+			work_throttled++;
+		}
+	}
+}
+
+/**
+ * @brief Test throttling a thread that runs on another CPU
+ *
+ * @details A thread with a budget reservation is pinned to one CPU and
+ * tries to use all of it.  Its budget runs out while it is running
+ * there, and the expiry is handled on whichever CPU processes the
+ * timeouts.  It must stop running until its budget is replenished,
+ * get its budget back every period, and must never run elsewhere.
+ *
+ * @ingroup kernel_sched_tests
+ *
+ * @see k_thread_cbs_set()
+ */
+ZTEST(suite_deadline_cbs_smp, test_cbs_throttle_other_cpu)
+{
+	const uint32_t period_us = PERIOD_MS * USEC_PER_MSEC;
+	const uint32_t budget_us = period_us / 5U;
+	uint32_t expected = PERIODS * budget_us / WORK_US;
+	k_tid_t tid;
+
+	tid = k_thread_create(&hog_thread, hog_stack, STACK_SIZE, hog_entry,
+			      NULL, NULL, NULL, CBS_PRIO, 0, K_FOREVER);
+
+	zassert_ok(k_thread_cpu_pin(tid, CBS_CPU));
+	zassert_ok(k_thread_cbs_set(tid, budget_us, period_us));
+
+	k_thread_start(tid);
+	k_sleep(K_MSEC(PERIODS * PERIOD_MS));
+	k_thread_abort(tid);
+
+	TC_PRINT("work: %u, while throttled %u\n", work_done, work_throttled);
+
+	zassert_true(hog_cpu_ok, "throttled thread ran on another CPU");
+	/* Once per period the unit of work in progress while the IPI is
+	 * on its way may finish
+	 */
+	zassert_true(work_throttled <= PERIODS,
+		     "%u units of work while throttled", work_throttled);
+	zassert_within(work_done, expected, expected / 4U,
+		       "did %u units of work, expected %u", work_done,
+		       expected);
+}
+
+ZTEST_SUITE(suite_deadline_cbs_smp, NULL, NULL, NULL, NULL, NULL);
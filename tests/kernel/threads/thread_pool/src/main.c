@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#define POOL_SIZE       2
+#define POOL_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define CHURN_THREADS   100
+#define DEEP_BYTES      512
+
+K_THREAD_POOL_DEFINE(test_pool, POOL_SIZE, POOL_STACK_SIZE, 0);
+
+static K_SEM_DEFINE(block_sem, 0, POOL_SIZE);
+static K_SEM_DEFINE(done_sem, 0, CHURN_THREADS + POOL_SIZE);
+static atomic_t runs;
+static void *run_args[3];
+static int run_prio;
+
+static void record_entry(void *p1, void *p2, void *p3)
+{
+	run_args[0] = p1;
+	run_args[1] = p2;
+	run_args[2] = p3;
+	run_prio = k_thread_priority_get(k_current_get());
+	atomic_inc(&runs);
+	k_sem_give(&done_sem);
+}
+
+static void block_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_sem_take(&block_sem, K_FOREVER);
+	atomic_inc(&runs);
+	k_sem_give(&done_sem);
+}
+
+/* Threads of the POSIX architecture run on host stacks, which are not
+ * painted
+ */
+#if defined(CONFIG_INIT_STACKS) && !defined(CONFIG_ARCH_POSIX)
+#define TEST_STACK_PAINT 1
+#endif
+
+#ifdef TEST_STACK_PAINT
+static size_t deep_unused;
+
+static void deep_entry(void *p1, void *p2, void *p3)
+{
+	volatile uint8_t buf[DEEP_BYTES];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < DEEP_BYTES; i++) {
+		buf[i] = (uint8_t)i;
+	}
+
+	(void)k_thread_stack_space_get(k_current_get(), &deep_unused);
+	k_sem_give(&done_sem);
+}
+#endif
+
+static void wait_done(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&done_sem, K_MSEC(1000)));
+	}
+
+	/* Let the threads go back to the pool */
+	k_sleep(K_MSEC(1));
+}
+
+static void *thread_pool_setup(void)
+{
+	return NULL;
+}
+
+static void thread_pool_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	atomic_clear(&runs);
+	memset(run_args, 0, sizeof(run_args));
+	k_sem_reset(&done_sem);
+}
+
+/**
+ * @brief Test running entry points on threads of a pool
+ *
+ * @details The entry point runs with its arguments and priority, and the
+ * next entry point runs on the same thread.
+ *
+ * @ingroup kernel_thread_tests
+ *
+ * @see k_thread_pool_spawn()
+ */
+ZTEST(thread_pool, test_thread_pool_spawn)
+{
+	k_tid_t tid, again;
+
+	tid = k_thread_pool_spawn(&test_pool, record_entry, &runs, run_args,
+				  &test_pool, K_PRIO_PREEMPT(2), K_NO_WAIT);
+	zassert_not_null(tid);
+	wait_done(1);
+
+	zassert_equal(atomic_get(&runs), 1);
+	zassert_equal(run_args[0], &runs);
+	zassert_equal(run_args[1], run_args);
+	zassert_equal(run_args[2], &test_pool);
+	zassert_equal(run_prio, K_PRIO_PREEMPT(2));
+
+	again = k_thread_pool_spawn(&test_pool, record_entry, NULL, NULL, NULL,
+				    K_PRIO_PREEMPT(3), K_NO_WAIT);
+	zassert_equal(again, tid, "thread was not recycled");
+	wait_done(1);
+	zassert_equal(atomic_get(&runs), 2);
+	zassert_is_null(run_args[0]);
+	zassert_equal(run_prio, K_PRIO_PREEMPT(3));
+}
+
+/**
+ * @brief Test waiting for a thread of an exhausted pool
+ *
+ * @ingroup kernel_thread_tests
+ *
+ * @see k_thread_pool_spawn()
+ */
+ZTEST(thread_pool, test_thread_pool_exhausted)
+{
+	for (int i = 0; i < POOL_SIZE; i++) {
+		zassert_not_null(k_thread_pool_spawn(&test_pool, block_entry,
+						     NULL, NULL, NULL,
+						     K_PRIO_PREEMPT(0),
+						     K_NO_WAIT));
+	}
+
+	zassert_is_null(k_thread_pool_spawn(&test_pool, record_entry, NULL,
+					    NULL, NULL, K_PRIO_PREEMPT(0),
+					    K_NO_WAIT));
+	zassert_is_null(k_thread_pool_spawn(&test_pool, record_entry, NULL,
+					    NULL, NULL, K_PRIO_PREEMPT(0),
+					    K_MSEC(20)));
+
+	/* Releasing one blocked thread makes room for the next spawn */
+	k_sem_give(&block_sem);
+	zassert_not_null(k_thread_pool_spawn(&test_pool, record_entry, NULL,
+					     NULL, NULL, K_PRIO_PREEMPT(0),
+					     K_FOREVER));
+
+	k_sem_give(&block_sem);
+	wait_done(POOL_SIZE + 1);
+	zassert_equal(atomic_get(&runs), POOL_SIZE + 1);
+}
+
+/**
+ * @brief Test spawning many more entry points than the pool has threads
+ *
+ * @details Entry points are spawned back to back, so each spawn has to
+ * wait for and recycle a thread that just finished.
+ *
+ * @ingroup kernel_thread_tests
+ *
+ * @see k_thread_pool_spawn()
+ */
+ZTEST(thread_pool, test_thread_pool_churn)
+{
+	for (int i = 0; i < CHURN_THREADS; i++) {
+		zassert_not_null(k_thread_pool_spawn(&test_pool, record_entry,
+						     NULL, NULL, NULL,
+						     K_PRIO_PREEMPT(1),
+						     K_FOREVER));
+	}
+
+	/* Occupying the whole pool waits for all earlier entry points */
+	for (int i = 0; i < POOL_SIZE; i++) {
+		zassert_not_null(k_thread_pool_spawn(&test_pool, block_entry,
+						     NULL, NULL, NULL,
+						     K_PRIO_PREEMPT(1),
+						     K_FOREVER));
+	}
+	zassert_equal(atomic_get(&runs), CHURN_THREADS);
+
+	for (int i = 0; i < POOL_SIZE; i++) {
+		k_sem_give(&block_sem);
+	}
+	wait_done(CHURN_THREADS + POOL_SIZE);
+}
+
+/**
+ * @brief Test that aborting a pool thread releases its slot
+ *
+ * @details The slot of an aborted thread can be spawned on again, with a
+ * new thread, so the whole pool stays available.
+ *
+ * @ingroup kernel_thread_tests
+ *
+ * @see k_thread_pool_spawn()
+ */
+ZTEST(thread_pool, test_thread_pool_abort)
+{
+	k_tid_t tid;
+
+	tid = k_thread_pool_spawn(&test_pool, block_entry, NULL, NULL, NULL,
+				  K_PRIO_PREEMPT(0), K_NO_WAIT);
+	zassert_not_null(tid);
+	k_sleep(K_MSEC(1));
+
+	k_thread_abort(tid);
+
+	for (int i = 0; i < POOL_SIZE; i++) {
+		zassert_not_null(k_thread_pool_spawn(&test_pool, block_entry,
+						     NULL, NULL, NULL,
+						     K_PRIO_PREEMPT(0),
+						     K_NO_WAIT),
+				 "slot of aborted thread not released");
+	}
+
+	for (int i = 0; i < POOL_SIZE; i++) {
+		k_sem_give(&block_sem);
+	}
+	wait_done(POOL_SIZE);
+	zassert_equal(atomic_get(&runs), POOL_SIZE);
+
+	/* An idle thread that is aborted is created again */
+	k_thread_abort(tid);
+	zassert_equal(k_thread_pool_spawn(&test_pool, record_entry, NULL, NULL,
+					  NULL, K_PRIO_PREEMPT(0), K_NO_WAIT),
+		      tid);
+	wait_done(1);
+	zassert_equal(atomic_get(&runs), POOL_SIZE + 1);
+}
+
+/**
+ * @brief Test that recycled stacks are painted again
+ *
+ * @details With CONFIG_INIT_STACKS, an entry point run on the stack of
+ * one that used a lot of it reports its own, lower, stack usage.
+ *
+ * @ingroup kernel_thread_tests
+ *
+ * @see k_thread_pool_spawn()
+ */
+ZTEST(thread_pool, test_thread_pool_stack_paint)
+{
+#ifdef TEST_STACK_PAINT
+	size_t shallow_unused;
+	k_tid_t tid;
+
+	tid = k_thread_pool_spawn(&test_pool, deep_entry, NULL, NULL, NULL,
+				  K_PRIO_PREEMPT(0), K_NO_WAIT);
+	zassert_not_null(tid);
+	wait_done(1);
+
+	zassert_equal(k_thread_pool_spawn(&test_pool, record_entry, NULL, NULL,
+					  NULL, K_PRIO_PREEMPT(0), K_NO_WAIT),
+		      tid, "thread was not recycled");
+	wait_done(1);
+	zassert_ok(k_thread_stack_space_get(tid, &shallow_unused));
+
+	zassert_true(shallow_unused >= deep_unused + DEEP_BYTES / 2,
+		     "stack not painted again: %zu vs %zu unused",
+		     shallow_unused, deep_unused);
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST_SUITE(thread_pool, NULL, thread_pool_setup, thread_pool_before, NULL,
+	    NULL);
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+/* A slack of 15 ticks gives a window of 16 ticks, so expiries are
+ * deferred to multiples of 16 ticks
+ */
+#define SLACK_TICKS 15
+#define SLACK_ALIGN 16
+
+#define SLACK_PERIOD  10
+#define SLACK_PERIODS 10
+
+#ifdef CONFIG_TIMEOUT_SLACK
+static struct k_timer slack_timers[2];
+static struct k_work_delayable slack_work;
+static K_SEM_DEFINE(slack_sem, 0, 1);
+static k_ticks_t slack_work_tick;
+
+/* Start at the beginning of a tick and return the next expiry tick
+ * aligned on the slack, at least a window away
+ */
+static k_ticks_t slack_base(k_ticks_t *now)
+{
+	k_usleep(1);
+	*now = k_uptime_ticks();
+
+	return ROUND_UP(*now + 2 * SLACK_ALIGN, SLACK_ALIGN);
+}
+
+static void slack_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	slack_work_tick = k_uptime_ticks();
+	k_sem_give(&slack_sem);
+}
+#endif
+
+/**
+ * @brief Test that timers with slack expire together
+ *
+ * @details Two timers requested a few ticks apart, whose slack windows
+ * both cover the same aligned tick, are expected to expire on that tick,
+ * in the same tick announcement.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_slack_set()
+ */
+ZTEST(timer_api, test_timer_slack_coalesce)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	k_ticks_t now, base;
+
+	for (int i = 0; i < ARRAY_SIZE(slack_timers); i++) {
+		k_timer_init(&slack_timers[i], NULL, NULL);
+		k_timer_slack_set(&slack_timers[i], K_TICKS(SLACK_TICKS));
+	}
+
+	base = slack_base(&now);
+	k_timer_start(&slack_timers[0], K_TICKS(base - now - 12), K_NO_WAIT);
+	k_timer_start(&slack_timers[1], K_TICKS(base - now - 3), K_NO_WAIT);
+	zassert_equal(k_timer_expires_ticks(&slack_timers[0]), base);
+	zassert_equal(k_timer_expires_ticks(&slack_timers[1]), base);
+
+	zassert_equal(k_timer_status_sync(&slack_timers[0]), 1);
+	zassert_true(k_uptime_ticks() >= base, "timer expired early");
+	zassert_equal(k_timer_status_get(&slack_timers[1]), 1,
+		      "timers did not expire together");
+
+	/* Without slack the expiry is not deferred */
+	k_timer_slack_set(&slack_timers[0], K_NO_WAIT);
+	base = slack_base(&now);
+	k_timer_start(&slack_timers[0], K_TICKS(base - now - 12), K_NO_WAIT);
+	zassert_true(k_timer_expires_ticks(&slack_timers[0]) < base);
+	k_timer_stop(&slack_timers[0]);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/**
+ * @brief Test that the slack of a periodic timer does not accumulate
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_slack_set()
+ */
+ZTEST(timer_api, test_timer_slack_periodic)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	k_ticks_t start, elapsed;
+
+	/* The period is not a multiple of the slack window, so most
+	 * expiries get deferred
+	 */
+	k_timer_init(&slack_timers[0], NULL, NULL);
+	k_timer_slack_set(&slack_timers[0], K_TICKS(3));
+
+	k_usleep(1);
+	start = k_uptime_ticks();
+	k_timer_start(&slack_timers[0], K_TICKS(SLACK_PERIOD),
+		      K_TICKS(SLACK_PERIOD));
+	for (int i = 0; i < SLACK_PERIODS; i++) {
+		zassert_equal(k_timer_status_sync(&slack_timers[0]), 1);
+	}
+	elapsed = k_uptime_ticks() - start;
+	k_timer_stop(&slack_timers[0]);
+
+	zassert_true(elapsed >= SLACK_PERIOD * SLACK_PERIODS,
+		     "expired early after %lld ticks", (long long)elapsed);
+	zassert_true(elapsed <= SLACK_PERIOD * SLACK_PERIODS + 1 + 3,
+		     "slack accumulated to %lld ticks", (long long)elapsed);
+#else
+	ztest_test_skip();
+#endif
+}
+
+/**
+ * @brief Test that delayable work with slack is coalesced with a timer
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_work_delayable_slack_set()
+ */
+ZTEST(timer_api, test_work_delayable_slack)
+{
+#if defined(CONFIG_TIMEOUT_SLACK) && defined(CONFIG_MULTITHREADING)
+	k_ticks_t now, base;
+
+	k_work_init_delayable(&slack_work, slack_work_handler);
+	k_work_delayable_slack_set(&slack_work, K_TICKS(SLACK_TICKS));
+	k_timer_init(&slack_timers[0], NULL, NULL);
+	k_timer_slack_set(&slack_timers[0], K_TICKS(SLACK_TICKS));
+
+	base = slack_base(&now);
+	k_work_schedule(&slack_work, K_TICKS(base - now - 10));
+	k_timer_start(&slack_timers[0], K_TICKS(base - now - 5), K_NO_WAIT);
+	zassert_equal(k_work_delayable_expires_get(&slack_work), base);
+
+	zassert_ok(k_sem_take(&slack_sem, K_FOREVER));
+	zassert_true(slack_work_tick >= base, "work submitted early");
+	zassert_equal(k_timer_status_get(&slack_timers[0]), 1,
+		      "timer and work did not expire together");
+#else
+	ztest_test_skip();
+#endif
+}
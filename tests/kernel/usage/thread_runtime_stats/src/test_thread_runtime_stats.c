@@ -539,5 +539,90 @@ ZTEST(usage_api, test_thread_stats_usage)
 	k_thread_abort(tid);
 }
 
+#ifdef CONFIG_SCHED_THREAD_LATENCY
+#define LATENCY_WAKEUPS 10
+
+static K_SEM_DEFINE(latency_sem, 0, 1);
+
+/**
+ * @brief Helper thread to test_thread_latency_stats()
+ */
+void helper_latency(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < LATENCY_WAKEUPS; i++) {
+		k_sem_take(&latency_sem, K_FOREVER);
+	}
+}
+
+static uint32_t latency_count(const k_thread_runtime_stats_t *stats)
+{
+	uint32_t count = 0U;
+
+	for (int i = 0; i < CONFIG_SCHED_THREAD_LATENCY_BUCKETS; i++) {
+		count += stats->latency[i];
+	}
+
+	return count;
+}
+
+/**
+ * @brief Test the scheduling latency histograms
+ *
+ * 1. Create a higher priority helper thread that waits on a semaphore
+ *    LATENCY_WAKEUPS times.
+ * 2. Give the semaphore LATENCY_WAKEUPS times, letting the helper run
+ *    each time, and wait for the helper to finish.
+ *    - The helper's histogram counts its start and each wakeup
+ *    - The CPU histogram counts them as well
+ *    - The main thread's histogram does not change
+ */
+ZTEST(usage_api, test_thread_latency_stats)
+{
+	k_thread_runtime_stats_t main_stats1, main_stats2;
+	k_thread_runtime_stats_t all_stats1, all_stats2;
+	k_thread_runtime_stats_t helper_stats;
+	int priority;
+	k_tid_t tid;
+
+	priority = k_thread_priority_get(_current);
+
+	k_thread_runtime_stats_get(_current, &main_stats1);
+	k_thread_runtime_stats_all_get(&all_stats1);
+
+	tid = k_thread_create(&helper_thread, helper_stack,
+			      K_THREAD_STACK_SIZEOF(helper_stack),
+			      helper_latency, NULL, NULL, NULL,
+			      priority - 1, 0, K_NO_WAIT);
+
+	/* Let the helper start and wait on the semaphore */
+	k_yield();
+
+	for (int i = 0; i < LATENCY_WAKEUPS; i++) {
+		k_sem_give(&latency_sem);
+		k_yield();
+	}
+	k_thread_join(tid, K_FOREVER);
+
+	k_thread_runtime_stats_get(tid, &helper_stats);
+	k_thread_runtime_stats_get(_current, &main_stats2);
+	k_thread_runtime_stats_all_get(&all_stats2);
+
+	zassert_equal(latency_count(&helper_stats), LATENCY_WAKEUPS + 1,
+		      "helper thread was woken %u times",
+		      latency_count(&helper_stats));
+#ifdef CONFIG_SCHED_THREAD_USAGE_ALL
+	zassert_true(helper_stats.latency_max <= all_stats2.latency_max);
+	zassert_true(latency_count(&all_stats2) >=
+		     latency_count(&all_stats1) + LATENCY_WAKEUPS + 1);
+#endif
+
+	/* Main thread only yielded or was preempted, it never had to be
+	 * made ready again
+	 */
+	zassert_equal(latency_count(&main_stats2),
+		      latency_count(&main_stats1));
+}
+#endif
+
 ZTEST_SUITE(usage_api, NULL, NULL,
 		ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
@@ -313,6 +313,158 @@ ZTEST(work_1cpu, test_1cpu_simple_queue)
 	zassert_equal(rc, 0);
 }
 
+/* Single CPU submit of several items at once. */
+ZTEST(work_1cpu, test_1cpu_batch_queue)
+{
+	static struct k_work items[4];
+	struct k_work *batch[ARRAY_SIZE(items) + 1];
+	int rc;
+
+	/* Reset state and use the non-blocking handler */
+	reset_counters();
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		k_work_init(&items[i], counter_handler);
+		batch[i] = &items[i];
+	}
+
+	/* An item listed twice is only queued once */
+	batch[ARRAY_SIZE(items)] = &items[0];
+
+	rc = k_work_submit_batch_to_queue(&coophi_queue, batch,
+					  ARRAY_SIZE(batch));
+	zassert_equal(rc, ARRAY_SIZE(items));
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		zassert_equal(k_work_busy_get(&items[i]), K_WORK_QUEUED);
+	}
+
+	/* Shouldn't have been started since test thread is
+	 * cooperative.
+	 */
+	zassert_equal(coophi_counter(), 0);
+
+	/* Let them run, then check they finished. */
+	k_sleep(K_TICKS(1));
+	zassert_equal(coophi_counter(), ARRAY_SIZE(items));
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		zassert_equal(k_work_busy_get(&items[i]), 0);
+	}
+
+	/* Flush the sync state from completion */
+	rc = k_sem_take(&sync_sem, K_NO_WAIT);
+	zassert_equal(rc, 0);
+
+	/* Nothing is queued to a queue that isn't started */
+	rc = k_work_submit_batch_to_queue(&not_start_queue, batch,
+					  ARRAY_SIZE(batch));
+	zassert_equal(rc, 0);
+}
+
+#ifdef CONFIG_WORKQUEUE_WORKERS
+static K_THREAD_STACK_DEFINE(multi_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(multi_worker_stack, STACK_SIZE);
+static struct k_work_q multi_queue;
+static struct k_work_q_worker multi_worker;
+static struct k_sem multi_sem;
+static atomic_t multi_ctr;
+
+static void multi_handler(struct k_work *work)
+{
+	atomic_inc(&multi_ctr);
+	k_sem_take(&multi_sem, K_FOREVER);
+}
+
+/* Two workers run two blocking items at the same time, but never the
+ * same item twice.
+ */
+ZTEST(work_1cpu, test_1cpu_multi_worker_queue)
+{
+	static struct k_work items[2];
+	int rc;
+
+	k_sem_init(&multi_sem, 0, ARRAY_SIZE(items) + 1);
+	atomic_set(&multi_ctr, 0);
+
+	k_work_queue_init(&multi_queue);
+	zassert_equal(k_work_queue_add_worker(&multi_queue, &multi_worker,
+					      multi_worker_stack, STACK_SIZE,
+					      -1),
+		      -ENODEV);
+
+	k_work_queue_start(&multi_queue, multi_stack, STACK_SIZE,
+			   COOPHI_PRIORITY, NULL);
+	rc = k_work_queue_add_worker(&multi_queue, &multi_worker,
+				     multi_worker_stack, STACK_SIZE, -1);
+	zassert_equal(rc, 0);
+
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		k_work_init(&items[i], multi_handler);
+		zassert_equal(k_work_submit_to_queue(&multi_queue, &items[i]),
+			      1);
+	}
+
+	/* Let them both start and block. */
+	k_sleep(K_TICKS(1));
+	zassert_equal(atomic_get(&multi_ctr), ARRAY_SIZE(items));
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		zassert_equal(k_work_busy_get(&items[i]), K_WORK_RUNNING);
+	}
+
+	/* Resubmitting a running item doesn't start it elsewhere. */
+	zassert_equal(k_work_submit_to_queue(&multi_queue, &items[0]), 2);
+	k_sleep(K_TICKS(1));
+	zassert_equal(atomic_get(&multi_ctr), ARRAY_SIZE(items));
+	zassert_equal(k_work_busy_get(&items[0]),
+		      K_WORK_RUNNING | K_WORK_QUEUED);
+
+	/* Release everything and wait for the requeued item. */
+	for (int i = 0; i <= ARRAY_SIZE(items); i++) {
+		k_sem_give(&multi_sem);
+	}
+	zassert_true(k_work_flush(&items[0], &work_sync));
+	zassert_equal(atomic_get(&multi_ctr), ARRAY_SIZE(items) + 1);
+
+	rc = k_work_queue_drain(&multi_queue, true);
+	zassert_equal(rc, 1);
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		zassert_equal(k_work_busy_get(&items[i]), 0);
+	}
+
+	/* A batch starts on both workers too, and an item queued behind
+	 * it can be flushed.
+	 */
+	static struct k_work extra;
+	struct k_work *batch[ARRAY_SIZE(items)];
+
+	zassert_equal(k_work_queue_unplug(&multi_queue), 0);
+	atomic_set(&multi_ctr, 0);
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		batch[i] = &items[i];
+	}
+	rc = k_work_submit_batch_to_queue(&multi_queue, batch,
+					  ARRAY_SIZE(batch));
+	zassert_equal(rc, ARRAY_SIZE(batch));
+	k_sleep(K_TICKS(1));
+	zassert_equal(atomic_get(&multi_ctr), ARRAY_SIZE(items));
+
+	k_work_init(&extra, multi_handler);
+	zassert_equal(k_work_submit_to_queue(&multi_queue, &extra), 1);
+
+	k_sched_lock();
+	for (int i = 0; i <= ARRAY_SIZE(items); i++) {
+		k_sem_give(&multi_sem);
+	}
+	zassert_equal(k_work_busy_get(&extra), K_WORK_QUEUED);
+	zassert_true(k_work_flush(&extra, &work_sync));
+	k_sched_unlock();
+
+	zassert_equal(atomic_get(&multi_ctr), ARRAY_SIZE(items) + 1);
+	zassert_equal(k_work_busy_get(&extra), 0);
+
+	k_thread_abort(&multi_worker.thread);
+	k_thread_abort(k_work_queue_thread_get(&multi_queue));
+}
+#endif /* CONFIG_WORKQUEUE_WORKERS */
+
 /* Basic SMP check submitting with a non-blocking handler. */
 ZTEST(work, test_smp_simple_queue)
 {
@@ -602,6 +754,34 @@ ZTEST(work_1cpu, test_1cpu_delayed_cancel)
 }
 
 
+/* Single CPU cancel of several scheduled items at once. */
+ZTEST(work_1cpu, test_1cpu_delayed_cancel_batch)
+{
+	static struct k_work_delayable items[4];
+	struct k_work_delayable *batch[ARRAY_SIZE(items)];
+	int rc;
+
+	/* Reset state and use the blocking handler */
+	reset_counters();
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		k_work_init_delayable(&items[i], rel_handler);
+		batch[i] = &items[i];
+		rc = k_work_schedule_for_queue(&coophi_queue, &items[i],
+					       K_MSEC(DELAY_MS));
+		zassert_equal(rc, 1);
+	}
+
+	/* Cancellation should complete immediately. */
+	zassert_equal(k_work_cancel_delayable_batch(batch, ARRAY_SIZE(batch)), 0);
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		zassert_equal(k_work_delayable_busy_get(&items[i]), 0);
+	}
+
+	/* Shouldn't have run. */
+	k_sleep(K_MSEC(2 * DELAY_MS));
+	zassert_equal(coophi_counter(), 0);
+}
+
 /* Single CPU cancel before scheduled work item is queued should not wait. */
 ZTEST(work_1cpu, test_1cpu_delayed_cancel_sync)
 {
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2023 Sendrato
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/ztress.h>
+#include <zephyr/sys/ring_buffer.h>
+#include <zephyr/timing/timing.h>
+#include <stdint.h>
+
+#include <zephyr/bench_clock.h>
+
+#define MPMC_ITEMS	16
+#define MPMC_ITEM_SIZE	8
+#define PRODUCERS	3
+
+RING_BUF_MPMC_DECLARE(mpmc, MPMC_ITEM_SIZE, MPMC_ITEMS);
+
+struct mpmc_item {
+	uint32_t producer;
+	uint32_t seq;
+};
+
+BUILD_ASSERT(sizeof(struct mpmc_item) == MPMC_ITEM_SIZE);
+
+/**
+ * @brief Test the multi-producer multi-consumer ring buffer API
+ *
+ * @ingroup lib_ringbuffer_tests
+ */
+ZTEST(ringbuffer_api, test_ringbuffer_mpmc_api)
+{
+	uint8_t in[MPMC_ITEM_SIZE + 1] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+	uint8_t out[MPMC_ITEM_SIZE + 1];
+	uint8_t *slot1, *slot2, *item;
+
+	zassert_equal(ring_buf_mpmc_capacity_get(&mpmc), MPMC_ITEMS);
+	zassert_equal(ring_buf_mpmc_size_get(&mpmc), 0);
+	zassert_equal(ring_buf_mpmc_get(&mpmc, out, sizeof(out)), 0);
+	zassert_equal(ring_buf_mpmc_get_claim(&mpmc, &item), 0);
+
+	/* Items are truncated to the item size, and on reading */
+	zassert_equal(ring_buf_mpmc_put(&mpmc, in, sizeof(in)), MPMC_ITEM_SIZE);
+	zassert_equal(ring_buf_mpmc_put(&mpmc, in, 3), 3);
+	zassert_equal(ring_buf_mpmc_size_get(&mpmc), 2);
+	zassert_equal(ring_buf_mpmc_get(&mpmc, out, 4), 4);
+	zassert_mem_equal(out, in, 4);
+	zassert_equal(ring_buf_mpmc_get(&mpmc, out, sizeof(out)), 3);
+	zassert_mem_equal(out, in, 3);
+
+	/* Claims may be finished out of order, but are read in claim order */
+	zassert_equal(ring_buf_mpmc_put_claim(&mpmc, &slot1, 1), 1);
+	zassert_equal(ring_buf_mpmc_put_claim(&mpmc, &slot2, 100),
+		      MPMC_ITEM_SIZE);
+	zassert_equal(ring_buf_mpmc_put_claim(&mpmc, &item, 0), 0);
+	slot2[0] = 2;
+	zassert_equal(ring_buf_mpmc_put_finish(&mpmc, slot2, 1), 0);
+	zassert_equal(ring_buf_mpmc_get_claim(&mpmc, &item), 0,
+		      "unfinished item should block readers");
+	slot1[0] = 1;
+	zassert_equal(ring_buf_mpmc_put_finish(&mpmc, slot1, 1), 0);
+	zassert_equal(ring_buf_mpmc_get_claim(&mpmc, &item), 1);
+	zassert_equal(item[0], 1);
+	zassert_equal(ring_buf_mpmc_get_finish(&mpmc, item), 0);
+	zassert_equal(ring_buf_mpmc_get(&mpmc, out, sizeof(out)), 1);
+	zassert_equal(out[0], 2);
+
+	/* Items finished with size 0 are dropped */
+	zassert_equal(ring_buf_mpmc_put_claim(&mpmc, &slot1, 1), 1);
+	zassert_equal(ring_buf_mpmc_put_finish(&mpmc, slot1, 0), 0);
+	zassert_equal(ring_buf_mpmc_put(&mpmc, in, 2), 2);
+	zassert_equal(ring_buf_mpmc_get(&mpmc, out, sizeof(out)), 2);
+	zassert_equal(ring_buf_mpmc_size_get(&mpmc), 0);
+
+	/* Invalid slots and sizes */
+	zassert_equal(ring_buf_mpmc_put_claim(&mpmc, &slot1, 1), 1);
+	zassert_equal(ring_buf_mpmc_put_finish(&mpmc, slot1 + 1, 1), -EINVAL);
+	zassert_equal(ring_buf_mpmc_put_finish(&mpmc, slot1,
+					       MPMC_ITEM_SIZE + 1), -EINVAL);
+	zassert_equal(ring_buf_mpmc_get_finish(&mpmc, out), -EINVAL);
+	zassert_equal(ring_buf_mpmc_put_finish(&mpmc, slot1, 1), 0);
+	zassert_equal(ring_buf_mpmc_get(&mpmc, NULL, sizeof(out)), 1);
+
+	/* Fill up and drain over several laps */
+	for (int lap = 0; lap < 3; lap++) {
+		for (uint8_t i = 0; i < MPMC_ITEMS; i++) {
+			zassert_equal(ring_buf_mpmc_put(&mpmc, &i, 1), 1);
+		}
+		zassert_equal(ring_buf_mpmc_put(&mpmc, in, 1), 0,
+			      "full ring buffer accepted an item");
+		zassert_equal(ring_buf_mpmc_size_get(&mpmc), MPMC_ITEMS);
+		for (uint8_t i = 0; i < MPMC_ITEMS; i++) {
+			zassert_equal(ring_buf_mpmc_get(&mpmc, out, 1), 1);
+			zassert_equal(out[0], i);
+		}
+		zassert_equal(ring_buf_mpmc_get(&mpmc, out, 1), 0);
+	}
+}
+
+static uint32_t produced[PRODUCERS];
+static uint32_t consumed[PRODUCERS];
+
+static void consume_all(void)
+{
+	struct mpmc_item item;
+
+	while (ring_buf_mpmc_get(&mpmc, (uint8_t *)&item, sizeof(item)) != 0) {
+		zassert_true(item.producer < PRODUCERS);
+		zassert_equal(item.seq, consumed[item.producer],
+			      "producer %u: got %u, expected %u", item.producer,
+			      item.seq, consumed[item.producer]);
+		consumed[item.producer]++;
+	}
+}
+
+static bool mpmc_produce(void *user_data, uint32_t cnt, bool last, int prio)
+{
+	uint32_t id = (uint32_t)(uintptr_t)user_data;
+	struct mpmc_item *item;
+
+	/* Only the producer itself touches its counter */
+	if (ring_buf_mpmc_put_claim(&mpmc, (uint8_t **)&item,
+				    sizeof(*item)) != 0) {
+		item->producer = id;
+		item->seq = produced[id];
+		produced[id]++;
+		zassert_equal(ring_buf_mpmc_put_finish(&mpmc, (uint8_t *)item,
+						       sizeof(*item)), 0);
+	}
+
+	return true;
+}
+
+static bool mpmc_consume(void *user_data, uint32_t cnt, bool last, int prio)
+{
+	consume_all();
+
+	return true;
+}
+
+/**
+ * @brief Test concurrent producers on a multi-producer multi-consumer
+ * ring buffer
+ *
+ * @details A timer and two threads of different priorities put numbered
+ * items into the ring buffer without a lock, preempting each other, while
+ * the lowest priority thread takes them out. Items of each producer must
+ * come out complete and in order.
+ *
+ * @ingroup lib_ringbuffer_tests
+ */
+ZTEST(ringbuffer_api, test_ringbuffer_mpmc_stress)
+{
+	k_timeout_t timeout;
+
+	memset(produced, 0, sizeof(produced));
+	memset(consumed, 0, sizeof(consumed));
+
+	timeout = (CONFIG_SYS_CLOCK_TICKS_PER_SEC < 10000) ? K_MSEC(1000) : K_MSEC(10000);
+
+	ztress_set_timeout(timeout);
+	ZTRESS_EXECUTE(ZTRESS_TIMER(mpmc_produce, (void *)0, 0, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(mpmc_produce, (void *)1, 0, 0, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(mpmc_produce, (void *)2, 0, 2000, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(mpmc_consume, NULL, 0, 2000, Z_TIMEOUT_TICKS(20)));
+
+	consume_all();
+	for (int i = 0; i < PRODUCERS; i++) {
+		PRINT("producer %d: %u items\n", i, produced[i]);
+		zassert_equal(consumed[i], produced[i], "producer %d lost items", i);
+	}
+}
+
+#define BENCH_ITEMS 20000
+
+RING_BUF_DECLARE(locked_ringbuf, MPMC_ITEM_SIZE * MPMC_ITEMS);
+static struct k_spinlock locked_ringbuf_lock;
+
+/**
+ * @brief Compare the throughput of a multi-producer multi-consumer ring
+ * buffer with that of a ring buffer guarded by a spinlock
+ *
+ * @ingroup lib_ringbuffer_tests
+ */
+ZTEST(ringbuffer_api, test_ringbuffer_mpmc_throughput)
+{
+	struct mpmc_item item = { 0 };
+	uint64_t locked, lockless;
+	timing_t start, end;
+	k_spinlock_key_t key;
+
+	timing_init();
+	timing_start();
+
+	start = bench_stamp();
+	for (uint32_t i = 0; i < BENCH_ITEMS; i++) {
+		item.seq = i;
+		key = k_spin_lock(&locked_ringbuf_lock);
+		ring_buf_put(&locked_ringbuf, (uint8_t *)&item, sizeof(item));
+		k_spin_unlock(&locked_ringbuf_lock, key);
+		key = k_spin_lock(&locked_ringbuf_lock);
+		ring_buf_get(&locked_ringbuf, (uint8_t *)&item, sizeof(item));
+		k_spin_unlock(&locked_ringbuf_lock, key);
+		zassert_equal(item.seq, i);
+	}
+	end = bench_stamp();
+	locked = bench_cycles(&start, &end);
+
+	start = bench_stamp();
+	for (uint32_t i = 0; i < BENCH_ITEMS; i++) {
+		item.seq = i;
+		ring_buf_mpmc_put(&mpmc, (uint8_t *)&item, sizeof(item));
+		ring_buf_mpmc_get(&mpmc, (uint8_t *)&item, sizeof(item));
+		zassert_equal(item.seq, i);
+	}
+	end = bench_stamp();
+	lockless = bench_cycles(&start, &end);
+
+	timing_stop();
+
+	PRINT("spinlock + ring_buf: %u cycles/item\n",
+	      (uint32_t)(locked / BENCH_ITEMS));
+	PRINT("ring_buf_mpmc:       %u cycles/item\n",
+	      (uint32_t)(lockless / BENCH_ITEMS));
+}
@@ -9,6 +9,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <zephyr/ztest_assert.h>
 #include <fcntl.h>
+#include <zephyr/net/buf.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/net/loopback.h>
 
@@ -2419,6 +2420,51 @@ ZTEST(net_socket_tcp, test_so_keepalive)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_so_congestion)
+{
+	struct sockaddr_in bind_addr4;
+	char optval[TCP_CA_NAME_MAX];
+	socklen_t optlen = sizeof(optval);
+	int sock, ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	ret = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, optval, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(strcmp(optval, CONFIG_NET_TCP_CA_DEFAULT), 0,
+		      "getsockopt got invalid value");
+	zassert_equal(optlen, strlen(CONFIG_NET_TCP_CA_DEFAULT) + 1,
+		      "getsockopt got invalid size");
+
+	ret = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "none", strlen("none"));
+	zassert_equal(ret, -1, "setsockopt succeeded for unknown algorithm");
+	zassert_equal(errno, ENOENT, "setsockopt got invalid errno (%d)", errno);
+
+	ret = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "reno", strlen("reno"));
+	zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+	optlen = sizeof(optval);
+	ret = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, optval, &optlen);
+	zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(strcmp(optval, "reno"), 0, "getsockopt got invalid value");
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CA_CUBIC)) {
+		ret = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "cubic",
+				 sizeof("cubic"));
+		zassert_equal(ret, 0, "setsockopt failed (%d)", errno);
+
+		optlen = sizeof(optval);
+		ret = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, optval, &optlen);
+		zassert_equal(ret, 0, "getsockopt failed (%d)", errno);
+		zassert_equal(strcmp(optval, "cubic"), 0,
+			      "getsockopt got invalid value");
+	}
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+
 ZTEST(net_socket_tcp, test_keepalive_timeout)
 {
 	struct sockaddr_in c_saddr, s_saddr;
@@ -2491,6 +2537,66 @@ ZTEST(net_socket_tcp, test_keepalive_timeout)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_v4_recv_zc)
+{
+#if defined(CONFIG_NET_SOCKETS_ZERO_COPY_RX)
+	struct sockaddr_in c_saddr, s_saddr;
+	int c_sock, s_sock, new_sock;
+	char rx_buf[sizeof(TEST_STR_LONG)];
+	struct net_buf *frags;
+	size_t received = 0;
+	ssize_t ret;
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, SERVER_PORT, &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, NULL, NULL);
+
+	test_send(c_sock, TEST_STR_LONG, strlen(TEST_STR_LONG), 0);
+
+	ret = zsock_recv_zc(new_sock, &frags, ZSOCK_MSG_PEEK);
+	zassert_equal(ret, -1, "zsock_recv_zc() should've failed");
+	zassert_equal(errno, EOPNOTSUPP, "wrong errno value, %d", errno);
+
+	while (received < strlen(TEST_STR_LONG)) {
+		ret = zsock_recv_zc(new_sock, &frags, 0);
+		zassert_true(ret > 0, "zsock_recv_zc() failed (%d)", errno);
+		zassert_not_null(frags, "no buffers returned");
+		zassert_equal(net_buf_frags_len(frags), (size_t)ret, "wrong length");
+		zassert_true(received + (size_t)ret <= strlen(TEST_STR_LONG),
+			     "too much data");
+
+		net_buf_linearize(rx_buf + received, sizeof(rx_buf) - received,
+				  frags, 0, ret);
+		received += ret;
+
+		zsock_recv_zc_release(new_sock, frags, ret);
+	}
+
+	zassert_mem_equal(rx_buf, TEST_STR_LONG, received, "wrong data");
+
+	ret = zsock_recv_zc(new_sock, &frags, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(ret, -1, "zsock_recv_zc() should've failed");
+	zassert_equal(errno, EAGAIN, "wrong errno value, %d", errno);
+
+	test_close(c_sock);
+
+	ret = zsock_recv_zc(new_sock, &frags, 0);
+	zassert_equal(ret, 0, "EOF not detected");
+	zassert_is_null(frags, "buffers returned at EOF");
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	test_context_cleanup();
+#else
+	ztest_test_skip();
+#endif /* CONFIG_NET_SOCKETS_ZERO_COPY_RX */
+}
+
 static void after(void *arg)
 {
 	ARG_UNUSED(arg);
@@ -134,6 +134,7 @@ static void handle_server_recv_out_of_order(struct net_pkt *pkt);
 static void handle_server_rst_on_closed_port(sa_family_t af, struct tcphdr *th);
 static void handle_server_rst_on_listening_port(sa_family_t af, struct tcphdr *th);
 static void handle_syn_invalid_ack(sa_family_t af, struct tcphdr *th);
+static void handle_options_test(struct net_pkt *pkt);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -222,6 +223,14 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Options the peer sends in test case 16, in its SYN and in the other
+ * segments.
+ */
+static const uint8_t *peer_syn_opts;
+static size_t peer_syn_opts_len;
+static const uint8_t *peer_opts;
+static size_t peer_opts_len;
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -232,11 +241,19 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct net_pkt *pkt;
 	struct tcphdr *th;
+	const uint8_t *opts = NULL;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
 	if ((test_case_no == 4U) && (flags & SYN)) {
+		opts = tcp_options;
 		opts_len = sizeof(tcp_options);
+	} else if (test_case_no == 16U && (flags & SYN)) {
+		opts = peer_syn_opts;
+		opts_len = peer_syn_opts_len;
+	} else if (test_case_no == 16U) {
+		opts = peer_opts;
+		opts_len = peer_opts_len;
 	}
 
 	/* Allocate buffer */
@@ -271,11 +288,7 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
+	th->th_off = 5U + opts_len / 4U;
 
 	th->th_flags = flags;
 	th->th_win = NET_IPV6_MTU;
@@ -290,9 +303,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (opts_len > 0) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -468,6 +481,9 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 15:
 		handle_syn_invalid_ack(net_pkt_family(pkt), &th);
 		break;
+	case 16:
+		handle_options_test(pkt);
+		break;
 
 	default:
 		zassert_true(false, "Undefined test case");
@@ -1727,7 +1743,7 @@ ZTEST(net_tcp, test_client_invalid_rst)
 {
 	struct net_context *ctx;
 	struct tcp *conn;
-	uint16_t wnd;
+	uint32_t wnd;
 
 	ctx = create_server_socket(0, 0);
 
@@ -2130,4 +2146,501 @@ ZTEST(net_tcp, test_client_rst_on_unexpected_ack_on_syn)
 	test_sem_take(K_MSEC(100), __LINE__);
 }
 
+#define MAX_OPTS_LEN 40
+#define PEER_WSCALE 7
+#define PEER_TSVAL 0x11223344
+
+/* Segment the stack sent last in test case 16, with its options */
+static struct sent_segment {
+	uint8_t flags;
+	uint16_t win;
+	uint32_t seq;
+	uint32_t ack;
+	bool mss;
+	bool wscale;
+	uint8_t shift;
+	bool sack_perm;
+	bool ts;
+	uint32_t tsval;
+	uint32_t tsecr;
+	int sack_blocks;
+	uint32_t sack_start;
+	uint32_t sack_end;
+} sent;
+
+static struct net_context *options_ctx;
+
+static void handle_options_test(struct net_pkt *pkt)
+{
+	uint8_t opts[MAX_OPTS_LEN];
+	struct tcphdr th;
+	size_t len;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	memset(&sent, 0, sizeof(sent));
+	sent.flags = th.th_flags;
+	sent.win = ntohs(th.th_win);
+	sent.seq = ntohl(th.th_seq);
+	sent.ack = ntohl(th.th_ack);
+
+	len = (th.th_off - 5U) * 4U;
+
+	net_pkt_set_overwrite(pkt, true);
+
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			   net_pkt_ip_opts_len(pkt) + sizeof(struct tcphdr));
+	if (ret < 0) {
+		goto fail;
+	}
+
+	ret = net_pkt_read(pkt, opts, len);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	for (size_t i = 0; i < len; i += opts[i + 1]) {
+		while (i < len && opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+		}
+
+		if (i == len || opts[i] == NET_TCP_END_OPT) {
+			break;
+		}
+
+		zassert_true(i + 1 < len && opts[i + 1] >= 2 &&
+			     i + opts[i + 1] <= len, "Invalid option %u",
+			     opts[i]);
+
+		switch (opts[i]) {
+		case NET_TCP_MSS_OPT:
+			sent.mss = true;
+			break;
+		case NET_TCP_WINDOW_SCALE_OPT:
+			sent.wscale = true;
+			sent.shift = opts[i + 2];
+			break;
+		case NET_TCP_SACK_PERM_OPT:
+			sent.sack_perm = true;
+			break;
+		case NET_TCP_SACK_OPT:
+			sent.sack_blocks = (opts[i + 1] - 2) /
+					   NET_TCP_SACK_BLOCK_SIZE;
+			sent.sack_start = sys_get_be32(&opts[i + 2]);
+			sent.sack_end = sys_get_be32(&opts[i + 6]);
+			break;
+		case NET_TCP_TIMESTAMP_OPT:
+			sent.ts = true;
+			sent.tsval = sys_get_be32(&opts[i + 2]);
+			sent.tsecr = sys_get_be32(&opts[i + 6]);
+			break;
+		default:
+			break;
+		}
+	}
+
+	test_sem_give();
+
+	return;
+fail:
+	zassert_true(false, "%s failed", __func__);
+}
+
+static bool options_enabled(void)
+{
+	return IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+	       IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+	       IS_ENABLED(CONFIG_NET_TCP_TIMESTAMPS) &&
+	       CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT > 0;
+}
+
+/* Options of a SYN from the peer, the MSS and the ones selected */
+static size_t build_peer_syn_opts(uint8_t *buf, bool wscale, bool sack,
+				  bool ts)
+{
+	uint8_t *opt = buf;
+
+	*opt++ = NET_TCP_MSS_OPT;
+	*opt++ = NET_TCP_MSS_SIZE;
+	sys_put_be16(NET_IPV6_MTU - NET_IPV6TCPH_LEN, opt);
+	opt += sizeof(uint16_t);
+
+	if (wscale) {
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_WINDOW_SCALE_OPT;
+		*opt++ = NET_TCP_WINDOW_SCALE_SIZE;
+		*opt++ = PEER_WSCALE;
+	}
+
+	if (sack) {
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_SACK_PERM_OPT;
+		*opt++ = NET_TCP_SACK_PERM_SIZE;
+	}
+
+	if (ts) {
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_NOP_OPT;
+		*opt++ = NET_TCP_TIMESTAMP_OPT;
+		*opt++ = NET_TCP_TIMESTAMP_SIZE;
+		sys_put_be32(PEER_TSVAL, opt);
+		sys_put_be32(0, opt + 4);
+		opt += 2 * sizeof(uint32_t);
+	}
+
+	return opt - buf;
+}
+
+/* Send a segment from the peer and wait for the stack to answer */
+static void options_send(struct net_pkt *pkt, int line)
+{
+	int ret;
+
+	zassert_not_null(pkt, "Cannot create pkt (line %d)", line);
+
+	k_sem_reset(&test_sem);
+
+	ret = net_recv_data(net_iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	test_sem_take(K_MSEC(100), line);
+}
+
+/* Accept a connection from a peer offering the selected options, the
+ * SYN-ACK of the stack is returned in syn_ack.
+ */
+static void options_accept(bool wscale, bool sack, bool ts,
+			   struct sent_segment *syn_ack)
+{
+	static uint8_t syn_opts[MAX_OPTS_LEN];
+	static uint8_t opts[MAX_OPTS_LEN];
+	int ret;
+
+	test_case_no = 16;
+	seq = ack = 0;
+
+	peer_syn_opts = syn_opts;
+	peer_syn_opts_len = build_peer_syn_opts(syn_opts, wscale, sack, ts);
+	peer_opts = opts;
+	peer_opts_len = 0;
+
+	ret = net_context_get(AF_INET6, SOCK_STREAM, IPPROTO_TCP,
+			      &options_ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(options_ctx);
+
+	ret = net_context_bind(options_ctx, (struct sockaddr *)&my_addr_v6_s,
+			       sizeof(struct sockaddr_in6));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(options_ctx, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	ret = net_context_accept(options_ctx, test_tcp_accept_cb, K_FOREVER,
+				 NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	options_send(prepare_syn_packet(AF_INET6, htons(MY_PORT),
+					htons(PEER_PORT)), __LINE__);
+	zassert_equal(sent.flags, SYN | ACK, "Not a SYN ACK (0x%02x)",
+		      sent.flags);
+	*syn_ack = sent;
+
+	seq++;
+	ack = sent.seq + 1U;
+
+	/* The following segments of the peer carry its timestamp */
+	if (ts) {
+		opts[0] = NET_TCP_NOP_OPT;
+		opts[1] = NET_TCP_NOP_OPT;
+		opts[2] = NET_TCP_TIMESTAMP_OPT;
+		opts[3] = NET_TCP_TIMESTAMP_SIZE;
+		sys_put_be32(PEER_TSVAL + 1U, &opts[4]);
+		sys_put_be32(sent.tsval, &opts[8]);
+		peer_opts_len = 12;
+	}
+
+	/* test_tcp_accept_cb will release the semaphore */
+	options_send(prepare_ack_packet(AF_INET6, htons(MY_PORT),
+					htons(PEER_PORT)), __LINE__);
+}
+
+static void options_close(void)
+{
+	struct net_pkt *rst;
+	int ret;
+
+	rst = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+	zassert_not_null(rst, "Cannot create pkt");
+
+	ret = net_recv_data(net_iface, rst);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(options_ctx);
+	net_context_put(accepted_ctx);
+
+	/* Let other threads run (so the TCP context is actually freed) */
+	k_msleep(10);
+}
+
+/* Test case scenario IPv6
+ *   Connect, expect SYN offering all the options,
+ *   send SYN ACK without options,
+ *   expect ACK without options.
+ */
+ZTEST(net_tcp, test_options_offer)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	int ret;
+
+	if (!options_enabled()) {
+		ztest_test_skip();
+	}
+
+	test_case_no = 16;
+	seq = ack = 0;
+	peer_syn_opts_len = 0;
+	peer_opts_len = 0;
+
+	ret = net_context_get(AF_INET6, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	k_sem_reset(&test_sem);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_v6_s,
+				  sizeof(struct sockaddr_in6), NULL,
+				  K_NO_WAIT, NULL);
+	zassert_equal(ret, -EINPROGRESS, "Failed to connect to peer (%d)",
+		      ret);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_equal(sent.flags, SYN, "Not a SYN (0x%02x)", sent.flags);
+	zassert_true(sent.mss, "MSS not offered");
+	zassert_true(sent.wscale, "Window scaling not offered");
+	zassert_true(sent.sack_perm, "SACK not offered");
+	zassert_true(sent.ts, "Timestamps not offered");
+	zassert_equal(sent.tsecr, 0, "Timestamp echoed in a SYN");
+
+	conn = ctx->tcp;
+	ack = sent.seq + 1U;
+
+	/* A peer without options disables all of them */
+	options_send(prepare_syn_ack_packet(AF_INET6, htons(MY_PORT),
+					    htons(PEER_PORT)), __LINE__);
+	seq++;
+
+	zassert_equal(sent.flags, ACK, "Not an ACK (0x%02x)", sent.flags);
+	zassert_false(sent.ts, "Timestamps sent without the peer");
+	zassert_false(conn->wscale_ok, "Window scaling used without the peer");
+	zassert_equal(conn->rcv_wscale, 0, "Receive window scaled");
+	zassert_equal(conn->snd_wscale, 0, "Send window scaled");
+	zassert_false(conn->sack_ok, "SACK used without the peer");
+	zassert_false(conn->ts_ok, "Timestamps used without the peer");
+
+	ret = net_recv_data(net_iface,
+			    prepare_rst_packet(AF_INET6, htons(MY_PORT),
+					       htons(PEER_PORT)));
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	k_msleep(50);
+
+	net_context_put(ctx);
+
+	k_msleep(10);
+}
+
+/* Test case scenario IPv6
+ *   Send SYN offering all the options,
+ *   expect SYN ACK accepting them,
+ *   send ACK, send Data,
+ *   expect ACK with timestamps and a scaled window.
+ */
+ZTEST(net_tcp, test_options_negotiation)
+{
+	/* The peer puts NET_IPV6_MTU in the window field as is */
+	uint32_t peer_win = ntohs(NET_IPV6_MTU);
+	struct sent_segment syn_ack;
+	struct tcp *conn;
+
+	if (!options_enabled()) {
+		ztest_test_skip();
+	}
+
+	options_accept(true, true, true, &syn_ack);
+
+	conn = accepted_ctx->tcp;
+
+	zassert_true(syn_ack.mss, "MSS not sent");
+	zassert_true(syn_ack.wscale, "Window scaling not accepted");
+	zassert_equal(syn_ack.shift, conn->rcv_wscale, "Wrong window scale");
+	zassert_true(syn_ack.sack_perm, "SACK not accepted");
+	zassert_true(syn_ack.ts, "Timestamps not accepted");
+	zassert_equal(syn_ack.tsecr, PEER_TSVAL, "Timestamp not echoed");
+
+	zassert_true(conn->wscale_ok, "Window scaling not used");
+	zassert_equal(conn->snd_wscale, PEER_WSCALE, "Wrong send scale");
+	zassert_true(conn->sack_ok, "SACK not used");
+	zassert_true(conn->ts_ok, "Timestamps not used");
+
+	if (CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE > UINT16_MAX) {
+		zassert_true(conn->rcv_wscale > 0, "Receive window not scaled");
+	}
+
+	/* The window of the ACK is scaled, the one of the SYN was not */
+	zassert_equal(conn->send_win,
+		      MIN(peer_win << PEER_WSCALE, conn->send_win_max),
+		      "Wrong send window %u", conn->send_win);
+
+	options_send(prepare_data_packet(AF_INET6, htons(MY_PORT),
+					 htons(PEER_PORT), lorem_ipsum, 10U),
+		     __LINE__);
+	seq += 10U;
+
+	zassert_equal(sent.ack, seq, "Data not acknowledged");
+	zassert_true(sent.ts, "No timestamps in the ACK");
+	zassert_equal(sent.tsecr, PEER_TSVAL + 1U, "Timestamp not echoed");
+	zassert_equal(sent.sack_blocks, 0, "SACK block for in-order data");
+	zassert_equal(sent.win, conn->recv_win >> conn->rcv_wscale,
+		      "Window %u not scaled", sent.win);
+
+	options_close();
+}
+
+/* Test case scenario IPv6
+ *   For each option, send SYN without it,
+ *   expect SYN ACK without it,
+ *   send ACK, send out-of-order Data,
+ *   expect ACK without it.
+ */
+ZTEST(net_tcp, test_options_fallback)
+{
+	static const struct {
+		bool wscale;
+		bool sack;
+		bool ts;
+	} offers[] = {
+		{ false, true, true },
+		{ true, false, true },
+		{ true, true, false },
+	};
+	struct sent_segment syn_ack;
+	struct tcp *conn;
+
+	if (!options_enabled()) {
+		ztest_test_skip();
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(offers); i++) {
+		options_accept(offers[i].wscale, offers[i].sack, offers[i].ts,
+			       &syn_ack);
+
+		conn = accepted_ctx->tcp;
+
+		zassert_equal(syn_ack.wscale, offers[i].wscale,
+			      "Window scaling in SYN ACK (%d)", i);
+		zassert_equal(syn_ack.sack_perm, offers[i].sack,
+			      "SACK in SYN ACK (%d)", i);
+		zassert_equal(syn_ack.ts, offers[i].ts,
+			      "Timestamps in SYN ACK (%d)", i);
+		zassert_equal(conn->wscale_ok, offers[i].wscale,
+			      "Window scaling (%d)", i);
+		zassert_equal(conn->sack_ok, offers[i].sack, "SACK (%d)", i);
+		zassert_equal(conn->ts_ok, offers[i].ts, "Timestamps (%d)", i);
+
+		if (!offers[i].wscale) {
+			zassert_equal(conn->rcv_wscale, 0,
+				      "Receive window scaled");
+			zassert_equal(conn->snd_wscale, 0,
+				      "Send window scaled");
+		}
+
+		/* Out-of-order data is acknowledged with a SACK block
+		 * only if the peer permitted it.
+		 */
+		seq += 10U;
+		options_send(prepare_data_packet(AF_INET6, htons(MY_PORT),
+						 htons(PEER_PORT),
+						 lorem_ipsum + 10, 10U),
+			     __LINE__);
+		seq -= 10U;
+
+		zassert_equal(sent.ack, seq, "Wrong ACK (%d)", i);
+		zassert_equal(sent.sack_blocks, offers[i].sack ? 1 : 0,
+			      "SACK blocks (%d)", i);
+		zassert_equal(sent.ts, offers[i].ts, "Timestamps in ACK (%d)",
+			      i);
+		zassert_equal(sent.win,
+			      MIN(conn->recv_win >> conn->rcv_wscale,
+				  UINT16_MAX),
+			      "Window %u (%d)", sent.win, i);
+
+		options_close();
+	}
+}
+
+/* Test case scenario IPv6
+ *   Send Data after a hole, expect ACK with a SACK block,
+ *   send Data before it, expect ACK with the block extended,
+ *   fill the hole, expect ACK of all the data without SACK block.
+ */
+ZTEST(net_tcp, test_options_sack_blocks)
+{
+	struct sent_segment syn_ack;
+	uint32_t base;
+
+	if (!options_enabled()) {
+		ztest_test_skip();
+	}
+
+	options_accept(true, true, true, &syn_ack);
+
+	base = seq;
+
+	seq = base + 20U;
+	options_send(prepare_data_packet(AF_INET6, htons(MY_PORT),
+					 htons(PEER_PORT), lorem_ipsum + 20,
+					 10U), __LINE__);
+
+	zassert_equal(sent.ack, base, "Out-of-order data acknowledged");
+	zassert_equal(sent.sack_blocks, 1, "No SACK block");
+	zassert_equal(sent.sack_start, base + 20U, "Wrong SACK block start");
+	zassert_equal(sent.sack_end, base + 30U, "Wrong SACK block end");
+
+	seq = base + 10U;
+	options_send(prepare_data_packet(AF_INET6, htons(MY_PORT),
+					 htons(PEER_PORT), lorem_ipsum + 10,
+					 10U), __LINE__);
+
+	zassert_equal(sent.ack, base, "Out-of-order data acknowledged");
+	zassert_equal(sent.sack_blocks, 1, "No SACK block");
+	zassert_equal(sent.sack_start, base + 10U, "SACK block not extended");
+	zassert_equal(sent.sack_end, base + 30U, "Wrong SACK block end");
+
+	seq = base;
+	options_send(prepare_data_packet(AF_INET6, htons(MY_PORT),
+					 htons(PEER_PORT), lorem_ipsum, 10U),
+		     __LINE__);
+
+	zassert_equal(sent.ack, base + 30U, "Queued data not acknowledged");
+	zassert_equal(sent.sack_blocks, 0, "SACK block without a hole");
+
+	seq = base + 30U;
+	options_close();
+}
+
 ZTEST_SUITE(net_tcp, NULL, presetup, NULL, NULL, NULL);